@@ -0,0 +1,70 @@
+#include "BenchFixtures.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "Core/JsonGlmHelpers.h"
+#include "Core/PropertyNames.h"
+
+glm::vec3 GridMesh::SurfacePoint(float x, float y) {
+  return {x, y, 0.05f * std::sin(6.0f * x) * std::cos(6.0f * y)};
+}
+
+GridMesh MakeGridMesh(size_t targetTriangles) {
+  GridMesh grid;
+  grid.quadsPerSide = std::max<uint32_t>(
+      1, static_cast<uint32_t>(std::lround(
+             std::sqrt(static_cast<double>(targetTriangles) / 2.0))));
+  const uint32_t n = grid.quadsPerSide;
+
+  grid.vertices.reserve(static_cast<size_t>(n + 1) * (n + 1) * 3);
+  for (uint32_t row = 0; row <= n; ++row) {
+    for (uint32_t column = 0; column <= n; ++column) {
+      glm::vec3 p = GridMesh::SurfacePoint(2.0f * column / n - 1.0f,
+                                           2.0f * row / n - 1.0f);
+      grid.vertices.insert(grid.vertices.end(), {p.x, p.y, p.z});
+    }
+  }
+
+  grid.indices.reserve(static_cast<size_t>(n) * n * 6);
+  for (uint32_t row = 0; row < n; ++row) {
+    for (uint32_t column = 0; column < n; ++column) {
+      uint32_t a = grid.VertexIndex(column, row);
+      uint32_t b = grid.VertexIndex(column + 1, row);
+      uint32_t c = grid.VertexIndex(column + 1, row + 1);
+      uint32_t d = grid.VertexIndex(column, row + 1);
+      grid.indices.insert(grid.indices.end(), {a, b, c, a, c, d});
+    }
+  }
+  return grid;
+}
+
+bool WriteObj(const GridMesh& grid, const std::string& filepath) {
+  std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(filepath.c_str(), "w"),
+                                             &std::fclose);
+  if (!file) return false;
+
+  for (size_t i = 0; i < grid.vertices.size(); i += 3) {
+    std::fprintf(file.get(), "v %.6f %.6f %.6f\n", grid.vertices[i],
+                 grid.vertices[i + 1], grid.vertices[i + 2]);
+  }
+  for (size_t i = 0; i < grid.indices.size(); i += 3) {
+    std::fprintf(file.get(), "f %u %u %u\n", grid.indices[i] + 1,
+                 grid.indices[i + 1] + 1, grid.indices[i + 2] + 1);
+  }
+  return std::ferror(file.get()) == 0;
+}
+
+BenchMeshObject::BenchMeshObject() {
+  name = kTypeName;
+  m_Properties.Add<glm::vec3>(PropertyNames::Position, glm::vec3(0.0f));
+}
+
+glm::vec3 BenchMeshObject::GetPosition() const {
+  return m_Properties.GetValue<glm::vec3>(PropertyNames::Position);
+}
+
+void BenchMeshObject::SetPosition(const glm::vec3& position) {
+  m_Properties.SetValue<glm::vec3>(PropertyNames::Position, position);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "Interfaces.h"
+#include "Sculpting/SculptableMesh.h"
+
+/**
+ * @brief A gently rippled square grid in the XY plane, spanning [-1, 1] on
+ * both axes, with close to the requested number of triangles.
+ */
+struct GridMesh {
+  std::vector<float> vertices;   // Flat xyz
+  std::vector<unsigned int> indices;
+  uint32_t quadsPerSide = 0;
+
+  size_t TriangleCount() const { return indices.size() / 3; }
+  uint32_t VertexIndex(uint32_t column, uint32_t row) const {
+    return row * (quadsPerSide + 1) + column;
+  }
+  uint32_t FaceIndex(uint32_t column, uint32_t row) const {
+    return (row * quadsPerSide + column) * 2;
+  }
+  // Point on the surface at (x, y)
+  static glm::vec3 SurfacePoint(float x, float y);
+};
+
+GridMesh MakeGridMesh(size_t targetTriangles);
+
+/** @brief Writes the grid as a Wavefront OBJ; false on I/O failure. */
+bool WriteObj(const GridMesh& grid, const std::string& filepath);
+
+/**
+ * @brief Scene object that only carries a sculptable mesh. Regular objects
+ * load shaders on construction, which needs a GL context.
+ */
+class BenchMeshObject : public ISceneObject {
+ public:
+  static constexpr const char* kTypeName = "BenchMesh";
+
+  BenchMeshObject();
+
+  SculptableMesh& GetMesh() { return m_Mesh; }
+
+  std::string GetTypeString() const override { return kTypeName; }
+  void Draw(OpenGLRenderer&, const glm::mat4&, const glm::mat4&) override {}
+  void DrawForPicking(Shader&, const glm::mat4&, const glm::mat4&) override {}
+  void DrawHighlight(const glm::mat4&, const glm::mat4&) const override {}
+  void RebuildMesh() override {}
+  PropertySet& GetPropertySet() override { return m_Properties; }
+  const PropertySet& GetPropertySet() const override { return m_Properties; }
+  const glm::mat4& GetTransform() const override { return m_Transform; }
+  glm::vec3 GetPosition() const override;
+  glm::quat GetRotation() const override { return glm::quat(1, 0, 0, 0); }
+  glm::vec3 GetScale() const override { return glm::vec3(1.0f); }
+  void SetPosition(const glm::vec3& position) override;
+  void SetRotation(const glm::quat&) override {}
+  void SetScale(const glm::vec3&) override {}
+  void SetEulerAngles(const glm::vec3&) override {}
+  std::vector<GizmoHandleDef> GetGizmoHandleDefs() override { return {}; }
+  void OnGizmoUpdate(const std::string&, float, const glm::vec3&) override {}
+  std::shared_ptr<Shader> GetShader() const override { return nullptr; }
+  IEditableMesh* GetEditableMesh() override { return &m_Mesh; }
+  bool IsMeshDirty() const override { return false; }
+  void SetMeshDirty(bool) override {}
+
+ private:
+  PropertySet m_Properties;
+  glm::mat4 m_Transform{1.0f};
+  SculptableMesh m_Mesh;
+};
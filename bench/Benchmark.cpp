@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <nlohmann/json.hpp>
+#include <numeric>
+
+#include "Core/JobSystem.h"
+#include "Sculpting/BrushKernels.h"
+
+BenchmarkRunner::BenchmarkRunner(BenchmarkOptions options)
+    : m_Options(std::move(options)) {}
+
+bool BenchmarkRunner::IsEnabled(const std::string& name) const {
+  return m_Options.filter.empty() ||
+         name.find(m_Options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::Run(const std::string& name, size_t triangles,
+                          const Body& body, const Body& setup) {
+  if (!IsEnabled(name)) return;
+
+  using Clock = std::chrono::steady_clock;
+  auto timeOnce = [&]() {
+    if (setup) setup();
+    auto start = Clock::now();
+    body();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+        .count();
+  };
+
+  std::vector<double> samples;
+  const double budgetNs = m_Options.minSeconds * 1e9;
+
+  // The first run warms caches and lazily built structures. When it alone
+  // uses the budget (the largest meshes), it is kept as the only sample
+  // rather than paying for a second run.
+  double warmup = timeOnce();
+  if (warmup >= budgetNs) {
+    samples.push_back(warmup);
+  } else {
+    double total = 0.0;
+    while (samples.size() < m_Options.maxIterations &&
+           (total < budgetNs || samples.empty())) {
+      samples.push_back(timeOnce());
+      total += samples.back();
+    }
+  }
+
+  BenchmarkResult result;
+  result.name = name;
+  result.triangles = triangles;
+  result.iterations = samples.size();
+  result.meanNs = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                  static_cast<double>(samples.size());
+  std::sort(samples.begin(), samples.end());
+  result.minNs = samples.front();
+  result.medianNs = samples[samples.size() / 2];
+  m_Results.push_back(result);
+
+  std::printf("%-32s %10zu tris %8zu iters %14.1f us median %14.1f us min\n",
+              name.c_str(), triangles, result.iterations,
+              result.medianNs / 1e3, result.minNs / 1e3);
+  std::fflush(stdout);
+}
+
+nlohmann::json BenchmarkRunner::ToJson() const {
+  char date[32] = {};
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+  nlohmann::json out;
+  out["context"] = {
+      {"date", date},
+      {"threads", JobSystem::Get().GetThreadCount()},
+      {"brush_kernel", BrushKernels::GetActivePath() == BrushKernels::Path::AVX2
+                           ? "avx2"
+                           : "scalar"},
+#ifdef NDEBUG
+      {"build", "release"},
+#else
+      {"build", "debug"},
+#endif
+      {"min_seconds", m_Options.minSeconds},
+  };
+
+  nlohmann::json benchmarks = nlohmann::json::array();
+  for (const auto& result : m_Results) {
+    benchmarks.push_back({{"name", result.name},
+                          {"triangles", result.triangles},
+                          {"iterations", result.iterations},
+                          {"min_ns", result.minNs},
+                          {"median_ns", result.medianNs},
+                          {"mean_ns", result.meanNs}});
+  }
+  out["benchmarks"] = std::move(benchmarks);
+  return out;
+}
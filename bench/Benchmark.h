@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal timing harness for the headless benchmarks.
+ *
+ * Each benchmark runs its body repeatedly until it has used the minimum time
+ * budget, then reports per-iteration statistics. Results keep a stable name
+ * and triangle count so JSON output from two commits can be diffed directly.
+ */
+struct BenchmarkOptions {
+  double minSeconds = 0.5;     // Time budget per benchmark and size
+  size_t maxIterations = 1000;
+  std::string filter;          // Substring of the names to run; empty = all
+};
+
+struct BenchmarkResult {
+  std::string name;
+  size_t triangles = 0;
+  size_t iterations = 0;
+  double minNs = 0.0;
+  double medianNs = 0.0;
+  double meanNs = 0.0;
+};
+
+class BenchmarkRunner {
+ public:
+  using Body = std::function<void()>;
+
+  explicit BenchmarkRunner(BenchmarkOptions options);
+
+  /** @brief False if the name does not match the filter; use it to skip
+   * expensive fixture setup. */
+  bool IsEnabled(const std::string& name) const;
+
+  /**
+   * @brief Times body and records the result.
+   * @param setup Runs untimed before every iteration, e.g. to restore a mesh
+   * that body modifies.
+   */
+  void Run(const std::string& name, size_t triangles, const Body& body,
+           const Body& setup = {});
+
+  const std::vector<BenchmarkResult>& GetResults() const { return m_Results; }
+
+  /** @brief Results plus the machine and build context they came from. */
+  nlohmann::json ToJson() const;
+
+ private:
+  BenchmarkOptions m_Options;
+  std::vector<BenchmarkResult> m_Results;
+};
+
+/** @brief Keeps the compiler from discarding a value the benchmark computes. */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* s_Sink;
+  s_Sink = &value;
+#endif
+}
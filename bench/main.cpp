@@ -0,0 +1,325 @@
+// Headless benchmarks for the mesh, sculpting, selection and scene I/O paths.
+// Build in Release; Debug builds log from inside the timed code.
+//
+// Usage: IntuitiveModeler_Bench [--out=results.json] [--filter=Sculpt]
+//                               [--max-triangles=1000000] [--min-time=0.5]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <glm/gtc/matrix_transform.hpp>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "BenchFixtures.h"
+#include "Benchmark.h"
+#include "Core/MathHelpers.h"
+#include "Core/Raycaster.h"
+#include "Core/ResourceManager.h"
+#include "Core/UI/BrushSettings.h"
+#include "Factories/SceneObjectFactory.h"
+#include "Scene/Objects/Icosphere.h"
+#include "Scene/Scene.h"
+#include "Sculpting/SculptableMesh.h"
+#include "Sculpting/SubObjectSelection.h"
+#include "Sculpting/Tools/GrabTool.h"
+#include "Sculpting/Tools/PushPullTool.h"
+#include "Sculpting/Tools/SmoothTool.h"
+
+namespace {
+
+constexpr size_t kMeshSizes[] = {1000, 10000, 100000, 1000000, 5000000};
+constexpr int kViewportWidth = 1280;
+constexpr int kViewportHeight = 720;
+constexpr float kBrushRadius = 0.1f;
+constexpr size_t kSampleCount = 256;
+
+// Fixed camera looking down at the grid, shared by every benchmark.
+struct View {
+  glm::vec3 eye{0.0f, 0.0f, 3.0f};
+  glm::vec3 forward{0.0f, 0.0f, -1.0f};
+  glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0, 1, 0));
+  glm::mat4 projection = glm::perspective(
+      glm::radians(45.0f),
+      static_cast<float>(kViewportWidth) / kViewportHeight, 0.1f, 100.0f);
+};
+
+// Deterministic surface points spread over the middle of the grid, so
+// repeated runs and different commits hit the same places.
+std::vector<glm::vec3> makeSurfaceSamples() {
+  std::vector<glm::vec3> samples;
+  samples.reserve(kSampleCount);
+  for (size_t i = 0; i < kSampleCount; ++i) {
+    float x = std::fmod(0.618034f * i, 1.0f) * 1.6f - 0.8f;
+    float y = std::fmod(0.414214f * i, 1.0f) * 1.6f - 0.8f;
+    samples.push_back(GridMesh::SurfacePoint(x, y));
+  }
+  return samples;
+}
+
+void benchMesh(BenchmarkRunner& runner, const GridMesh& grid,
+               const SculptableMesh& baseMesh) {
+  const size_t triangles = grid.TriangleCount();
+  const View camera;
+  const auto samples = makeSurfaceSamples();
+
+  SculptableMesh mesh = baseMesh;
+  runner.Run("Mesh/RecalculateNormals", triangles,
+             [&]() { mesh.RecalculateNormals(); });
+
+  mesh.GetBVH();
+  size_t ray = 0;
+  runner.Run("Raycaster/IntersectMesh", triangles, [&]() {
+    glm::vec3 target = samples[ray++ % samples.size()];
+    Raycaster::RaycastResult result;
+    Raycaster::IntersectMesh(camera.eye, glm::normalize(target - camera.eye),
+                             mesh, glm::mat4(1.0f), result);
+    DoNotOptimize(result);
+  });
+
+  SubObjectSelection selection;
+  const glm::vec2 screenCenter(kViewportWidth * 0.5f, kViewportHeight * 0.5f);
+  runner.Run("Selection/FindClosestVertex", triangles, [&]() {
+    DoNotOptimize(selection.FindClosestVertex_ForTests(
+        mesh, glm::mat4(1.0f), screenCenter, camera.view, camera.projection,
+        camera.forward, kViewportWidth, kViewportHeight, 10.0f));
+  });
+  runner.Run("Selection/FindClosestEdge", triangles, [&]() {
+    DoNotOptimize(selection.FindClosestEdge_ForTests(
+        mesh, glm::mat4(1.0f), screenCenter, camera.view, camera.projection,
+        camera.forward, kViewportWidth, kViewportHeight, 10.0f));
+  });
+  const uint32_t n = grid.quadsPerSide;
+  runner.Run("Selection/FindShortestPath", triangles, [&]() {
+    DoNotOptimize(selection.FindShortestPath_ForTests(
+        mesh, grid.VertexIndex(0, 0), grid.VertexIndex(n, n)));
+  });
+}
+
+void benchSculptTools(BenchmarkRunner& runner, const GridMesh& grid,
+                      const SculptableMesh& baseMesh) {
+  const size_t triangles = grid.TriangleCount();
+  const View camera;
+  const auto samples = makeSurfaceSamples();
+
+  BrushSettings settings;
+  settings.radius = kBrushRadius;
+  settings.strength = 0.5f;
+
+  // Each iteration is one dab at the next sample point. Normals are brought
+  // up to date between dabs, untimed, as the editor does every frame.
+  auto runTool = [&](const std::string& name, ISculptTool& tool,
+                     auto&& prepareDab) {
+    if (!runner.IsEnabled(name)) return;
+    SculptableMesh mesh = baseMesh;
+    size_t dab = 0;
+    glm::vec2 mouseDelta(0.0f);
+    runner.Run(
+        name, triangles,
+        [&]() {
+          glm::vec3 hit = samples[dab % samples.size()];
+          tool.Apply(mesh, hit, glm::normalize(hit - camera.eye), mouseDelta,
+                     settings, camera.view, camera.projection, kViewportWidth,
+                     kViewportHeight);
+        },
+        [&]() {
+          mesh.RecalculateDirtyNormals();
+          ++dab;
+          prepareDab(dab, mouseDelta);
+        });
+  };
+
+  // Alternating directions keeps the surface from drifting over many dabs.
+  PushPullTool pushPull;
+  runTool("Sculpt/PushPull", pushPull, [&](size_t dab, glm::vec2&) {
+    settings.mode = dab % 2 ? SculptMode::Pull : SculptMode::Push;
+  });
+  SmoothTool smooth;
+  runTool("Sculpt/Smooth", smooth, [&](size_t, glm::vec2&) {
+    settings.mode = SculptMode::Smooth;
+  });
+  GrabTool grab;
+  runTool("Sculpt/Grab", grab, [&](size_t dab, glm::vec2& mouseDelta) {
+    settings.mode = SculptMode::Grab;
+    mouseDelta = glm::vec2(dab % 2 ? 4.0f : -4.0f, 0.0f);
+  });
+}
+
+void benchMeshEditing(BenchmarkRunner& runner, const GridMesh& grid,
+                      const SculptableMesh& baseMesh) {
+  const size_t triangles = grid.TriangleCount();
+  const uint32_t n = grid.quadsPerSide;
+  // A block of up to size x size quads around the middle of the grid.
+  auto centeredBlock = [n](uint32_t size) {
+    size = std::min(size, n);
+    uint32_t first = (n - size) / 2;
+    return std::pair(first, first + size);
+  };
+
+  std::unordered_set<uint32_t> faces;
+  auto [faceBegin, faceEnd] = centeredBlock(8);
+  for (uint32_t row = faceBegin; row < faceEnd; ++row) {
+    for (uint32_t column = faceBegin; column < faceEnd; ++column) {
+      faces.insert(grid.FaceIndex(column, row));
+      faces.insert(grid.FaceIndex(column, row) + 1);
+    }
+  }
+
+  std::unordered_set<uint32_t> weldVertices;
+  auto [weldBegin, weldEnd] = centeredBlock(3);
+  for (uint32_t row = weldBegin; row <= weldEnd; ++row) {
+    for (uint32_t column = weldBegin; column <= weldEnd; ++column) {
+      weldVertices.insert(grid.VertexIndex(column, row));
+    }
+  }
+
+  std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash> edges;
+  auto [edgeBegin, edgeEnd] = centeredBlock(32);
+  for (uint32_t column = edgeBegin; column < edgeEnd; ++column) {
+    edges.insert({grid.VertexIndex(column, n / 2),
+                  grid.VertexIndex(column + 1, n / 2)});
+  }
+
+  // These operations change topology, so every iteration starts from a
+  // fresh copy of the mesh.
+  SculptableMesh mesh;
+  auto restore = [&]() { mesh = baseMesh; };
+  runner.Run(
+      "Edit/ExtrudeFaces", triangles,
+      [&]() { mesh.ExtrudeFaces(faces, 0.05f); }, restore);
+  runner.Run(
+      "Edit/WeldVertices", triangles,
+      [&]() { mesh.WeldVertices(weldVertices, glm::vec3(0.0f)); }, restore);
+  runner.Run(
+      "Edit/BevelEdges", triangles,
+      [&]() { mesh.BevelEdges(edges, 0.02f); }, restore);
+}
+
+void benchIcosphere(BenchmarkRunner& runner, size_t targetTriangles) {
+  // An icosphere has 20 * 4^level triangles; pick the nearest level.
+  int level = std::clamp(
+      static_cast<int>(std::lround(
+          std::log(static_cast<double>(targetTriangles) / 20.0) /
+          std::log(4.0))),
+      0, Icosphere::kMaxRecursionLevel);
+  size_t triangles = static_cast<size_t>(20) << (2 * level);
+
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  runner.Run("Icosphere/Generate", triangles, [&]() {
+    Icosphere::GenerateMesh(level, 1.0f, vertices, indices);
+    DoNotOptimize(indices.data());
+  });
+}
+
+void benchSceneIO(BenchmarkRunner& runner, const GridMesh& grid,
+                  const SculptableMesh& baseMesh,
+                  const std::filesystem::path& tempDir) {
+  const size_t triangles = grid.TriangleCount();
+
+  SceneObjectFactory factory;
+  factory.Register(BenchMeshObject::kTypeName,
+                   []() { return std::make_unique<BenchMeshObject>(); });
+
+  for (const char* extension : {".json", ".imscene"}) {
+    const std::string format = extension[1] == 'j' ? "Json" : "Binary";
+    const std::string saveName = "Scene/Save" + format;
+    const std::string loadName = "Scene/Load" + format;
+    if (!runner.IsEnabled(saveName) && !runner.IsEnabled(loadName)) continue;
+
+    Scene scene(&factory);
+    auto object = std::make_unique<BenchMeshObject>();
+    object->GetMesh() = baseMesh;
+    scene.AddObject(std::move(object));
+
+    const std::string path = (tempDir / ("bench_scene" + std::string(extension))).string();
+    scene.Save(path);
+    runner.Run(saveName, triangles, [&]() { scene.Save(path); });
+    runner.Run(loadName, triangles, [&]() { scene.Load(path); });
+    std::filesystem::remove(path);
+  }
+
+  if (runner.IsEnabled("ResourceManager/LoadMesh")) {
+    const std::string path = (tempDir / "bench_mesh.obj").string();
+    if (!WriteObj(grid, path)) {
+      std::fprintf(stderr, "Could not write %s\n", path.c_str());
+      return;
+    }
+    runner.Run("ResourceManager/LoadMesh", triangles, [&]() {
+      auto mesh = ResourceManager::LoadMesh(path);
+      DoNotOptimize(mesh.second.data());
+    });
+    std::filesystem::remove(path);
+  }
+}
+
+bool parseArgument(std::string_view arg, std::string_view flag,
+                   std::string& outValue) {
+  if (arg.size() <= flag.size() + 1 || arg.substr(0, flag.size()) != flag ||
+      arg[flag.size()] != '=') {
+    return false;
+  }
+  outValue = std::string(arg.substr(flag.size() + 1));
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchmarkOptions options;
+  std::string outPath = "bench_results.json";
+  size_t maxTriangles = kMeshSizes[std::size(kMeshSizes) - 1];
+
+  for (int i = 1; i < argc; ++i) {
+    std::string value;
+    if (parseArgument(argv[i], "--out", value)) {
+      outPath = value;
+    } else if (parseArgument(argv[i], "--filter", value)) {
+      options.filter = value;
+    } else if (parseArgument(argv[i], "--max-triangles", value)) {
+      maxTriangles = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (parseArgument(argv[i], "--min-time", value)) {
+      options.minSeconds = std::strtod(value.c_str(), nullptr);
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--out=FILE] [--filter=SUBSTRING] "
+                   "[--max-triangles=N] [--min-time=SECONDS]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  BenchmarkRunner runner(options);
+  const auto tempDir = std::filesystem::temp_directory_path();
+
+  for (size_t size : kMeshSizes) {
+    if (size > maxTriangles) break;
+
+    GridMesh grid = MakeGridMesh(size);
+    SculptableMesh baseMesh;
+    baseMesh.Initialize(grid.vertices, grid.indices);
+
+    benchMesh(runner, grid, baseMesh);
+    benchSculptTools(runner, grid, baseMesh);
+    benchMeshEditing(runner, grid, baseMesh);
+    benchIcosphere(runner, size);
+    benchSceneIO(runner, grid, baseMesh, tempDir);
+  }
+
+  std::ofstream out(outPath);
+  out << runner.ToJson().dump(2) << '\n';
+  if (!out) {
+    std::fprintf(stderr, "Could not write %s\n", outPath.c_str());
+    return 1;
+  }
+  std::printf("Wrote %zu results to %s\n", runner.GetResults().size(),
+              outPath.c_str());
+  return 0;
+}
@@ -6,8 +6,11 @@ out vec3 FragPos;
 out vec3 Normal;
 
 uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
+layout (std140) uniform Camera {
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_ViewPos;
+};
 
 void main()
 {
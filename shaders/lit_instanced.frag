@@ -0,0 +1,20 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 Normal;
+in vec3 FragPos;
+in vec4 Color;
+
+void main()
+{
+    // Same lighting as lit.frag, with the color coming from the instance
+    vec3 lightDir = normalize(vec3(-0.5, -1.0, -0.3));
+
+    float ambientStrength = 0.2;
+    vec3 ambient = ambientStrength * Color.rgb;
+
+    float diff = max(dot(normalize(Normal), -lightDir), 0.0);
+    vec3 diffuse = diff * Color.rgb;
+
+    FragColor = vec4(ambient + diffuse, Color.a);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// Per instance: the model matrix takes four attribute slots.
+layout (location = 2) in mat4 aModel;
+layout (location = 6) in vec4 aColor;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Color;
+
+layout (std140) uniform Camera {
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_ViewPos;
+};
+
+void main()
+{
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(aModel))) * aNormal;
+    Color = aColor;
+
+    gl_Position = u_Projection * u_View * vec4(FragPos, 1.0);
+}
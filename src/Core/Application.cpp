@@ -9,8 +9,11 @@
 #include <string>
 
 #include "Core/Camera.h"
+#include "Core/CommandHistory.h"
+#include "Core/EditCommands.h"
 #include "Core/Log.h"
 #include "Core/MathHelpers.h"
+#include "Core/Profiler.h"
 #include "Core/Raycaster.h"
 #include "Core/ResourceManager.h"
 #include "Core/SettingsManager.h"
@@ -18,6 +21,7 @@
 #include "Core/UI/HierarchyView.h"
 #include "Core/UI/InspectorView.h"
 #include "Core/UI/MenuBar.h"
+#include "Core/UI/ProfilerView.h"
 #include "Core/UI/SettingsWindow.h"
 #include "Core/UI/ToolsPane.h"
 #include "Core/UI/ViewportPane.h"
@@ -25,6 +29,7 @@
 #include "Interfaces.h"
 #include "Renderer/OpenGLRenderer.h"
 #include "Scene/Grid.h"
+#include "Scene/MeshRebuildScheduler.h"
 #include "Scene/Objects/CustomMesh.h"
 #include "Scene/Objects/Icosphere.h"
 #include "Scene/Objects/ObjectTypes.h"
@@ -34,6 +39,7 @@
 #include "Scene/Scene.h"
 #include "Scene/TransformGizmo.h"
 #include "Sculpting/ISculptTool.h"
+#include "Sculpting/MeshDelta.h"
 #include "Sculpting/MeshEditor.h"
 #include "Sculpting/SculptableMesh.h"
 #include "Sculpting/SubObjectSelection.h"
@@ -43,6 +49,13 @@
 #include "imgui.h"
 #include "implot.h"
 
+namespace {
+
+// Drawn over the element under the cursor in sub-object mode.
+const glm::vec4 kHoverHighlightColor(1.0f, 1.0f, 1.0f, 0.8f);
+
+}  // namespace
+
 Application* Application::s_Instance = nullptr;
 
 Application::Application(int initialWidth, int initialHeight)
@@ -57,6 +70,7 @@ Application& Application::Get() { return *s_Instance; }
 
 void Application::Initialize() {
   Log::Debug("Application::Initialize - Starting initialization.");
+  Profiler::Get().SetThreadName("Main");
 
   if (!SettingsManager::Load("settings.json")) {
     Log::Debug("No settings.json found, using default values.");
@@ -91,6 +105,10 @@ void Application::Initialize() {
     throw std::runtime_error("Failed to initialize Renderer");
   }
 
+  // The frame loop polls objects every frame, so property edits can rebuild
+  // their meshes in the background and swap in on a later frame.
+  MeshRebuildScheduler::Get().SetEnabled(true);
+
   m_ObjectFactory = std::make_unique<SceneObjectFactory>();
   RegisterObjectTypes();
   m_Scene = std::make_unique<Scene>(m_ObjectFactory.get());
@@ -102,6 +120,8 @@ void Application::Initialize() {
   m_GrabTool = std::make_unique<GrabTool>();
   m_Selection = std::make_unique<SubObjectSelection>();
   m_MeshEditor = std::make_unique<MeshEditor>();
+  m_History = std::make_unique<CommandHistory>();
+  m_VertexRecorder = std::make_unique<VertexDeltaRecorder>();
 
   m_UI = std::make_unique<AppUI>(this);
   m_UI->Initialize(m_Window);
@@ -112,6 +132,7 @@ void Application::Initialize() {
   m_UI->RegisterView<HierarchyView>(this);
   m_UI->RegisterView<InspectorView>(this);
   m_UI->RegisterView<SettingsWindow>(this);
+  m_UI->RegisterView<ProfilerView>(this);
 
   m_Scene->AddObject(m_ObjectFactory->Create("Grid"));
   m_Scene->AddObject(m_ObjectFactory->Create("Icosphere"));
@@ -119,15 +140,23 @@ void Application::Initialize() {
 }
 
 void Application::Run() {
+  Profiler& profiler = Profiler::Get();
   while (!glfwWindowShouldClose(m_Window)) {
+    profiler.BeginFrame();
     glfwPollEvents();
     Update();
     Render();
-    glfwSwapBuffers(m_Window);
+    {
+      PROFILE_SCOPE("SwapBuffers");
+      glfwSwapBuffers(m_Window);
+    }
+    m_Renderer->GetGpuTimer().EndFrame(profiler.GetFrameIndex());
+    profiler.EndFrame();
   }
 }
 
 void Application::Update() {
+  PROFILE_SCOPE("Update");
   float now = static_cast<float>(glfwGetTime());
   m_DeltaTime = now - m_LastFrame;
   m_LastFrame = now;
@@ -161,11 +190,15 @@ void Application::Update() {
 
   processGlobalKeyboardShortcuts();
   processMouseActions();
+  recordHistory();
 }
 
 void Application::Render() {
+  PROFILE_SCOPE("Render");
   if (m_SceneRenderRequested) {
+    PROFILE_SCOPE("Scene");
     m_Renderer->BeginSceneFrame();
+    ISceneObject* ghosted = nullptr;
     for (const auto& object : m_Scene->GetSceneObjects()) {
       if (!object) continue;
 
@@ -173,13 +206,19 @@ void Application::Render() {
           object->isSelected && (m_EditorMode == EditorMode::SUB_OBJECT ||
                                  m_EditorMode == EditorMode::SCULPT);
       if (isGhosted) {
-        m_Renderer->RenderObjectAsGhost(*object, *m_Camera,
-                                        glm::vec4(0.3f, 0.5f, 0.8f, 0.2f));
+        ghosted = object.get();
       } else {
+        // Mesh objects are queued and drawn batched by the flush below.
         object->Draw(*m_Renderer, m_Camera->GetViewMatrix(),
                      m_Camera->GetProjectionMatrix());
       }
     }
+    m_Renderer->FlushRenderQueue(*m_Camera);
+    // Drawn last so the opaque objects behind it show through.
+    if (ghosted) {
+      m_Renderer->RenderObjectAsGhost(*ghosted, *m_Camera,
+                                      glm::vec4(0.3f, 0.5f, 0.8f, 0.2f));
+    }
 
     if (auto* sel = m_Scene->GetSelectedObject()) {
       if (m_EditorMode == EditorMode::TRANSFORM) {
@@ -187,30 +226,52 @@ void Application::Render() {
                            m_Camera->GetProjectionMatrix());
         m_TransformGizmo->Draw(*m_Renderer, *m_Camera);
       } else if (m_EditorMode == EditorMode::SUB_OBJECT) {
-        if (auto* editableMesh = sel->GetEditableMesh()) {
-          m_Renderer->RenderSelectedFaces(*editableMesh,
+        if (const auto* mesh = sel->GetMesh()) {
+          m_Renderer->RenderSelectedFaces(*mesh,
                                           m_Selection->GetSelectedFaces(),
                                           sel->GetTransform(), *m_Camera);
-          m_Renderer->RenderSelectedEdges(*editableMesh,
+          m_Renderer->RenderSelectedEdges(*mesh,
                                           m_Selection->GetSelectedEdges(),
                                           sel->GetTransform(), *m_Camera);
-          m_Renderer->RenderVertexHighlights(*editableMesh,
+          m_Renderer->RenderVertexHighlights(*mesh,
                                              m_Selection->GetSelectedVertices(),
                                              sel->GetTransform(), *m_Camera);
-          m_Renderer->RenderHighlightedPath(*editableMesh, m_Selection->GetHighlightedPath(), sel->GetTransform(), *m_Camera);
+          m_Renderer->RenderHighlightedPath(*mesh, m_Selection->GetHighlightedPath(), sel->GetTransform(), *m_Camera);
+          if (int vertex = m_Selection->GetHoveredVertex(); vertex >= 0) {
+            m_Renderer->RenderVertexHighlights(
+                *mesh, {static_cast<uint32_t>(vertex)}, sel->GetTransform(),
+                *m_Camera, kHoverHighlightColor);
+          }
+          if (auto edge = m_Selection->GetHoveredEdge(); edge.first >= 0) {
+            m_Renderer->RenderSelectedEdges(
+                *mesh,
+                {{static_cast<uint32_t>(edge.first),
+                  static_cast<uint32_t>(edge.second)}},
+                sel->GetTransform(), *m_Camera, kHoverHighlightColor);
+          }
         }
       }
     }
     m_Renderer->EndSceneFrame();
     m_SceneRenderRequested = false;
   }
+  if (SettingsManager::Get().asyncPicking) {
+    m_Renderer->UpdatePicking(
+        *m_Scene, *m_Camera,
+        m_EditorMode == EditorMode::TRANSFORM ? m_TransformGizmo.get() : nullptr);
+  }
 
-  m_UI->BeginFrame();
-  m_UI->Draw();
-  if (m_ShowMetricsWindow) {
-    ImGui::ShowMetricsWindow(&m_ShowMetricsWindow);
+  {
+    PROFILE_SCOPE("UI");
+    m_UI->BeginFrame();
+    m_UI->Draw();
+    if (m_ShowMetricsWindow) {
+      ImGui::ShowMetricsWindow(&m_ShowMetricsWindow);
+    }
   }
 
+  PROFILE_SCOPE("UI Draw");
+  GpuZone gpuZone(m_Renderer->GetGpuTimer(), "UI");
   m_Renderer->BeginFrame();
   m_UI->EndFrame();
 }
@@ -231,8 +292,11 @@ void Application::RegisterObjectTypes() {
                             []() { return std::make_unique<CustomMesh>(); });
 }
 
-void Application::OnSceneLoaded() {
-  m_Scene->Load("scene.json");
+void Application::OnSceneLoaded(const std::string& filepath) {
+  m_VertexRecorder->Cancel();
+  m_History->Clear();
+  m_TrackedObjectID = 0;
+  m_Scene->Load(filepath);
   SelectObject(0);
   m_TransformGizmo->SetTarget(nullptr);
   RequestSceneRender();
@@ -293,7 +357,7 @@ void Application::SetEditorMode(EditorMode newMode,
   } else {
     m_TransformGizmo->SetTarget(nullptr);
 
-    if (!selectedObject || !selectedObject->GetEditableMesh()) {
+    if (!selectedObject || !selectedObject->GetMesh()) {
       Log::Debug(
           "Cannot enter Sculpt or Sub-Object mode: No editable mesh on "
           "selected object. Switching to Transform mode.");
@@ -306,6 +370,8 @@ void Application::SetEditorMode(EditorMode newMode,
 
 void Application::Cleanup() {
   Log::Debug("Application::Cleanup - Shutting down...");
+  MeshRebuildScheduler::Get().SetEnabled(false);
+  MeshRebuildScheduler::Get().WaitIdle();
   ImPlot::DestroyContext();
   m_UI->Shutdown();
   m_Renderer->Shutdown();
@@ -320,8 +386,9 @@ void Application::RequestObjectCreation(const std::string& typeName) {
   m_RequestedCreationTypeNames.push_back(typeName);
 }
 
-void Application::RequestObjectDuplication(uint32_t objectID) {
+void Application::RequestObjectDuplication(uint32_t objectID, int count) {
   m_RequestedDuplicateID = objectID;
+  m_RequestedDuplicateCount = count;
 }
 
 void Application::RequestObjectDeletion(uint32_t objectID) {
@@ -346,6 +413,7 @@ void Application::RequestBevelEdge(float amount) {
 }
 
 void Application::ProcessPendingActions() {
+  PROFILE_SCOPE("ProcessPendingActions");
   if (!m_RequestedCreationTypeNames.empty()) {
     for (const auto& typeName : m_RequestedCreationTypeNames) {
       if (auto obj = m_ObjectFactory->Create(typeName)) {
@@ -356,52 +424,51 @@ void Application::ProcessPendingActions() {
   }
 
   if (m_RequestedDuplicateID != 0) {
-    m_Scene->DuplicateObject(m_RequestedDuplicateID);
+    m_Scene->DuplicateObject(m_RequestedDuplicateID, m_RequestedDuplicateCount);
     m_RequestedDuplicateID = 0;
   }
 
   if (!m_RequestedDeletionIDs.empty()) {
+    const ISceneObject* selected = m_Scene->GetSelectedObject();
     for (uint32_t id : m_RequestedDeletionIDs) {
+      // The sub-object selection indexes the mesh about to go away.
+      if (selected && selected->id == id) m_Selection->Clear();
       m_Scene->QueueForDeletion(id);
     }
     m_RequestedDeletionIDs.clear();
   }
 
   if (m_ExtrudeRequested) {
-    if (auto* sel = m_Scene->GetSelectedObject()) {
-      if (auto* mesh = sel->GetEditableMesh()) {
-        m_MeshEditor->Extrude(*mesh, *m_Selection, m_ExtrudeDistance);
-        sel->SetMeshDirty(true);
-      }
-    }
+    applyTopologyEdit("Extrude", [this](IEditableMesh& mesh) {
+      m_MeshEditor->Extrude(mesh, *m_Selection, m_ExtrudeDistance);
+    });
     m_ExtrudeRequested = false;
   }
 
   if (m_BevelRequested) {
-    if (auto* sel = m_Scene->GetSelectedObject()) {
-      if (auto* mesh = sel->GetEditableMesh()) {
-        m_MeshEditor->BevelEdges(*mesh, *m_Selection, m_BevelAmount);
-        sel->SetMeshDirty(true);
-      }
-    }
+    applyTopologyEdit("Bevel", [this](IEditableMesh& mesh) {
+      m_MeshEditor->BevelEdges(mesh, *m_Selection, m_BevelAmount);
+    });
     m_BevelRequested = false;
   }
 
   if (m_WeldRequested) {
-    if (auto* sel = m_Scene->GetSelectedObject()) {
-      if (auto* mesh = sel->GetEditableMesh()) {
-        m_MeshEditor->Weld(*mesh, *m_Selection);
-        sel->SetMeshDirty(true);
-      }
-    }
+    applyTopologyEdit("Weld", [this](IEditableMesh& mesh) {
+      m_MeshEditor->Weld(mesh, *m_Selection);
+    });
     m_WeldRequested = false;
   }
 
   if (m_MoveSelectionRequested) {
     if (auto* sel = m_Scene->GetSelectedObject()) {
       if (auto* mesh = sel->GetEditableMesh()) {
+        const auto& selected = m_Selection->GetSelectedVertices();
+        beginVertexEdit(*sel, "Move Along Normal");
+        m_VertexRecorder->Capture(
+            *mesh, std::vector<uint32_t>(selected.begin(), selected.end()));
         m_MeshEditor->MoveAlongNormal(*mesh, *m_Selection,
                                       m_MoveSelectionDistance);
+        commitVertexEdit();
         sel->SetMeshDirty(true);
       }
     }
@@ -409,12 +476,141 @@ void Application::ProcessPendingActions() {
   }
 }
 
+void Application::AddSubdivisionLevel() {
+  ISceneObject* sel = m_Scene->GetSelectedObject();
+  if (!sel) return;
+  commitVertexEdit();
+  if (sel->AddSubdivisionLevel()) {
+    m_History->Clear();
+    m_Selection->Clear();
+    RequestSceneRender();
+  }
+}
+
+void Application::SetSubdivisionLevel(int level) {
+  ISceneObject* sel = m_Scene->GetSelectedObject();
+  if (!sel || level == sel->GetSubdivisionLevel()) return;
+  commitVertexEdit();
+  sel->SetSubdivisionLevel(level);
+  m_History->Clear();
+  m_Selection->Clear();
+  RequestSceneRender();
+}
+
+void Application::Undo() {
+  commitVertexEdit();
+  if (m_History->Undo(*m_Scene)) RequestSceneRender();
+  // Indices may be gone, and the restored values are not a new edit.
+  m_Selection->Clear();
+  m_TrackedObjectID = 0;
+}
+
+void Application::Redo() {
+  commitVertexEdit();
+  if (m_History->Redo(*m_Scene)) RequestSceneRender();
+  m_Selection->Clear();
+  m_TrackedObjectID = 0;
+}
+
+void Application::recordHistory() {
+  m_History->SetMemoryBudget(
+      static_cast<size_t>(std::max(SettingsManager::Get().undoMemoryMB, 1))
+      << 20);
+
+  // Edits are committed once the interaction making them is over, so a
+  // whole stroke, drag or slider scrub becomes one undo step.
+  if (ImGui::IsMouseDown(ImGuiMouseButton_Left) || ImGui::IsAnyItemActive()) {
+    return;
+  }
+  commitVertexEdit();
+
+  ISceneObject* selected = m_Scene->GetSelectedObject();
+  nlohmann::json current;
+  if (selected) selected->GetPropertySet().Serialize(current);
+  if (selected && selected->id == m_TrackedObjectID) {
+    if (current == m_TrackedProperties) return;
+    if (!selected->isPristine &&
+        selected->GetMeshRebuildCount() != m_TrackedMeshRebuilds) {
+      // The edit regenerated a sculpted mesh. Undoing it cannot bring the
+      // sculpt back, and the steps before it were recorded on that mesh.
+      Log::Debug("Rebuilding a sculpted mesh cleared the undo history.");
+      m_History->Clear();
+    } else if (auto command = PropertyCommand::FromSnapshots(
+                   selected->id, m_TrackedProperties, current)) {
+      m_History->Push(std::move(command));
+    }
+  }
+  m_TrackedObjectID = selected ? selected->id : 0;
+  m_TrackedProperties = std::move(current);
+  m_TrackedMeshRebuilds = selected ? selected->GetMeshRebuildCount() : 0;
+}
+
+void Application::beginVertexEdit(ISceneObject& object, const char* name) {
+  commitVertexEdit();
+  m_VertexRecorder->Begin(*object.GetCurrentMesh());
+  m_VertexEditObjectID = object.id;
+  m_VertexEditName = name;
+  m_VertexEditWasPristine = object.isPristine;
+}
+
+void Application::commitVertexEdit() {
+  if (!m_VertexRecorder->IsRecording()) return;
+  ISceneObject* object = m_Scene->GetObjectByID(m_VertexEditObjectID);
+  IEditableMesh* mesh = object ? object->GetEditableMesh() : nullptr;
+  if (!mesh) {
+    m_VertexRecorder->Cancel();
+    return;
+  }
+  VertexDelta delta = m_VertexRecorder->End(*mesh);
+  object->SetMeshDirty(true);
+  if (delta.IsEmpty()) return;
+  // An edited mesh is no longer what the object's properties build.
+  object->isPristine = false;
+  m_History->Push(std::make_unique<VertexDeltaCommand>(
+      m_VertexEditName, object->id, std::move(delta), m_VertexEditWasPristine));
+}
+
+void Application::applyTopologyEdit(
+    const char* name, const std::function<void(IEditableMesh&)>& edit) {
+  ISceneObject* sel = m_Scene->GetSelectedObject();
+  IEditableMesh* mesh = sel ? sel->GetEditableMesh() : nullptr;
+  if (!mesh) return;
+  commitVertexEdit();
+  // Levels need a fixed base topology; the shown level becomes the new mesh.
+  sel->ClearSubdivisionLevels();
+
+  // The edit happens inside the mesh, so diff against a copy taken first.
+  const IEditableMesh& current = *mesh;
+  std::vector<glm::vec3> vertices = current.GetVertices();
+  std::vector<unsigned int> indices = current.GetIndices();
+  edit(*mesh);
+  sel->SetMeshDirty(true);
+
+  TopologyDelta delta = TopologyDelta::Compute(vertices, indices, *mesh);
+  if (!delta.IsEmpty()) {
+    const bool wasPristine = sel->isPristine;
+    sel->isPristine = false;
+    m_History->Push(std::make_unique<TopologyCommand>(
+        name, sel->id, std::move(delta), wasPristine));
+  }
+}
+
 void Application::processGlobalKeyboardShortcuts() {
   if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS) Exit();
 
   ImGuiIO& io = ImGui::GetIO();
   if (io.WantTextInput) return;
 
+  if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Z)) {
+    if (io.KeyShift) {
+      Redo();
+    } else {
+      Undo();
+    }
+  } else if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Y)) {
+    Redo();
+  }
+
   static bool delPressed = false;
   if (glfwGetKey(m_Window, GLFW_KEY_DELETE) == GLFW_PRESS && !delPressed) {
     if (auto* selected = m_Scene->GetSelectedObject()) {
@@ -434,17 +630,33 @@ void Application::processMouseActions() {
     m_TransformGizmo->SetActiveHandle(0);
     m_DraggedObject = nullptr;
     if (m_Selection->IsDragging()) {
-      if (auto* sel = m_Scene->GetSelectedObject()) {
-        if (auto* mesh = sel->GetEditableMesh()) {
-          m_Selection->OnMouseRelease(*mesh);
-        }
-      }
+      auto* sel = m_Scene->GetSelectedObject();
+      m_Selection->OnMouseRelease(
+          sel && m_Selection->HasDragMovedVertices() ? sel->GetEditableMesh()
+                                                     : nullptr);
     }
+    if (m_Selection->ClearHover()) RequestSceneRender();
     return;
   }
 
   bool isShiftPressed = ImGui::GetIO().KeyShift;
 
+  if (m_EditorMode == EditorMode::SUB_OBJECT && !m_Selection->IsDragging()) {
+    auto* sel = m_Scene->GetSelectedObject();
+    if (sel && sel->GetMesh()) {
+      const auto& vb = vp->GetBounds();
+      ImVec2 absMousePosImGui = ImGui::GetMousePos();
+      glm::vec2 mousePos = MathHelpers::ToGlm(
+          {absMousePosImGui.x - vb[0].x, absMousePosImGui.y - vb[0].y});
+      if (m_Selection->UpdateHover(*sel->GetMesh(), *m_Camera,
+                                   sel->GetTransform(), mousePos,
+                                   (int)vp->GetSize().x, (int)vp->GetSize().y,
+                                   m_SubObjectMode)) {
+        RequestSceneRender();
+      }
+    }
+  }
+
   if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
     const auto& vb = vp->GetBounds();
     ImVec2 absMousePosImGui = ImGui::GetMousePos();
@@ -454,32 +666,33 @@ void Application::processMouseActions() {
     int my = static_cast<int>(mousePos.y);
 
     if (m_EditorMode == EditorMode::TRANSFORM) {
-      uint32_t gizmoID =
-          m_Renderer->ProcessGizmoPicking(mx, my, *m_TransformGizmo, *m_Camera);
-      if (TransformGizmo::IsGizmoID(gizmoID)) {
-        m_IsDraggingGizmo = true;
-        m_TransformGizmo->SetActiveHandle(gizmoID);
+      if (SettingsManager::Get().asyncPicking) {
+        m_Renderer->RequestPick(mx, my,
+                                [this](uint32_t id) { onTransformPick(id); });
       } else {
-        uint32_t objectID =
-            m_Renderer->ProcessPicking(mx, my, *m_Scene, *m_Camera);
-        SelectObject(objectID);
-        m_DraggedObject = m_Scene->GetObjectByID(objectID);
-        if (m_DraggedObject) {
-            glm::mat4 viewProj = m_Camera->GetProjectionMatrix() * m_Camera->GetViewMatrix();
-            glm::vec4 clipPos = viewProj * glm::vec4(m_DraggedObject->GetPosition(), 1.0f);
-            m_DragNDCDepth = (clipPos.w != 0.0f) ? (clipPos.z / clipPos.w) : 0.0f;
+        uint32_t id =
+            m_Renderer->ProcessGizmoPicking(mx, my, *m_TransformGizmo, *m_Camera);
+        if (!TransformGizmo::IsGizmoID(id)) {
+          id = m_Renderer->ProcessPicking(mx, my, *m_Scene, *m_Camera);
         }
+        onTransformPick(id);
       }
     } else if (m_EditorMode == EditorMode::SUB_OBJECT) {
+      // Picking only reads; a click must not detach a shared mesh. The
+      // current mesh is the one a drag will edit.
       auto* sel = m_Scene->GetSelectedObject();
-      if (sel && sel->GetEditableMesh()) {
-        glm::vec3 ray_origin = m_Camera->GetPosition();
-        glm::vec3 ray_direction = m_Camera->ScreenToWorldRay(
-            mousePos, (int)vp->GetSize().x, (int)vp->GetSize().y);
-        m_Selection->OnMouseDown(*sel->GetEditableMesh(), *m_Camera,
+      if (sel && sel->GetCurrentMesh()) {
+        m_Selection->OnMouseDown(*sel->GetCurrentMesh(), *m_Camera,
                                  sel->GetTransform(), mousePos,
                                  (int)vp->GetSize().x, (int)vp->GetSize().y,
                                  isShiftPressed, m_SubObjectMode);
+        if (m_Selection->IsDragging()) {
+          const auto& selected = m_Selection->GetSelectedVertices();
+          beginVertexEdit(*sel, "Move Vertices");
+          m_VertexRecorder->Capture(
+              *sel->GetMesh(),
+              std::vector<uint32_t>(selected.begin(), selected.end()));
+        }
         RequestSceneRender();
       }
     } else if (m_EditorMode == EditorMode::SCULPT) {
@@ -495,23 +708,44 @@ void Application::processMouseActions() {
     m_DraggedObject = nullptr;
     if (m_EditorMode == EditorMode::SUB_OBJECT && m_Selection->IsDragging()) {
       auto* sel = m_Scene->GetSelectedObject();
-      if (sel && sel->GetEditableMesh()) {
-        m_Selection->OnMouseRelease(*sel->GetEditableMesh());
-        RequestSceneRender();
-      }
+      m_Selection->OnMouseRelease(
+          sel && m_Selection->HasDragMovedVertices() ? sel->GetEditableMesh()
+                                                     : nullptr);
+      RequestSceneRender();
     }
   }
 }
 
+void Application::onTransformPick(uint32_t id) {
+  // An async pick can be answered after the button was released; it still
+  // selects, but must not start a drag nobody is holding.
+  bool mouseDown = ImGui::IsMouseDown(ImGuiMouseButton_Left);
+  if (TransformGizmo::IsGizmoID(id)) {
+    if (mouseDown) {
+      m_IsDraggingGizmo = true;
+      m_TransformGizmo->SetActiveHandle(id);
+    }
+    return;
+  }
+
+  SelectObject(id);
+  m_DraggedObject = mouseDown ? m_Scene->GetObjectByID(id) : nullptr;
+  if (m_DraggedObject) {
+      glm::mat4 viewProj = m_Camera->GetProjectionMatrix() * m_Camera->GetViewMatrix();
+      glm::vec4 clipPos = viewProj * glm::vec4(m_DraggedObject->GetPosition(), 1.0f);
+      m_DragNDCDepth = (clipPos.w != 0.0f) ? (clipPos.z / clipPos.w) : 0.0f;
+  }
+}
+
 void Application::processSculpting() {
+  PROFILE_SCOPE("processSculpting");
   auto* selectedObject = m_Scene->GetSelectedObject();
-  if (!selectedObject || !selectedObject->GetEditableMesh()) {
+  if (!selectedObject || !selectedObject->GetMesh()) {
     if (m_EditorMode == EditorMode::SCULPT)
       SetEditorMode(EditorMode::TRANSFORM);
     return;
   }
 
-  auto* editableMesh = selectedObject->GetEditableMesh();
   auto* inspector = m_UI->GetView<InspectorView>();
   if (!inspector) return;
 
@@ -532,7 +766,8 @@ void Application::processSculpting() {
         mouseScreenPosRelToViewport, (int)vpSize.x, (int)vpSize.y);
 
     Raycaster::RaycastResult result;
-    if (Raycaster::IntersectMesh(ray_origin, ray_direction, *editableMesh,
+    if (Raycaster::IntersectMesh(ray_origin, ray_direction,
+                                 *selectedObject->GetMesh(),
                                  selectedObject->GetTransform(), result)) {
       SculptMode::Mode currentSculptMode = inspector->GetBrushSettings().mode;
       ISculptTool* tool = nullptr;
@@ -549,13 +784,20 @@ void Application::processSculpting() {
           break;
       }
       if (tool) {
+        if (!m_VertexRecorder->IsRecording()) {
+          beginVertexEdit(*selectedObject, "Sculpt Stroke");
+        }
         selectedObject->isPristine = false;
+        // First stroke on a shared mesh takes the object's own copy.
+        auto* editableMesh = selectedObject->GetEditableMesh();
+        m_VertexRecorder->CaptureSphere(*editableMesh, result.hitPoint,
+                                        inspector->GetBrushSettings().radius);
         tool->Apply(*editableMesh, result.hitPoint, ray_direction,
                     MathHelpers::ToGlm(ImGui::GetIO().MouseDelta),
                     inspector->GetBrushSettings(), m_Camera->GetViewMatrix(),
                     m_Camera->GetProjectionMatrix(), (int)vpSize.x,
                     (int)vpSize.y);
-        editableMesh->RecalculateNormals();
+        editableMesh->RecalculateDirtyNormals();
         selectedObject->SetMeshDirty(true);
         RequestSceneRender();
       }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Interfaces.h>
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <string>
@@ -20,6 +21,8 @@ class SmoothTool;
 class GrabTool;
 class SubObjectSelection;
 class MeshEditor;
+class CommandHistory;
+class VertexDeltaRecorder;
 
 enum class EditorMode { TRANSFORM, SCULPT, SUB_OBJECT };
 
@@ -39,6 +42,7 @@ class Application {
   Camera* GetCamera() const { return m_Camera.get(); }
   GLFWwindow* GetWindow() { return m_Window; }
   SubObjectSelection* GetSelection() { return m_Selection.get(); }
+  CommandHistory* GetHistory() const { return m_History.get(); }
 
   // --- State Management ---
   void SelectObject(uint32_t id);
@@ -57,24 +61,35 @@ class Application {
   bool GetShowSettings() const { return m_ShowSettingsWindow; }
   void SetShowMetricsWindow(bool show) { m_ShowMetricsWindow = show; }
   bool GetShowMetricsWindow() const { return m_ShowMetricsWindow; }
+  void SetShowProfiler(bool show) { m_ShowProfiler = show; }
+  bool GetShowProfiler() const { return m_ShowProfiler; }
 
   // --- Scene Render Request ---
   void RequestSceneRender() { m_SceneRenderRequested = true; }
 
   // --- Actions ---
-  void OnSceneLoaded();
+  void OnSceneLoaded(const std::string& filepath = "scene.json");
   void ImportModel(const std::string& filepath);
   void Exit();
-  void RequestObjectDuplication(uint32_t objectID);
+  void RequestObjectDuplication(uint32_t objectID, int count = 1);
   void RequestObjectDeletion(uint32_t objectID);
   void RequestObjectCreation(const std::string& typeName);
   void RequestExtrude(float distance);
   void RequestWeld();
   void RequestBevelEdge(float amount);
   void RequestMoveSelection(float distance);
+  // Multires levels of the selected object. Changing levels swaps the mesh
+  // the undo steps refer to, so both also clear the history.
+  void AddSubdivisionLevel();
+  void SetSubdivisionLevel(int level);
+  void Undo();
+  void Redo();
 
   // --- Singleton Accessor ---
   static Application& Get();
+  // False in headless tools (e.g. the benchmarks) that use engine code
+  // without creating a window.
+  static bool HasInstance() { return s_Instance != nullptr; }
 
 #if defined(INTUITIVE_MODELER_TESTING)
   void ProcessPendingActions_ForTests() { ProcessPendingActions(); }
@@ -91,8 +106,17 @@ class Application {
   void ProcessPendingActions();
   void processGlobalKeyboardShortcuts();
   void processMouseActions();
+  void onTransformPick(uint32_t id);
   void processSculpting();
 
+  // --- Undo History ---
+  // Commits finished vertex edits and property edits of the selected object.
+  void recordHistory();
+  void beginVertexEdit(ISceneObject& object, const char* name);
+  void commitVertexEdit();
+  void applyTopologyEdit(const char* name,
+                         const std::function<void(IEditableMesh&)>& edit);
+
   static void framebuffer_size_callback(GLFWwindow* window, int w, int h);
   static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
   static void cursor_position_callback(GLFWwindow* window, double xpos, double ypos);
@@ -117,6 +141,8 @@ class Application {
   std::unique_ptr<GrabTool> m_GrabTool;
   std::unique_ptr<SubObjectSelection> m_Selection;
   std::unique_ptr<MeshEditor> m_MeshEditor;
+  std::unique_ptr<CommandHistory> m_History;
+  std::unique_ptr<VertexDeltaRecorder> m_VertexRecorder;
 
   EditorMode m_EditorMode = EditorMode::TRANSFORM;
   SculptMode::Mode m_SculptMode = SculptMode::Pull;
@@ -125,6 +151,7 @@ class Application {
   bool m_ShowAnchors = true;
   bool m_ShowSettingsWindow = false;
   bool m_ShowMetricsWindow = false;
+  bool m_ShowProfiler = false;
 
   bool m_SceneRenderRequested = true;
 
@@ -136,6 +163,7 @@ class Application {
 
   std::vector<std::string> m_RequestedCreationTypeNames;
   uint32_t m_RequestedDuplicateID = 0;
+  int m_RequestedDuplicateCount = 1;
   std::vector<uint32_t> m_RequestedDeletionIDs;
   bool m_ExtrudeRequested = false;
   float m_ExtrudeDistance = 0.1f;
@@ -144,4 +172,13 @@ class Application {
   bool m_WeldRequested = false;
   bool m_MoveSelectionRequested = false;
   float m_MoveSelectionDistance = 0.1f;
+
+  // The vertex edit being recorded, and the property values of the selected
+  // object as of its last committed edit.
+  uint32_t m_VertexEditObjectID = 0;
+  const char* m_VertexEditName = nullptr;
+  bool m_VertexEditWasPristine = false;
+  uint32_t m_TrackedObjectID = 0;
+  nlohmann::json m_TrackedProperties;
+  uint64_t m_TrackedMeshRebuilds = 0;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "Core/CommandHistory.h"
+
+#include "Core/Log.h"
+
+void CommandHistory::Push(std::unique_ptr<ICommand> command) {
+  if (!command) return;
+  for (const auto& undone : m_Redo) m_MemoryUsage -= undone->GetMemoryBytes();
+  m_Redo.clear();
+  m_MemoryUsage += command->GetMemoryBytes();
+  m_Undo.push_back(std::move(command));
+  enforceBudget();
+}
+
+bool CommandHistory::Undo(Scene& scene) {
+  if (m_Undo.empty()) return false;
+  std::unique_ptr<ICommand> command = std::move(m_Undo.back());
+  m_Undo.pop_back();
+  if (!command->Undo(scene)) {
+    Log::Debug("CommandHistory: dropped '", command->GetName(),
+               "', it no longer applies.");
+    m_MemoryUsage -= command->GetMemoryBytes();
+    return false;
+  }
+  m_Redo.push_back(std::move(command));
+  return true;
+}
+
+bool CommandHistory::Redo(Scene& scene) {
+  if (m_Redo.empty()) return false;
+  std::unique_ptr<ICommand> command = std::move(m_Redo.back());
+  m_Redo.pop_back();
+  if (!command->Redo(scene)) {
+    Log::Debug("CommandHistory: dropped '", command->GetName(),
+               "', it no longer applies.");
+    m_MemoryUsage -= command->GetMemoryBytes();
+    return false;
+  }
+  m_Undo.push_back(std::move(command));
+  return true;
+}
+
+const char* CommandHistory::GetUndoName() const {
+  return m_Undo.empty() ? "" : m_Undo.back()->GetName();
+}
+
+const char* CommandHistory::GetRedoName() const {
+  return m_Redo.empty() ? "" : m_Redo.back()->GetName();
+}
+
+void CommandHistory::Clear() {
+  m_Undo.clear();
+  m_Redo.clear();
+  m_MemoryUsage = 0;
+}
+
+void CommandHistory::SetMemoryBudget(size_t bytes) {
+  if (bytes == m_MemoryBudget) return;
+  m_MemoryBudget = bytes;
+  enforceBudget();
+}
+
+void CommandHistory::enforceBudget() {
+  // Oldest undo steps go first, then the redo steps furthest away.
+  while (m_MemoryUsage > m_MemoryBudget && m_Undo.size() + m_Redo.size() > 1) {
+    if (m_Undo.size() > 1 || (m_Undo.size() == 1 && m_Redo.empty())) {
+      m_MemoryUsage -= m_Undo.front()->GetMemoryBytes();
+      m_Undo.pop_front();
+    } else {
+      m_MemoryUsage -= m_Redo.front()->GetMemoryBytes();
+      m_Redo.erase(m_Redo.begin());
+    }
+  }
+}
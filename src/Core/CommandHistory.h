@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class Scene;
+
+/**
+ * @brief One undoable edit. Commands refer to objects by ID and look them
+ * up on every Undo/Redo, so they survive the scene reallocating objects.
+ */
+class ICommand {
+ public:
+  virtual ~ICommand() = default;
+
+  /** @brief Returns false if the edit no longer applies, e.g. its object
+   * was deleted. */
+  virtual bool Undo(Scene& scene) = 0;
+  virtual bool Redo(Scene& scene) = 0;
+
+  virtual const char* GetName() const = 0;
+  /** @brief Heap and object bytes held, counted against the budget. */
+  virtual size_t GetMemoryBytes() const = 0;
+};
+
+/**
+ * @brief Linear undo/redo stacks with a memory budget.
+ *
+ * Pushing a command drops everything that could have been redone. When the
+ * commands held exceed the budget, the oldest undo steps are dropped first,
+ * then the furthest redo steps. One command is always kept, so even an edit
+ * larger than the budget can be undone.
+ */
+class CommandHistory {
+ public:
+  static constexpr size_t kDefaultMemoryBudget = size_t(256) << 20;
+
+  explicit CommandHistory(size_t memoryBudget = kDefaultMemoryBudget)
+      : m_MemoryBudget(memoryBudget) {}
+
+  void Push(std::unique_ptr<ICommand> command);
+
+  /** @brief Undoes the newest command. A command that no longer applies is
+   * dropped and false is returned. */
+  bool Undo(Scene& scene);
+  bool Redo(Scene& scene);
+
+  bool CanUndo() const { return !m_Undo.empty(); }
+  bool CanRedo() const { return !m_Redo.empty(); }
+  const char* GetUndoName() const;
+  const char* GetRedoName() const;
+  size_t GetUndoCount() const { return m_Undo.size(); }
+  size_t GetRedoCount() const { return m_Redo.size(); }
+
+  void Clear();
+
+  void SetMemoryBudget(size_t bytes);
+  size_t GetMemoryBudget() const { return m_MemoryBudget; }
+  size_t GetMemoryUsage() const { return m_MemoryUsage; }
+
+ private:
+  void enforceBudget();
+
+  std::deque<std::unique_ptr<ICommand>> m_Undo;  // Newest at the back
+  std::vector<std::unique_ptr<ICommand>> m_Redo;  // Next redo at the back
+  size_t m_MemoryBudget;
+  size_t m_MemoryUsage = 0;
+};
@@ -0,0 +1,96 @@
+#include "Core/EditCommands.h"
+
+#include <utility>
+
+#include "Interfaces.h"
+#include "Scene/Scene.h"
+
+VertexDeltaCommand::VertexDeltaCommand(const char* name, uint32_t objectId,
+                                       VertexDelta delta, bool wasPristine)
+    : m_Name(name),
+      m_ObjectId(objectId),
+      m_Delta(std::move(delta)),
+      m_WasPristine(wasPristine) {}
+
+bool VertexDeltaCommand::Undo(Scene& scene) { return apply(scene, false); }
+
+bool VertexDeltaCommand::Redo(Scene& scene) { return apply(scene, true); }
+
+bool VertexDeltaCommand::apply(Scene& scene, bool forward) {
+  ISceneObject* object = scene.GetObjectByID(m_ObjectId);
+  IEditableMesh* mesh = object ? object->GetEditableMesh() : nullptr;
+  if (!mesh || !m_Delta.Apply(*mesh, forward)) return false;
+  if (m_WasPristine) object->isPristine = !forward;
+  object->SetMeshDirty(true);
+  return true;
+}
+
+size_t VertexDeltaCommand::GetMemoryBytes() const {
+  return sizeof(*this) + m_Delta.GetMemoryBytes();
+}
+
+TopologyCommand::TopologyCommand(const char* name, uint32_t objectId,
+                                 TopologyDelta delta, bool wasPristine)
+    : m_Name(name),
+      m_ObjectId(objectId),
+      m_Delta(std::move(delta)),
+      m_WasPristine(wasPristine) {}
+
+bool TopologyCommand::Undo(Scene& scene) { return apply(scene, false); }
+
+bool TopologyCommand::Redo(Scene& scene) { return apply(scene, true); }
+
+bool TopologyCommand::apply(Scene& scene, bool forward) {
+  ISceneObject* object = scene.GetObjectByID(m_ObjectId);
+  IEditableMesh* mesh = object ? object->GetEditableMesh() : nullptr;
+  if (!mesh || !m_Delta.Apply(*mesh, forward)) return false;
+  if (m_WasPristine) object->isPristine = !forward;
+  object->SetMeshDirty(true);
+  return true;
+}
+
+size_t TopologyCommand::GetMemoryBytes() const {
+  return sizeof(*this) + m_Delta.GetMemoryBytes();
+}
+
+PropertyCommand::PropertyCommand(uint32_t objectId, nlohmann::json before,
+                                 nlohmann::json after)
+    : m_ObjectId(objectId),
+      m_Before(std::move(before)),
+      m_After(std::move(after)) {
+  // A handful of small values; the dump length is close enough.
+  m_MemoryBytes = sizeof(*this) + m_Before.dump().size() + m_After.dump().size();
+}
+
+std::unique_ptr<PropertyCommand> PropertyCommand::FromSnapshots(
+    uint32_t objectId, const nlohmann::json& before,
+    const nlohmann::json& after) {
+  nlohmann::json changedBefore = nlohmann::json::object();
+  nlohmann::json changedAfter = nlohmann::json::object();
+  for (const auto& [name, value] : after.items()) {
+    auto previous = before.find(name);
+    if (previous == before.end() || *previous == value) continue;
+    changedBefore[name] = *previous;
+    changedAfter[name] = value;
+  }
+  if (changedAfter.empty()) return nullptr;
+  return std::make_unique<PropertyCommand>(objectId, std::move(changedBefore),
+                                           std::move(changedAfter));
+}
+
+bool PropertyCommand::Undo(Scene& scene) { return apply(scene, m_Before); }
+
+bool PropertyCommand::Redo(Scene& scene) { return apply(scene, m_After); }
+
+bool PropertyCommand::apply(Scene& scene, const nlohmann::json& values) {
+  ISceneObject* object = scene.GetObjectByID(m_ObjectId);
+  if (!object) return false;
+  for (const auto& item : values.items()) {
+    if (IProperty* property = object->GetPropertySet().GetProperty(item.key())) {
+      property->Assign(values);
+    }
+  }
+  return true;
+}
+
+size_t PropertyCommand::GetMemoryBytes() const { return m_MemoryBytes; }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "Core/CommandHistory.h"
+#include "Sculpting/MeshDelta.h"
+
+/** @brief Vertex moves of one sculpt stroke or vertex drag. */
+class VertexDeltaCommand : public ICommand {
+ public:
+  VertexDeltaCommand(const char* name, uint32_t objectId, VertexDelta delta,
+                     bool wasPristine);
+
+  bool Undo(Scene& scene) override;
+  bool Redo(Scene& scene) override;
+  const char* GetName() const override { return m_Name; }
+  size_t GetMemoryBytes() const override;
+
+ private:
+  bool apply(Scene& scene, bool forward);
+
+  const char* m_Name;
+  uint32_t m_ObjectId;
+  VertexDelta m_Delta;
+  // Undoing the first stroke on a primitive gives back its procedural
+  // handles.
+  bool m_WasPristine;
+};
+
+/** @brief Vertex and index changes of one extrude, weld or bevel. */
+class TopologyCommand : public ICommand {
+ public:
+  TopologyCommand(const char* name, uint32_t objectId, TopologyDelta delta,
+                  bool wasPristine = false);
+
+  bool Undo(Scene& scene) override;
+  bool Redo(Scene& scene) override;
+  const char* GetName() const override { return m_Name; }
+  size_t GetMemoryBytes() const override;
+
+ private:
+  bool apply(Scene& scene, bool forward);
+
+  const char* m_Name;
+  uint32_t m_ObjectId;
+  TopologyDelta m_Delta;
+  bool m_WasPristine;
+};
+
+/**
+ * @brief Values of the properties one edit changed, before and after, in
+ * the form PropertySet::Serialize writes them.
+ */
+class PropertyCommand : public ICommand {
+ public:
+  PropertyCommand(uint32_t objectId, nlohmann::json before,
+                  nlohmann::json after);
+
+  /**
+   * @brief The command for going from `before` to `after`, both full
+   * PropertySet::Serialize outputs, or null if nothing changed.
+   */
+  static std::unique_ptr<PropertyCommand> FromSnapshots(
+      uint32_t objectId, const nlohmann::json& before,
+      const nlohmann::json& after);
+
+  bool Undo(Scene& scene) override;
+  bool Redo(Scene& scene) override;
+  const char* GetName() const override { return "Edit Properties"; }
+  size_t GetMemoryBytes() const override;
+
+ private:
+  bool apply(Scene& scene, const nlohmann::json& values);
+
+  uint32_t m_ObjectId;
+  nlohmann::json m_Before;
+  nlohmann::json m_After;
+  size_t m_MemoryBytes;
+};
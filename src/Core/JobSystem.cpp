@@ -0,0 +1,123 @@
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "Core/Profiler.h"
+
+struct JobSystem::Batch {
+  const RangeFunction* body = nullptr;
+  size_t count = 0;
+  size_t chunkSize = 0;
+  size_t chunkCount = 0;
+  std::atomic<size_t> nextChunk{0};
+  std::atomic<size_t> chunksRemaining{0};
+  std::mutex doneMutex;
+  std::condition_variable done;
+};
+
+JobSystem& JobSystem::Get() {
+  static JobSystem s_Instance(
+      std::max(1u, std::thread::hardware_concurrency()) - 1);
+  return s_Instance;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+  m_Workers.reserve(workerCount);
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    m_Workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_WorkAvailable.notify_all();
+  for (auto& worker : m_Workers) {
+    worker.join();
+  }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minChunkSize,
+                            const RangeFunction& body) {
+  if (count == 0) return;
+  minChunkSize = std::max<size_t>(minChunkSize, 1);
+
+  if (m_Workers.empty() || count <= minChunkSize) {
+    body(0, count);
+    return;
+  }
+
+  // A few chunks per thread keeps everyone busy when chunks are uneven.
+  const size_t targetChunks = static_cast<size_t>(GetThreadCount()) * 4;
+  const size_t chunkSize =
+      std::max(minChunkSize, (count + targetChunks - 1) / targetChunks);
+
+  auto batch = std::make_shared<Batch>();
+  batch->body = &body;
+  batch->count = count;
+  batch->chunkSize = chunkSize;
+  batch->chunkCount = (count + chunkSize - 1) / chunkSize;
+  batch->chunksRemaining = batch->chunkCount;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Batches.push_back(batch);
+  }
+  m_WorkAvailable.notify_all();
+
+  runChunks(*batch);
+
+  {
+    std::unique_lock<std::mutex> lock(batch->doneMutex);
+    batch->done.wait(lock,
+                     [&] { return batch->chunksRemaining.load() == 0; });
+  }
+
+  // Workers may not have woken up before the caller finished everything.
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = std::find(m_Batches.begin(), m_Batches.end(), batch);
+  if (it != m_Batches.end()) m_Batches.erase(it);
+}
+
+void JobSystem::runChunks(Batch& batch) {
+  PROFILE_SCOPE("ParallelFor");
+  for (;;) {
+    size_t chunk = batch.nextChunk.fetch_add(1);
+    if (chunk >= batch.chunkCount) return;
+
+    size_t begin = chunk * batch.chunkSize;
+    size_t end = std::min(begin + batch.chunkSize, batch.count);
+    (*batch.body)(begin, end);
+
+    if (batch.chunksRemaining.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(batch.doneMutex);
+      batch.done.notify_all();
+    }
+  }
+}
+
+void JobSystem::workerLoop(unsigned int index) {
+  Profiler::Get().SetThreadName("Worker " + std::to_string(index));
+  for (;;) {
+    std::shared_ptr<Batch> batch;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WorkAvailable.wait(lock,
+                           [this] { return m_Stopping || !m_Batches.empty(); });
+      if (m_Stopping && m_Batches.empty()) return;
+      batch = m_Batches.front();
+    }
+
+    runChunks(*batch);
+
+    // Every chunk has been claimed, so retire the batch if nobody else has.
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_Batches.empty() && m_Batches.front() == batch) {
+      m_Batches.pop_front();
+    }
+  }
+}
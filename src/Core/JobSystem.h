@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Small fixed-size worker pool for data-parallel loops.
+ *
+ * ParallelFor splits a range into chunks that the workers and the calling
+ * thread claim from a shared counter, then blocks until every chunk is done.
+ * Because the caller always helps, nested ParallelFor calls cannot deadlock.
+ */
+class JobSystem {
+ public:
+  using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+  /** @brief The process-wide pool, sized to the hardware thread count. */
+  static JobSystem& Get();
+
+  explicit JobSystem(unsigned int workerCount);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  /**
+   * @brief Runs body over [0, count) in chunks of at least minChunkSize.
+   * Small ranges run inline on the calling thread.
+   */
+  void ParallelFor(size_t count, size_t minChunkSize, const RangeFunction& body);
+
+  /** @brief Number of threads that can run chunks, including the caller. */
+  unsigned int GetThreadCount() const {
+    return static_cast<unsigned int>(m_Workers.size()) + 1;
+  }
+
+ private:
+  struct Batch;
+
+  void workerLoop(unsigned int index);
+  static void runChunks(Batch& batch);
+
+  std::vector<std::thread> m_Workers;
+  std::deque<std::shared_ptr<Batch>> m_Batches;
+  std::mutex m_Mutex;
+  std::condition_variable m_WorkAvailable;
+  bool m_Stopping = false;
+};
@@ -0,0 +1,113 @@
+#include "Core/MappedFile.h"
+
+#include <utility>
+
+#include "Core/Log.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    m_Data = std::exchange(other.m_Data, nullptr);
+    m_Size = std::exchange(other.m_Size, 0);
+#ifdef _WIN32
+    m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+    m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filepath) {
+  Close();
+  HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    Log::Debug("MappedFile: Could not open ", filepath);
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    Log::Debug("MappedFile: Empty or unreadable file ", filepath);
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void* view =
+      mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view) {
+    Log::Debug("MappedFile: Could not map ", filepath);
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Data = static_cast<const std::byte*>(view);
+  m_Size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_Data) UnmapViewOfFile(m_Data);
+  if (m_MappingHandle) CloseHandle(m_MappingHandle);
+  if (m_FileHandle) CloseHandle(m_FileHandle);
+  m_Data = nullptr;
+  m_Size = 0;
+  m_FileHandle = nullptr;
+  m_MappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filepath) {
+  Close();
+  int fd = ::open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    Log::Debug("MappedFile: Could not open ", filepath);
+    return false;
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+    Log::Debug("MappedFile: Empty or unreadable file ", filepath);
+    ::close(fd);
+    return false;
+  }
+  void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                      MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    Log::Debug("MappedFile: Could not map ", filepath);
+    return false;
+  }
+  m_Data = static_cast<const std::byte*>(view);
+  m_Size = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_Data) ::munmap(const_cast<std::byte*>(m_Data), m_Size);
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+#endif
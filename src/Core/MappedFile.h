@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The pages are loaded by the OS on first touch, so opening a large file is
+ * cheap and only the parts that are actually read cost I/O. The mapping is
+ * released when the object is destroyed or Close() is called.
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /** @brief Maps the file, replacing any previous mapping. */
+  bool Open(const std::string& filepath);
+  void Close();
+
+  bool IsOpen() const { return m_Data != nullptr; }
+  const std::byte* GetData() const { return m_Data; }
+  size_t GetSize() const { return m_Size; }
+
+ private:
+  const std::byte* m_Data = nullptr;
+  size_t m_Size = 0;
+#ifdef _WIN32
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,335 @@
+#include "Core/ObjLoader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+#include "Core/MappedFile.h"
+
+namespace {
+// Chunks smaller than this are not worth handing to another thread.
+constexpr size_t kMinChunkBytes = 1 << 20;
+constexpr uint32_t kMissing = std::numeric_limits<uint32_t>::max();
+
+enum Attribute { kPosition = 0, kTexcoord = 1, kNormal = 2 };
+
+// One face corner as written in the file. Negative (relative) indices are
+// stored against the chunk's own element counts and fixed up once every
+// chunk's starting counts are known.
+struct RawCorner {
+  int32_t index[3];
+  uint8_t present = 0;   // Bit per attribute
+  uint8_t relative = 0;  // Bit per attribute
+};
+
+struct ChunkResult {
+  std::vector<float> positions;
+  uint32_t counts[3] = {0, 0, 0};
+  std::vector<RawCorner> corners;  // Three per triangle
+  size_t skippedFaces = 0;         // Faces with an unreadable corner
+};
+
+struct CornerKey {
+  uint32_t v, vt, vn;
+  bool operator==(const CornerKey&) const = default;
+};
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* skipSpaces(const char* p, const char* end) {
+  while (p < end && isSpace(*p)) ++p;
+  return p;
+}
+
+const char* parseFloat(const char* p, const char* end, float& out) {
+  p = skipSpaces(p, end);
+  // from_chars rejects a leading '+', which some exporters write.
+  if (p < end && *p == '+') ++p;
+  auto [next, ec] = std::from_chars(p, end, out);
+  if (ec != std::errc()) out = 0.0f;
+  return next;
+}
+
+const char* skipToken(const char* p, const char* end) {
+  while (p < end && !isSpace(*p)) ++p;
+  return p;
+}
+
+// Parses one "v", "v/vt", "v//vn" or "v/vt/vn" token and returns its end.
+// An empty, zero or malformed vt or vn is left out of the corner; ok is
+// false if the position is.
+const char* parseCorner(const char* p, const char* end,
+                        const uint32_t counts[3], RawCorner& corner,
+                        bool& ok) {
+  ok = false;
+  for (int a = 0; a < 3; ++a) {
+    if (a > 0) {
+      if (p >= end || *p != '/') break;
+      ++p;
+    }
+    const char* fieldEnd = p;
+    while (fieldEnd < end && *fieldEnd != '/' && !isSpace(*fieldEnd)) {
+      ++fieldEnd;
+    }
+    int32_t value = 0;
+    auto [next, ec] = std::from_chars(p, fieldEnd, value);
+    const bool valid = ec == std::errc() && next == fieldEnd && value != 0;
+    p = fieldEnd;
+    if (!valid) {
+      if (a == kPosition) return skipToken(p, end);
+      continue;
+    }
+    corner.present |= 1 << a;
+    if (value > 0) {
+      corner.index[a] = value - 1;
+    } else {
+      corner.index[a] = static_cast<int32_t>(counts[a]) + value;
+      corner.relative |= 1 << a;
+    }
+  }
+  ok = (corner.present & (1 << kPosition)) != 0;
+  return p;
+}
+
+void parseChunk(const char* p, const char* end, ChunkResult& result) {
+  std::vector<RawCorner> polygon;
+  while (p < end) {
+    const char* lineEnd = std::find(p, end, '\n');
+    p = skipSpaces(p, lineEnd);
+
+    if (lineEnd - p >= 2 && p[0] == 'v' && isSpace(p[1])) {
+      float xyz[3];
+      const char* q = p + 2;
+      for (float& f : xyz) q = parseFloat(q, lineEnd, f);
+      result.positions.insert(result.positions.end(), xyz, xyz + 3);
+      result.counts[kPosition]++;
+    } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' &&
+               isSpace(p[2])) {
+      result.counts[kTexcoord]++;
+    } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' &&
+               isSpace(p[2])) {
+      result.counts[kNormal]++;
+    } else if (lineEnd - p >= 2 && p[0] == 'f' && isSpace(p[1])) {
+      polygon.clear();
+      const char* q = skipSpaces(p + 2, lineEnd);
+      while (q < lineEnd && *q != '#') {
+        RawCorner corner{};
+        bool ok = false;
+        q = parseCorner(q, lineEnd, result.counts, corner, ok);
+        if (!ok) {
+          // Dropping one corner would change the shape of the polygon.
+          polygon.clear();
+          ++result.skippedFaces;
+          break;
+        }
+        polygon.push_back(corner);
+        q = skipSpaces(q, lineEnd);
+      }
+      for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+        result.corners.push_back(polygon[0]);
+        result.corners.push_back(polygon[i]);
+        result.corners.push_back(polygon[i + 1]);
+      }
+    }
+    p = lineEnd < end ? lineEnd + 1 : end;
+  }
+}
+
+uint32_t hashCorner(const CornerKey& key) {
+  uint32_t h = key.v * 0x9E3779B1u;
+  h ^= key.vt * 0x85EBCA77u + (h << 6) + (h >> 2);
+  h ^= key.vn * 0xC2B2AE3Du + (h << 6) + (h >> 2);
+  h ^= h >> 16;
+  return h * 0x7FEB352Du;
+}
+
+// Absolute indices of a corner whose chunk starts after `base` elements of
+// each attribute.
+CornerKey resolveCorner(const RawCorner& raw, const uint32_t base[3]) {
+  uint32_t resolved[3];
+  for (int a = 0; a < 3; ++a) {
+    if (!(raw.present & (1 << a))) {
+      resolved[a] = kMissing;
+      continue;
+    }
+    int64_t value = raw.index[a];
+    if (raw.relative & (1 << a)) value += base[a];
+    resolved[a] = value < 0 ? kMissing : static_cast<uint32_t>(value);
+  }
+  return {resolved[kPosition], resolved[kTexcoord], resolved[kNormal]};
+}
+
+// Linear-probing map from corner triplet to output vertex index. Corners are
+// never removed, so the table needs no tombstones. It grows by doubling to
+// keep the load at or below 3/4.
+class CornerTable {
+ public:
+  explicit CornerTable(size_t expectedKeys) {
+    size_t capacity = 16;
+    while (capacity * 3 < expectedKeys * 4) capacity *= 2;
+    rehash(capacity);
+  }
+
+  // Returns the existing value for key, or stores and returns newValue.
+  uint32_t FindOrInsert(const CornerKey& key, uint32_t newValue) {
+    size_t slot = findSlot(key);
+    if (m_Values[slot] != kMissing) return m_Values[slot];
+    if ((m_Size + 1) * 4 > m_Values.size() * 3) {
+      rehash(m_Values.size() * 2);
+      slot = findSlot(key);
+    }
+    m_Keys[slot] = key;
+    m_Values[slot] = newValue;
+    ++m_Size;
+    return newValue;
+  }
+
+ private:
+  // The slot holding key, or the empty slot where it belongs.
+  size_t findSlot(const CornerKey& key) const {
+    size_t slot = hashCorner(key) & m_Mask;
+    while (m_Values[slot] != kMissing && !(m_Keys[slot] == key)) {
+      slot = (slot + 1) & m_Mask;
+    }
+    return slot;
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<CornerKey> keys(capacity);
+    std::vector<uint32_t> values(capacity, kMissing);
+    m_Keys.swap(keys);
+    m_Values.swap(values);
+    m_Mask = capacity - 1;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (values[i] == kMissing) continue;
+      size_t slot = findSlot(keys[i]);
+      m_Keys[slot] = keys[i];
+      m_Values[slot] = values[i];
+    }
+  }
+
+  size_t m_Mask = 0;
+  size_t m_Size = 0;
+  std::vector<CornerKey> m_Keys;
+  std::vector<uint32_t> m_Values;
+};
+
+}  // namespace
+
+namespace ObjLoader {
+
+bool Load(const std::string& filepath, std::vector<float>& outVertices,
+          std::vector<unsigned int>& outIndices) {
+  outVertices.clear();
+  outIndices.clear();
+  MappedFile file;
+  if (!file.Open(filepath)) return false;
+  const char* text = reinterpret_cast<const char*>(file.GetData());
+  if (!Parse(std::string_view(text, file.GetSize()), outVertices,
+             outIndices)) {
+    Log::Debug("ObjLoader: No valid faces in ", filepath);
+    return false;
+  }
+  return true;
+}
+
+bool Parse(std::string_view text, std::vector<float>& outVertices,
+           std::vector<unsigned int>& outIndices) {
+  outVertices.clear();
+  outIndices.clear();
+
+  // Split at line boundaries into roughly equal chunks.
+  auto& jobs = JobSystem::Get();
+  const size_t chunkCount = std::clamp<size_t>(
+      text.size() / kMinChunkBytes, 1, jobs.GetThreadCount());
+  std::vector<size_t> bounds = {0};
+  for (size_t c = 1; c < chunkCount; ++c) {
+    size_t cut = std::max(bounds.back(), text.size() * c / chunkCount);
+    cut = text.find('\n', cut);
+    if (cut == std::string_view::npos) break;
+    bounds.push_back(cut + 1);
+  }
+  bounds.push_back(text.size());
+
+  std::vector<ChunkResult> chunks(bounds.size() - 1);
+  jobs.ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+    for (size_t c = begin; c < end; ++c) {
+      parseChunk(text.data() + bounds[c], text.data() + bounds[c + 1],
+                 chunks[c]);
+    }
+  });
+
+  // Concatenate positions first; faces may refer to any of them.
+  size_t cornerCount = 0;
+  size_t skippedFaces = 0;
+  uint32_t positionCount = 0;
+  for (const ChunkResult& chunk : chunks) {
+    cornerCount += chunk.corners.size();
+    skippedFaces += chunk.skippedFaces;
+    positionCount += chunk.counts[kPosition];
+  }
+  std::vector<float> positions;
+  positions.reserve(static_cast<size_t>(positionCount) * 3);
+  for (ChunkResult& chunk : chunks) {
+    positions.insert(positions.end(), chunk.positions.begin(),
+                     chunk.positions.end());
+    std::vector<float>().swap(chunk.positions);
+  }
+
+  // Deduplicate straight from the chunks in file order, so output vertices
+  // appear in first-use order and each chunk's corners are freed once done.
+  // Most corners share their triplet with others; the table starts at about
+  // one entry per position and grows only for vertices split by vt or vn.
+  CornerTable table(positionCount);
+  outVertices.reserve(static_cast<size_t>(positionCount) * 3);
+  outIndices.reserve(cornerCount);
+  uint32_t totals[3] = {0, 0, 0};
+  size_t skippedTriangles = 0;
+  for (ChunkResult& chunk : chunks) {
+    const std::vector<RawCorner>& corners = chunk.corners;
+    for (size_t t = 0; t + 2 < corners.size(); t += 3) {
+      CornerKey keys[3];
+      bool inRange = true;
+      for (int k = 0; k < 3; ++k) {
+        keys[k] = resolveCorner(corners[t + k], totals);
+        inRange = inRange && keys[k].v < positionCount;
+      }
+      if (!inRange) {
+        ++skippedTriangles;
+        continue;
+      }
+      for (const CornerKey& key : keys) {
+        uint32_t next = static_cast<uint32_t>(outVertices.size() / 3);
+        uint32_t index = table.FindOrInsert(key, next);
+        if (index == next) {
+          const float* p = &positions[static_cast<size_t>(key.v) * 3];
+          outVertices.insert(outVertices.end(), p, p + 3);
+        }
+        outIndices.push_back(index);
+      }
+    }
+    std::vector<RawCorner>().swap(chunk.corners);
+    for (int a = 0; a < 3; ++a) totals[a] += chunk.counts[a];
+  }
+  chunks.clear();
+
+  if (skippedFaces > 0) {
+    Log::Debug("ObjLoader: Skipped ", skippedFaces,
+               " faces with malformed position indices");
+  }
+  if (skippedTriangles > 0) {
+    Log::Debug("ObjLoader: Skipped ", skippedTriangles,
+               " triangles with out-of-range position indices");
+  }
+
+  if (outIndices.empty()) {
+    outVertices.clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace ObjLoader
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Streaming Wavefront OBJ reader for positions and triangles.
+ *
+ * The file is memory-mapped and split into line-aligned chunks that are
+ * parsed in parallel. Face corners are then deduplicated by their full
+ * v/vt/vn triplet in one ordered pass, so a vertex that is shared with
+ * different normals or UVs is still split, exactly as the renderer expects.
+ * Polygons are fan-triangulated. Only v, vt, vn and f records are read.
+ * A face with an unreadable position index is skipped whole; unreadable
+ * vt or vn indices are ignored.
+ */
+namespace ObjLoader {
+
+/**
+ * @brief Loads a mesh as flat xyz positions plus triangle indices.
+ * @return False (with both outputs empty) if the file cannot be read or
+ * contains no valid faces.
+ */
+bool Load(const std::string& filepath, std::vector<float>& outVertices,
+          std::vector<unsigned int>& outIndices);
+
+/** @brief Same as Load, for OBJ text that is already in memory. */
+bool Parse(std::string_view text, std::vector<float>& outVertices,
+           std::vector<unsigned int>& outIndices);
+
+}  // namespace ObjLoader
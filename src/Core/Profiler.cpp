@@ -0,0 +1,178 @@
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "Core/Log.h"
+
+// Single-producer, single-consumer ring: only the owning thread advances
+// head, only the main thread (in EndFrame) advances tail.
+struct Profiler::ThreadBuffer {
+  std::unique_ptr<ZoneRecord[]> zones{new ZoneRecord[kRingCapacity]};
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> tail{0};
+  uint32_t track = 0;
+  uint16_t depth = 0;  // Owner thread only
+};
+
+thread_local Profiler::ThreadBuffer* Profiler::s_ThreadBuffer = nullptr;
+
+Profiler::Zone::Zone(const char* name) : m_Name(name) {
+  ++Get().threadBuffer().depth;
+  m_StartNs = NowNs();
+}
+
+Profiler::Zone::~Zone() {
+  uint64_t endNs = NowNs();
+  Profiler& profiler = Get();
+  ThreadBuffer& buffer = profiler.threadBuffer();
+  --buffer.depth;
+
+  uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  if (head - buffer.tail.load(std::memory_order_acquire) >= kRingCapacity) {
+    profiler.m_DroppedZones.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.zones[head % kRingCapacity] = {m_Name, m_StartNs, endNs, buffer.track,
+                                        buffer.depth};
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+Profiler& Profiler::Get() {
+  static Profiler s_Instance;
+  return s_Instance;
+}
+
+Profiler::Profiler() { m_GpuTrack = registerTrack("GPU"); }
+
+Profiler::~Profiler() = default;
+
+uint64_t Profiler::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+  if (!s_ThreadBuffer) {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(m_TracksMutex);
+    buffer->track = static_cast<uint32_t>(m_TrackNames.size());
+    m_TrackNames.push_back("Thread " + std::to_string(buffer->track));
+    s_ThreadBuffer = buffer.get();
+    m_Buffers.push_back(std::move(buffer));
+  }
+  return *s_ThreadBuffer;
+}
+
+uint32_t Profiler::registerTrack(const std::string& name) {
+  std::lock_guard<std::mutex> lock(m_TracksMutex);
+  m_TrackNames.push_back(name);
+  return static_cast<uint32_t>(m_TrackNames.size() - 1);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+  uint32_t track = threadBuffer().track;
+  std::lock_guard<std::mutex> lock(m_TracksMutex);
+  m_TrackNames[track] = name;
+}
+
+std::string Profiler::GetTrackName(uint32_t track) const {
+  std::lock_guard<std::mutex> lock(m_TracksMutex);
+  return track < m_TrackNames.size() ? m_TrackNames[track] : std::string();
+}
+
+void Profiler::drainBuffers(std::vector<ZoneRecord>& out) {
+  std::lock_guard<std::mutex> lock(m_TracksMutex);
+  for (auto& buffer : m_Buffers) {
+    uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; ++i) {
+      out.push_back(buffer->zones[i % kRingCapacity]);
+    }
+    buffer->tail.store(head, std::memory_order_release);
+  }
+}
+
+void Profiler::BeginFrame() {
+  m_MainTrack = threadBuffer().track;
+  m_FrameStartNs = NowNs();
+}
+
+void Profiler::EndFrame() {
+  FrameRecord frame;
+  frame.index = m_FrameIndex++;
+  frame.startNs = m_FrameStartNs;
+  frame.endNs = NowNs();
+  drainBuffers(frame.zones);
+
+  if (m_Recording) {
+    m_Trace.insert(m_Trace.end(), frame.zones.begin(), frame.zones.end());
+    m_Trace.push_back({"Frame", frame.startNs, frame.endNs, m_MainTrack, 0});
+  }
+
+  if (m_Paused) return;
+  m_Frames.push_back(std::move(frame));
+  if (m_Frames.size() > kHistoryFrames) m_Frames.pop_front();
+}
+
+void Profiler::SubmitGpuZone(uint64_t frameIndex, const char* name,
+                             uint64_t startNs, uint64_t endNs, uint16_t depth) {
+  ZoneRecord zone{name, startNs, endNs, m_GpuTrack, depth};
+  if (m_Recording) m_Trace.push_back(zone);
+
+  // Same as CPU zones: a paused view keeps the history it had.
+  if (m_Paused || m_Frames.empty() || frameIndex < m_Frames.front().index) return;
+  size_t offset = static_cast<size_t>(frameIndex - m_Frames.front().index);
+  if (offset < m_Frames.size() && m_Frames[offset].index == frameIndex) {
+    m_Frames[offset].zones.push_back(zone);
+  }
+}
+
+void Profiler::StartRecording() {
+  m_Trace.clear();
+  m_Recording = true;
+}
+
+bool Profiler::StopRecording(const std::string& filepath) {
+  m_Recording = false;
+
+  uint64_t originNs = ~0ull;
+  for (const auto& zone : m_Trace) originNs = std::min(originNs, zone.startNs);
+
+  // Chrome trace event format: complete ("X") events in microseconds, plus
+  // metadata events naming each track.
+  nlohmann::json events = nlohmann::json::array();
+  {
+    std::lock_guard<std::mutex> lock(m_TracksMutex);
+    for (size_t track = 0; track < m_TrackNames.size(); ++track) {
+      events.push_back({{"name", "thread_name"},
+                        {"ph", "M"},
+                        {"pid", 1},
+                        {"tid", track},
+                        {"args", {{"name", m_TrackNames[track]}}}});
+    }
+  }
+  for (const auto& zone : m_Trace) {
+    events.push_back({{"name", zone.name},
+                      {"cat", zone.track == m_GpuTrack ? "gpu" : "cpu"},
+                      {"ph", "X"},
+                      {"ts", (zone.startNs - originNs) / 1000.0},
+                      {"dur", (zone.endNs - zone.startNs) / 1000.0},
+                      {"pid", 1},
+                      {"tid", zone.track}});
+  }
+  m_Trace.clear();
+  m_Trace.shrink_to_fit();
+
+  std::ofstream file(filepath);
+  if (!file.is_open()) {
+    Log::Debug("Profiler: could not open trace file ", filepath);
+    return false;
+  }
+  file << nlohmann::json{{"traceEvents", std::move(events)},
+                         {"displayTimeUnit", "ms"}};
+  return file.good();
+}
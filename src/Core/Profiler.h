@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+// Times the enclosing scope as a zone called name. The name must be a string
+// literal (or otherwise outlive the profiler), since only the pointer is kept.
+#define PROFILE_SCOPE(name) \
+  Profiler::Zone PROFILER_CONCAT(profilerZone_, __LINE__)(name)
+
+/**
+ * @brief Frame-based CPU/GPU profiler.
+ *
+ * Zones are recorded into a per-thread ring buffer with no locking; the main
+ * thread drains every buffer once per frame in EndFrame. The last
+ * kHistoryFrames frames are kept for the profiler view, and everything can
+ * additionally be recorded to a Chrome trace (chrome://tracing, Perfetto).
+ */
+class Profiler {
+ public:
+  static constexpr size_t kHistoryFrames = 300;
+  static constexpr size_t kRingCapacity = 1 << 14;  // Zones per thread
+
+  struct ZoneRecord {
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    uint32_t track = 0;  // A thread, or the GPU
+    uint16_t depth = 0;  // Nesting level within the track
+  };
+
+  struct FrameRecord {
+    uint64_t index = 0;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    std::vector<ZoneRecord> zones;
+  };
+
+  /** @brief RAII zone; see PROFILE_SCOPE. */
+  class Zone {
+   public:
+    explicit Zone(const char* name);
+    ~Zone();
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+   private:
+    const char* m_Name;
+    uint64_t m_StartNs;
+  };
+
+  static Profiler& Get();
+
+  /** @brief Monotonic clock shared by every zone, in nanoseconds. */
+  static uint64_t NowNs();
+
+  // --- Frame Lifecycle (main thread) ---
+  void BeginFrame();
+  void EndFrame();
+  uint64_t GetFrameIndex() const { return m_FrameIndex; }
+
+  /** @brief Names the calling thread's track in the view and traces. */
+  void SetThreadName(const std::string& name);
+
+  /**
+   * @brief Adds a GPU zone, converted to the CPU clock. GPU results arrive a
+   * few frames late, so they are attached to the frame that issued them if
+   * it is still in the history. Main thread only.
+   */
+  void SubmitGpuZone(uint64_t frameIndex, const char* name, uint64_t startNs,
+                     uint64_t endNs, uint16_t depth);
+
+  /** @brief Stops collecting history; the ring buffers are still drained. */
+  void SetPaused(bool paused) { m_Paused = paused; }
+  bool IsPaused() const { return m_Paused; }
+
+  const std::deque<FrameRecord>& GetFrames() const { return m_Frames; }
+  std::string GetTrackName(uint32_t track) const;
+  uint32_t GetMainTrack() const { return m_MainTrack; }
+  uint32_t GetGpuTrack() const { return m_GpuTrack; }
+
+  // --- Chrome Trace Recording ---
+  void StartRecording();
+  /** @brief Writes everything recorded since StartRecording; false on I/O
+   * failure. */
+  bool StopRecording(const std::string& filepath);
+  bool IsRecording() const { return m_Recording; }
+
+  /** @brief Zones dropped because a ring buffer was full. */
+  uint64_t GetDroppedZoneCount() const { return m_DroppedZones; }
+
+ private:
+  struct ThreadBuffer;
+
+  Profiler();
+  ~Profiler();
+
+  ThreadBuffer& threadBuffer();
+  uint32_t registerTrack(const std::string& name);
+  void drainBuffers(std::vector<ZoneRecord>& out);
+
+  // Registered buffers are never freed, so a thread's pointer stays valid.
+  static thread_local ThreadBuffer* s_ThreadBuffer;
+  mutable std::mutex m_TracksMutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+  std::vector<std::string> m_TrackNames;
+  uint32_t m_GpuTrack = 0;
+  uint32_t m_MainTrack = 0;
+
+  uint64_t m_FrameIndex = 0;
+  uint64_t m_FrameStartNs = 0;
+  std::deque<FrameRecord> m_Frames;
+  bool m_Paused = false;
+
+  bool m_Recording = false;
+  std::vector<ZoneRecord> m_Trace;
+  std::atomic<uint64_t> m_DroppedZones{0};
+};
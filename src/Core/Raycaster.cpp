@@ -3,10 +3,10 @@
 #include <glm/gtc/matrix_inverse.hpp>
 
 #include "Interfaces/IEditableMesh.h"
+#include "Sculpting/MeshBVH.h"
 
 namespace Raycaster {
 
-// Internal helper for Möller–Trumbore ray-triangle intersection
 bool IntersectTriangle(const glm::vec3& rayOrigin,
                        const glm::vec3& rayDirection, const glm::vec3& v0,
                        const glm::vec3& v1, const glm::vec3& v2,
@@ -47,26 +47,18 @@ bool IntersectMesh(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
   glm::vec3 rayDirectionLocal =
       glm::normalize(glm::vec3(invModelMatrix * glm::vec4(rayDirection, 0.0f)));
 
-  bool foundHit = false;
   outResult.distance = std::numeric_limits<float>::max();
 
-  const auto& vertices = mesh.GetVertices();
-  const auto& indices = mesh.GetIndices();
-
-  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-    const glm::vec3& v0 = vertices[indices[i]];
-    const glm::vec3& v1 = vertices[indices[i + 1]];
-    const glm::vec3& v2 = vertices[indices[i + 2]];
-
-    float t = 0.0f;
-    if (IntersectTriangle(rayOriginLocal, rayDirectionLocal, v0, v1, v2, t)) {
-      if (t < outResult.distance) {
-        foundHit = true;
-        outResult.distance = t;
-        outResult.hitPoint = rayOriginLocal + rayDirectionLocal * t;
-        outResult.triangleIndex = i / 3;  // Set the triangle index
-      }
-    }
+  float t = 0.0f;
+  int triangleIndex = -1;
+  bool foundHit = mesh.GetBVH().Intersect(
+      rayOriginLocal, rayDirectionLocal, mesh.GetVertices(), mesh.GetIndices(),
+      t, triangleIndex);
+
+  if (foundHit) {
+    outResult.distance = t;
+    outResult.hitPoint = rayOriginLocal + rayDirectionLocal * t;
+    outResult.triangleIndex = triangleIndex;
   }
 
   outResult.hit = foundHit;
@@ -15,6 +15,16 @@ struct RaycastResult {
   int triangleIndex = -1;
 };
 
+/**
+ * @brief Möller–Trumbore ray-triangle intersection.
+ * @param outDistance Distance along the ray to the hit, if any.
+ * @return True if the ray hits the triangle in front of its origin.
+ */
+bool IntersectTriangle(const glm::vec3& rayOrigin,
+                       const glm::vec3& rayDirection, const glm::vec3& v0,
+                       const glm::vec3& v1, const glm::vec3& v2,
+                       float& outDistance);
+
 /**
  * @brief Performs a ray-mesh intersection test.
  * * @param rayOrigin The starting point of the ray in world space.
@@ -22,6 +32,7 @@ struct RaycastResult {
  * @param mesh The mesh to test against.
  * @param modelMatrix The transformation matrix of the mesh.
  * @param outResult The result of the raycast if a hit occurs.
+ * Uses the mesh's BVH, so the cost is roughly logarithmic in triangle count.
  * @return True if the ray intersects the mesh, false otherwise.
  */
 bool IntersectMesh(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
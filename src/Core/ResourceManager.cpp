@@ -2,11 +2,8 @@
 #include <glm/glm.hpp>
 #include <unordered_map>
 #include "Core/Log.h"
+#include "Core/ObjLoader.h"
 #include "Shader.h"
-#define TINYOBJLOADER_IMPLEMENTATION
-#include "tiny_obj_loader.h"
-
-#include <functional> // For std::hash
 
 
 // Initialize static variables
@@ -64,39 +61,11 @@ std::shared_ptr<Shader> ResourceManager::GetShader(const std::string& name) {
 
 std::pair<std::vector<float>, std::vector<unsigned int>>
 ResourceManager::LoadMesh(const std::string& filepath) {
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string warn, err;
-
-  if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-                        filepath.c_str())) {
-    Log::Debug("Failed to load/parse .obj file: ", filepath);
-    Log::Debug("Warn: ", warn);
-    Log::Debug("Err: ", err);
-    return {};
-  }
-
   std::vector<float> vertices;
   std::vector<unsigned int> indices;
-  // CORRECTED: Use a map to track unique vertices based on their full index triplet
-  std::unordered_map<tinyobj::index_t, uint32_t> uniqueVertices{};
-
-  for (const auto& shape : shapes) {
-    for (const auto& index : shape.mesh.indices) {
-      if (uniqueVertices.count(index) == 0) {
-        // This is a new, unique vertex
-        uniqueVertices[index] = static_cast<uint32_t>(vertices.size() / 3);
-        
-        // Position
-        vertices.push_back(attrib.vertices[3 * index.vertex_index + 0]);
-        vertices.push_back(attrib.vertices[3 * index.vertex_index + 1]);
-        vertices.push_back(attrib.vertices[3 * index.vertex_index + 2]);
-        
-        // We could also add normals and texcoords here if our vertex format supported it
-      }
-      indices.push_back(uniqueVertices[index]);
-    }
+  if (!ObjLoader::Load(filepath, vertices, indices)) {
+    Log::Debug("Failed to load/parse .obj file: ", filepath);
+    return {};
   }
-  return {vertices, indices};
+  return {std::move(vertices), std::move(indices)};
 }
@@ -26,6 +26,10 @@ SettingsManager::Registrar::Registrar() {
        &s_Settings.gridDivisions},
       {"cameraSpeed", "Camera Speed", SettingType::Float,
        &s_Settings.cameraSpeed},
+      {"asyncPicking", "Async Picking", SettingType::Bool,
+       &s_Settings.asyncPicking},
+      {"undoMemoryMB", "Undo Memory (MB)", SettingType::Int,
+       &s_Settings.undoMemoryMB},
       {"vertexHighlightColor", "Vertex Highlight", SettingType::Color4,
        &s_Settings.vertexHighlightColor},
       {"edgeHighlightColor", "Edge Highlight", SettingType::Color4,
@@ -70,6 +74,9 @@ bool SettingsManager::Load(const std::string& path) {
           case SettingType::Color4:
             *static_cast<glm::vec4*>(desc.ptr) = jsonValue.get<glm::vec4>();
             break;
+          case SettingType::Bool:
+            *static_cast<bool*>(desc.ptr) = jsonValue.get<bool>();
+            break;
         }
       }
     }
@@ -98,6 +105,9 @@ bool SettingsManager::Save(const std::string& path) {
       case SettingType::Color4:
         j[desc.key] = *static_cast<const glm::vec4*>(desc.ptr);
         break;
+      case SettingType::Bool:
+        j[desc.key] = *static_cast<const bool*>(desc.ptr);
+        break;
     }
   }
 
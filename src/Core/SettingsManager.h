@@ -6,7 +6,7 @@
 #include <vector>
 
 /** Supported UI widget types for auto-generation. */
-enum class SettingType { Float3, Float, Int, Color4 };
+enum class SettingType { Float3, Float, Int, Color4, Bool };
 
 /** Descriptor for one setting. */
 struct SettingDescriptor {
@@ -31,6 +31,12 @@ struct AppSettings {
   int gridDivisions = 80;
   float cameraSpeed = 5.0f;
 
+  // --- Viewport Settings ---
+  bool asyncPicking = true;
+
+  // --- History Settings ---
+  int undoMemoryMB = 256;
+
   // --- Selection Colors ---
   glm::vec4 vertexHighlightColor = {1.0f, 0.5f, 0.0f, 1.0f};
   glm::vec4 edgeHighlightColor = {1.0f, 0.5f, 0.0f, 1.0f};
@@ -9,6 +9,9 @@ struct BrushSettings {
   float strength = 1.0f;  // Increased default strength
   SculptMode::Mode mode = SculptMode::Pull;
   Curve falloff;  // The falloff profile of the brush
+  // Smooth brush: Taubin smoothing (a shrink pass, then an inflate pass) keeps
+  // the volume that plain Laplacian smoothing loses
+  bool preserveVolume = true;
 
   BrushSettings() {
     // Default to a smooth, linear falloff
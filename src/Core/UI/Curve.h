@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <glm/glm.hpp>
+#include <span>
 #include <vector>
 
 // A point on the curve editor
@@ -12,6 +15,12 @@ struct CurvePoint {
 // Represents a 1D curve defined by a series of points
 class Curve {
  public:
+  // Number of intervals in the baked table over [0, 1]
+  static constexpr int kBakeResolution = 256;
+  // One sample per interval end, plus a copy of the last sample so a lerp at
+  // x == 1 can read one slot past it
+  using BakedTable = std::array<float, kBakeResolution + 2>;
+
   // Adds a new control point and sorts them by their x-coordinate
   void AddPoint(const glm::vec2& pos) {
     m_Points.push_back({pos});
@@ -35,17 +44,45 @@ class Curve {
     return glm::mix(p1->pos.y, p2->pos.y, t);
   }
 
+  // Evaluates the baked table at x, clamped to [0, 1]: one lookup and one
+  // lerp, with no branches. NaN maps to 0.
+  float EvaluateBaked(float x) const {
+    float scaled = std::fmin(std::fmax(x, 0.0f), 1.0f) * kBakeResolution;
+    int slot = static_cast<int>(scaled);
+    float frac = scaled - static_cast<float>(slot);
+    float a = m_Baked[slot];
+    float b = m_Baked[slot + 1];
+    return a + (b - a) * frac;
+  }
+
+  // Evaluates the baked table for each x; out must be at least as long as xs
+  void EvaluateBaked(std::span<const float> xs, std::span<float> out) const {
+    for (size_t i = 0; i < xs.size(); ++i) out[i] = EvaluateBaked(xs[i]);
+  }
+
+  const BakedTable& GetBakedTable() const { return m_Baked; }
+
   std::vector<CurvePoint>& GetPoints() { return m_Points; }
+  const std::vector<CurvePoint>& GetPoints() const { return m_Points; }
 
-  // Sorts points by their x-coordinate. Must be called after manual
-  // modification.
+  // Sorts points by their x-coordinate and rebakes the lookup table. Must be
+  // called after manual modification.
   void SortPoints() {
     std::sort(m_Points.begin(), m_Points.end(),
               [](const CurvePoint& a, const CurvePoint& b) {
                 return a.pos.x < b.pos.x;
               });
+    bake();
   }
 
  private:
+  void bake() {
+    for (int i = 0; i <= kBakeResolution; ++i) {
+      m_Baked[i] = Evaluate(static_cast<float>(i) / kBakeResolution);
+    }
+    m_Baked[kBakeResolution + 1] = m_Baked[kBakeResolution];
+  }
+
   std::vector<CurvePoint> m_Points;
-};
\ No newline at end of file
+  BakedTable m_Baked{};
+};
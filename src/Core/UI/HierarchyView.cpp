@@ -1,5 +1,6 @@
 #include "Core/UI/HierarchyView.h"
 
+#include <algorithm>
 #include <imgui.h>
 #include <imgui_stdlib.h>
 
@@ -57,6 +58,17 @@ void HierarchyView::Draw() {
         // 1. Request duplication instead of doing it directly
         m_App->RequestObjectDuplication(oid);
       }
+      // Right-click for an array of copies.
+      if (ImGui::BeginPopupContextItem("dup_array")) {
+        ImGui::SetNextItemWidth(100);
+        ImGui::InputInt("Copies", &m_ArrayCount);
+        m_ArrayCount = std::clamp(m_ArrayCount, 1, 1000);
+        if (ImGui::Button("Duplicate Array")) {
+          m_App->RequestObjectDuplication(oid, m_ArrayCount);
+          ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+      }
 
       ImGui::TableNextColumn();
       if (ImGui::Button("Del")) {
@@ -22,4 +22,5 @@ class HierarchyView : public IView {
 
   uint32_t m_RenameID = 0;
   std::string m_RenameBuffer;
+  int m_ArrayCount = 5;
 };
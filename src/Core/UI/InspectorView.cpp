@@ -109,7 +109,7 @@ void InspectorView::DrawProperties(ISceneObject* sel) {
 }
 
 void InspectorView::DrawMeshEditingControls(ISceneObject* sel) {
-    if (!sel->GetEditableMesh()) {
+    if (!sel->GetMesh()) {
         return;
     }
 
@@ -128,6 +128,7 @@ void InspectorView::DrawMeshEditingControls(ISceneObject* sel) {
         if (currentEditorMode == EditorMode::SCULPT) {
             ImGui::SeparatorText("Sculpting Tools");
             DrawBrushSettings();
+            DrawMultiresSettings(sel);
         } else if (currentEditorMode == EditorMode::SUB_OBJECT) {
             ImGui::SeparatorText("Sub-Object Tools");
             DrawSubObjectSettings();
@@ -135,6 +136,22 @@ void InspectorView::DrawMeshEditingControls(ISceneObject* sel) {
     }
 }
 
+void InspectorView::DrawMultiresSettings(ISceneObject* sel) {
+    ImGui::SeparatorText("Multires");
+    int levels = sel->GetSubdivisionLevels();
+    int level = sel->GetSubdivisionLevel();
+    if (levels > 0) {
+        ImGui::PushItemWidth(-1);
+        if (ImGui::SliderInt("##SubdivisionLevel", &level, 0, levels, "Level %d")) m_App->SetSubdivisionLevel(level);
+        ImGui::PopItemWidth();
+    }
+    const IEditableMesh* mesh = sel->GetMesh();
+    ImGui::Text("Faces: %zu", mesh->GetIndices().size() / 3);
+    if (ImGui::Button("Subdivide")) m_App->AddSubdivisionLevel();
+    ImGui::SameLine();
+    if (UIElements::Button("Clear Levels", levels > 0)) sel->ClearSubdivisionLevels();
+}
+
 bool InspectorView::CanWeld() const {
     return m_App->GetSelection()->GetSelectedVertices().size() >= 2;
 }
@@ -170,6 +187,12 @@ void InspectorView::DrawSubObjectSettings() {
         ImGui::Text("Vertex Tools");
         if (UIElements::Button("Weld Vertices", CanWeld())) m_App->RequestWeld();
         if (!CanWeld()) ImGui::TextDisabled("Select >= 2 vertices to weld.");
+
+        // Shift-clicking vertices highlights the path between them.
+        bool pathByLength = m_App->GetSelection()->GetPathMetric() == PathMetric::EdgeLength;
+        if (ImGui::Checkbox("Shortest Path by Length", &pathByLength)) {
+            m_App->GetSelection()->SetPathMetric(pathByLength ? PathMetric::EdgeLength : PathMetric::EdgeCount);
+        }
     }
 
     if (currentSubObjectMode == SubObjectMode::EDGE) {
@@ -214,6 +237,9 @@ void InspectorView::DrawBrushSettings() {
   if (ImGui::DragFloat("Radius##Sculpt", &m_BrushSettings.radius, 0.01f, 0.01f, 5.0f)) settingsChanged = true;
   if (ImGui::DragFloat("Strength##Sculpt", &m_BrushSettings.strength, 0.01f, 0.01f, 1.0f)) settingsChanged = true;
   ImGui::PopItemWidth();
+  if (m_BrushSettings.mode == SculptMode::Smooth) {
+    if (ImGui::Checkbox("Preserve Volume##Sculpt", &m_BrushSettings.preserveVolume)) settingsChanged = true;
+  }
 
   ImGui::Separator();
   ImGui::Text("Brush Falloff");
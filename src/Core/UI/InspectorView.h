@@ -25,6 +25,7 @@ class InspectorView : public IView {
   void DrawMeshEditingControls(ISceneObject* sel);
   void DrawBrushSettings();
   void DrawSubObjectSettings();
+  void DrawMultiresSettings(ISceneObject* sel);
 
   // Helpers to determine if tools should be active
   bool CanWeld() const;
@@ -2,7 +2,10 @@
 
 #include <imgui.h>
 
+#include <string>
+
 #include "Core/Application.h"
+#include "Core/CommandHistory.h"
 #include "Factories/SceneObjectFactory.h"
 #include "Scene/Scene.h"
 #include "nfd.hpp"
@@ -12,6 +15,7 @@ MenuBar::MenuBar(Application* app) : m_App(app) {}
 void MenuBar::Draw() {
   if (ImGui::BeginMainMenuBar()) {
     DrawFileMenu();
+    DrawEditMenu();
     DrawViewMenu();
     DrawSceneMenu();
     ImGui::EndMainMenuBar();
@@ -23,9 +27,21 @@ void MenuBar::DrawFileMenu() {
     if (ImGui::MenuItem("Save Scene")) {
       m_App->GetScene()->Save("scene.json");
     }
+    if (ImGui::MenuItem("Save Scene (Binary)")) {
+      m_App->GetScene()->Save("scene.imscene");
+    }
     if (ImGui::MenuItem("Load Scene")) {
       m_App->OnSceneLoaded();
     }
+    if (ImGui::MenuItem("Open Scene...")) {
+      NFD::Guard nfdGuard;
+      NFD::UniquePath outPath;
+      nfdfilteritem_t filterItem[1] = {{"Scene", "json,imscene"}};
+      nfdresult_t result = NFD::OpenDialog(outPath, filterItem, 1);
+      if (result == NFD_OKAY) {
+        m_App->OnSceneLoaded(outPath.get());
+      }
+    }
     if (ImGui::MenuItem("Import Model")) {
       NFD::Guard nfdGuard;
       NFD::UniquePath outPath;
@@ -47,6 +63,23 @@ void MenuBar::DrawFileMenu() {
   }
 }
 
+void MenuBar::DrawEditMenu() {
+  if (ImGui::BeginMenu("Edit")) {
+    const CommandHistory* history = m_App->GetHistory();
+    std::string undoLabel = std::string("Undo ") + history->GetUndoName();
+    std::string redoLabel = std::string("Redo ") + history->GetRedoName();
+    if (ImGui::MenuItem(undoLabel.c_str(), "Ctrl+Z", false,
+                        history->CanUndo())) {
+      m_App->Undo();
+    }
+    if (ImGui::MenuItem(redoLabel.c_str(), "Ctrl+Y", false,
+                        history->CanRedo())) {
+      m_App->Redo();
+    }
+    ImGui::EndMenu();
+  }
+}
+
 void MenuBar::DrawViewMenu() {
   if (ImGui::BeginMenu("View")) {
     bool show = m_App->GetShowAnchors();
@@ -14,6 +14,7 @@ class MenuBar : public IView {
 
  private:
   void DrawFileMenu();
+  void DrawEditMenu();
   void DrawViewMenu();
   void DrawSceneMenu();
   void DrawAddObjectSubMenu();
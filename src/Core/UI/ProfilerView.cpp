@@ -0,0 +1,227 @@
+#include "Core/UI/ProfilerView.h"
+
+#include <imgui.h>
+#include <imgui_stdlib.h>
+#include <implot.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string_view>
+#include <vector>
+
+#include "Core/Application.h"
+#include "Core/Profiler.h"
+
+namespace {
+
+constexpr double kNsPerMs = 1e6;
+constexpr float kFlameRowHeight = 1.0f;
+
+double toMs(uint64_t ns) { return static_cast<double>(ns) / kNsPerMs; }
+
+// Same zone name, same color, in both plots.
+ImVec4 zoneColor(const char* name) {
+  size_t hash = std::hash<std::string_view>()(name);
+  return ImPlot::GetColormapColor(
+      static_cast<int>(hash % ImPlot::GetColormapSize()));
+}
+
+}  // namespace
+
+ProfilerView::ProfilerView(Application* app) : m_App(app) {}
+
+void ProfilerView::Draw() {
+  if (!m_App->GetShowProfiler()) return;
+
+  bool open = true;
+  if (!ImGui::Begin("Profiler", &open)) {
+    ImGui::End();
+    if (!open) m_App->SetShowProfiler(false);
+    return;
+  }
+
+  Profiler& profiler = Profiler::Get();
+  const auto& frames = profiler.GetFrames();
+  if (!frames.empty()) {
+    const auto& last = frames.back();
+    ImGui::Text("Frame %llu: %.2f ms", static_cast<unsigned long long>(last.index),
+                toMs(last.endNs - last.startNs));
+    if (uint64_t dropped = profiler.GetDroppedZoneCount()) {
+      ImGui::SameLine();
+      ImGui::TextColored(ImVec4(1, 0.6f, 0.2f, 1), "(%llu zones dropped)",
+                         static_cast<unsigned long long>(dropped));
+    }
+  }
+
+  bool paused = profiler.IsPaused();
+  if (ImGui::Checkbox("Pause", &paused)) profiler.SetPaused(paused);
+  ImGui::SameLine();
+  if (!profiler.IsRecording()) {
+    if (ImGui::Button("Record Trace")) {
+      profiler.StartRecording();
+      m_Status = "Recording...";
+    }
+  } else if (ImGui::Button("Stop and Save")) {
+    m_Status = profiler.StopRecording(m_TracePath)
+                   ? "Saved " + m_TracePath
+                   : "Could not write " + m_TracePath;
+  }
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(200);
+  ImGui::InputText("##TracePath", &m_TracePath);
+  if (!m_Status.empty()) ImGui::TextUnformatted(m_Status.c_str());
+
+  drawTimeline();
+  drawFlame();
+
+  ImGui::End();
+  if (!open) m_App->SetShowProfiler(false);
+}
+
+void ProfilerView::drawTimeline() {
+  Profiler& profiler = Profiler::Get();
+  const auto& frames = profiler.GetFrames();
+  if (frames.empty()) return;
+
+  // One series per top-level phase of the main thread, in first-seen order.
+  std::vector<const char*> phases;
+  std::map<std::string_view, size_t> phaseIndex;
+  for (const auto& frame : frames) {
+    for (const auto& zone : frame.zones) {
+      if (zone.track != profiler.GetMainTrack() || zone.depth != 0) continue;
+      if (phaseIndex.emplace(zone.name, phases.size()).second) {
+        phases.push_back(zone.name);
+      }
+    }
+  }
+
+  const size_t count = frames.size();
+  std::vector<double> xs(count), frameMs(count), gpuMs(count, 0.0);
+  std::vector<std::vector<double>> stacked(phases.size() + 1,
+                                           std::vector<double>(count, 0.0));
+  for (size_t i = 0; i < count; ++i) {
+    const auto& frame = frames[i];
+    xs[i] = static_cast<double>(frame.index);
+    frameMs[i] = toMs(frame.endNs - frame.startNs);
+    for (const auto& zone : frame.zones) {
+      if (zone.depth != 0) continue;
+      if (zone.track == profiler.GetGpuTrack()) {
+        gpuMs[i] += toMs(zone.endNs - zone.startNs);
+      } else if (zone.track == profiler.GetMainTrack()) {
+        stacked[phaseIndex[zone.name] + 1][i] += toMs(zone.endNs - zone.startNs);
+      }
+    }
+    for (size_t p = 1; p < stacked.size(); ++p) stacked[p][i] += stacked[p - 1][i];
+  }
+
+  if (ImPlot::BeginPlot("##FrameTimeline", ImVec2(-1, 200),
+                        ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect)) {
+    ImPlot::SetupAxes("Frame", "ms", ImPlotAxisFlags_AutoFit,
+                      ImPlotAxisFlags_AutoFit);
+    ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_Outside);
+    for (size_t p = 0; p < phases.size(); ++p) {
+      ImPlot::SetNextFillStyle(zoneColor(phases[p]), 0.8f);
+      ImPlot::PlotShaded(phases[p], xs.data(), stacked[p].data(),
+                         stacked[p + 1].data(), static_cast<int>(count));
+    }
+    ImPlot::SetNextLineStyle(ImVec4(1, 1, 1, 1));
+    ImPlot::PlotLine("Frame", xs.data(), frameMs.data(), static_cast<int>(count));
+    ImPlot::SetNextLineStyle(ImVec4(1, 0.4f, 0.4f, 1));
+    ImPlot::PlotLine("GPU", xs.data(), gpuMs.data(), static_cast<int>(count));
+    ImPlot::EndPlot();
+  }
+}
+
+void ProfilerView::drawFlame() {
+  Profiler& profiler = Profiler::Get();
+  const auto& frames = profiler.GetFrames();
+  if (frames.empty()) return;
+
+  int maxFramesAgo = static_cast<int>(frames.size()) - 1;
+  m_FramesAgo = std::clamp(m_FramesAgo, 0, maxFramesAgo);
+  ImGui::SliderInt("Frames ago", &m_FramesAgo, 0, maxFramesAgo);
+  const auto& frame = frames[frames.size() - 1 - m_FramesAgo];
+
+  // Lay tracks out top to bottom, main thread first and GPU last, each as
+  // tall as its deepest nesting.
+  std::map<uint32_t, int> trackDepth;
+  uint64_t lastEndNs = frame.endNs;  // GPU work can finish after the frame
+  for (const auto& zone : frame.zones) {
+    trackDepth[zone.track] = std::max(trackDepth[zone.track], zone.depth + 1);
+    lastEndNs = std::max(lastEndNs, zone.endNs);
+  }
+  std::vector<uint32_t> tracks;
+  for (const auto& [track, depth] : trackDepth) tracks.push_back(track);
+  std::stable_partition(tracks.begin(), tracks.end(), [&](uint32_t track) {
+    return track == profiler.GetMainTrack();
+  });
+  std::stable_partition(tracks.begin(), tracks.end(), [&](uint32_t track) {
+    return track != profiler.GetGpuTrack();
+  });
+
+  std::map<uint32_t, float> trackTop;
+  float rows = 0.0f;
+  std::vector<double> tickPositions;
+  std::vector<std::string> tickNames;
+  for (uint32_t track : tracks) {
+    trackTop[track] = rows;
+    tickPositions.push_back(rows + 0.5 * kFlameRowHeight);
+    tickNames.push_back(profiler.GetTrackName(track));
+    rows += trackDepth[track] * kFlameRowHeight + 0.5f;
+  }
+  std::vector<const char*> tickLabels;
+  for (const auto& name : tickNames) tickLabels.push_back(name.c_str());
+
+  if (ImPlot::BeginPlot("##FrameFlame", ImVec2(-1, -1),
+                        ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect |
+                            ImPlotFlags_NoLegend)) {
+    ImPlot::SetupAxes("ms", nullptr, 0, ImPlotAxisFlags_Invert);
+    ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, toMs(lastEndNs - frame.startNs),
+                            ImPlotCond_Always);
+    ImPlot::SetupAxisLimits(ImAxis_Y1, 0.0, std::max(rows, 1.0f),
+                            ImPlotCond_Always);
+    if (!tickLabels.empty()) {
+      ImPlot::SetupAxisTicks(ImAxis_Y1, tickPositions.data(),
+                             static_cast<int>(tickPositions.size()),
+                             tickLabels.data());
+    }
+
+    ImDrawList* drawList = ImPlot::GetPlotDrawList();
+    ImPlot::PushPlotClipRect();
+    const char* hoveredName = nullptr;
+    double hoveredMs = 0.0;
+    ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+    for (const auto& zone : frame.zones) {
+      // GPU zones are on the CPU clock, but may start before the frame did.
+      double x0 = zone.startNs >= frame.startNs ? toMs(zone.startNs - frame.startNs)
+                                                : -toMs(frame.startNs - zone.startNs);
+      double x1 = x0 + toMs(zone.endNs - zone.startNs);
+      double y0 = trackTop[zone.track] + zone.depth * kFlameRowHeight;
+      double y1 = y0 + kFlameRowHeight;
+
+      ImVec2 p0 = ImPlot::PlotToPixels(x0, y0);
+      ImVec2 p1 = ImPlot::PlotToPixels(x1, y1);
+      ImVec2 minCorner(std::min(p0.x, p1.x), std::min(p0.y, p1.y));
+      ImVec2 maxCorner(std::max(p0.x, p1.x), std::max(p0.y, p1.y));
+      drawList->AddRectFilled(minCorner, maxCorner,
+                              ImGui::GetColorU32(zoneColor(zone.name)));
+      drawList->AddRect(minCorner, maxCorner, IM_COL32(0, 0, 0, 128));
+      if (maxCorner.x - minCorner.x > ImGui::CalcTextSize(zone.name).x + 4) {
+        drawList->AddText(ImVec2(minCorner.x + 2, minCorner.y + 1),
+                          IM_COL32(0, 0, 0, 255), zone.name);
+      }
+      if (ImPlot::IsPlotHovered() && mouse.x >= x0 && mouse.x < x1 &&
+          mouse.y >= y0 && mouse.y < y1) {
+        hoveredName = zone.name;
+        hoveredMs = x1 - x0;
+      }
+    }
+    ImPlot::PopPlotClipRect();
+    ImPlot::EndPlot();
+
+    if (hoveredName) {
+      ImGui::SetTooltip("%s: %.3f ms", hoveredName, hoveredMs);
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+#include "Core/UI/IView.h"
+
+// Forward declarations
+class Application;
+
+/**
+ * @brief Shows the Profiler's frame history: a rolling timeline of the main
+ * frame phases and a flame view of one frame across all threads and the GPU.
+ * Also starts and stops Chrome trace recordings.
+ */
+class ProfilerView : public IView {
+ public:
+  explicit ProfilerView(Application* app);
+
+  void Draw() override;
+  const char* GetName() const override { return "ProfilerView"; }
+
+ private:
+  void drawTimeline();
+  void drawFlame();
+
+  Application* m_App;
+  // How many frames back from the newest the flame view shows. GPU timings
+  // arrive a few frames late, so the default looks just past them.
+  int m_FramesAgo = 5;
+  std::string m_TracePath = "profile_trace.json";
+  std::string m_Status;
+};
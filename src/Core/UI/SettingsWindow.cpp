@@ -63,6 +63,19 @@ void SettingsWindow::Draw() {
   }
   ImGui::Separator();
 
+  ImGui::Text("Viewport");
+  for (const auto& desc : SettingsManager::GetDescriptors()) {
+    if (desc.type == SettingType::Bool) {
+      ImGui::Checkbox(desc.label.c_str(), static_cast<bool*>(desc.ptr));
+    }
+  }
+  ImGui::Separator();
+
+  ImGui::Text("History");
+  ImGui::DragInt("Undo Memory (MB)", &SettingsManager::Get().undoMemoryMB, 1,
+                 16, 8192);
+  ImGui::Separator();
+
   if (ImGui::Button("Save and Close")) {
     SettingsManager::Get().leftPaneWidth = m_TempLeftPaneWidth;
     SettingsManager::Get().rightPaneWidth = m_TempRightPaneWidth;
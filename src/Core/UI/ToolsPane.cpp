@@ -15,6 +15,12 @@ void ToolsPane::Draw() {
     m_App->GetCamera()->ResetToDefault();
   }
 
+  ImGui::Separator();
+  bool showProfiler = m_App->GetShowProfiler();
+  if (ImGui::Checkbox("Show Profiler", &showProfiler)) {
+    m_App->SetShowProfiler(showProfiler);
+  }
+
 #ifndef NDEBUG
   ImGui::Separator();
   bool showMetrics = m_App->GetShowMetricsWindow();
@@ -28,7 +28,9 @@ std::unique_ptr<ISceneObject> SceneObjectFactory::Create(
 }
 
 std::unique_ptr<ISceneObject> SceneObjectFactory::Copy(
-    const ISceneObject& src) const {
+    ISceneObject& src) const {
+  if (auto clone = src.Clone()) return clone;
+
   auto clone = Create(src.GetTypeString());
   if (!clone) {
     Log::Debug(
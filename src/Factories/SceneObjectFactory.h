@@ -16,7 +16,7 @@ class SceneObjectFactory {
 
   std::unique_ptr<ISceneObject> Create(const std::string& typeName) const;
 
-  std::unique_ptr<ISceneObject> Copy(const ISceneObject& src) const;
+  std::unique_ptr<ISceneObject> Copy(ISceneObject& src) const;
 
   std::vector<std::string> GetUserCreatableTypeNames() const;
 
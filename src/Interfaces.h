@@ -40,6 +40,9 @@ class PropertySet {
   const std::vector<std::unique_ptr<IProperty>>& GetProperties() const;
   void Serialize(nlohmann::json& outJson) const;
   void Deserialize(const nlohmann::json& inJson);
+  // Copies the values of same-named, same-typed properties without calling
+  // the change callbacks.
+  void CopyValuesFrom(const PropertySet& other);
 
  private:
   std::unordered_map<std::string, IProperty*> m_PropertyMap;
@@ -53,6 +56,13 @@ class IProperty {
   virtual void DrawEditor() = 0;
   virtual void Serialize(nlohmann::json& j) = 0;
   virtual void Deserialize(const nlohmann::json& j) = 0;
+  // Takes other's value if it holds the same type; no callback.
+  virtual void CopyValueFrom(const IProperty& other) = 0;
+  // Deserialize, then notify the owner the way SetValue does.
+  void Assign(const nlohmann::json& j) {
+    Deserialize(j);
+    if (m_OnChangeCallback) m_OnChangeCallback();
+  }
   void SetChangeCallback(std::function<void()> callback);
 
  protected:
@@ -69,6 +79,7 @@ class TProperty : public IProperty {
   void SetValue(const T& value);
   void Serialize(nlohmann::json& outJson) override;
   void Deserialize(const nlohmann::json& inJson) override;
+  void CopyValueFrom(const IProperty& other) override;
   void DrawEditor() override;
 
  private:
@@ -115,6 +126,15 @@ class ISceneObject : public IGizmoClient {
 
   // CORRECT: Implementation moved here to resolve linker errors.
   virtual void Serialize(nlohmann::json& outJson) const {
+    SerializeProperties(outJson);
+    if (const SculptableMesh* sculptableMesh = GetSculptableMesh()) {
+      sculptableMesh->Serialize(outJson);
+    }
+  }
+
+  // Everything Serialize writes except the mesh data, for formats that store
+  // meshes out of line.
+  void SerializeProperties(nlohmann::json& outJson) const {
     outJson["type"] = GetTypeString();
     outJson["id"] = id;
     outJson["name"] = name;
@@ -122,14 +142,10 @@ class ISceneObject : public IGizmoClient {
     nlohmann::json propsJson;
     GetPropertySet().Serialize(propsJson);
     outJson["properties"] = propsJson;
+  }
 
-    IEditableMesh* editableMesh =
-        const_cast<ISceneObject*>(this)->GetEditableMesh();
-    if (editableMesh) {
-      if (auto* sculptableMesh = dynamic_cast<SculptableMesh*>(editableMesh)) {
-        sculptableMesh->Serialize(outJson);
-      }
-    }
+  const SculptableMesh* GetSculptableMesh() const {
+    return dynamic_cast<const SculptableMesh*>(GetCurrentMesh());
   }
 
   // CORRECT: Implementation moved here to resolve linker errors.
@@ -141,22 +157,67 @@ class ISceneObject : public IGizmoClient {
       GetPropertySet().Deserialize(inJson["properties"]);
     }
 
+    // Objects build their procedural mesh lazily, so a saved mesh below
+    // replaces it before it is ever generated.
     RebuildMesh();
 
-    if (IEditableMesh* editableMesh = GetEditableMesh()) {
-      if (auto* sculptableMesh = dynamic_cast<SculptableMesh*>(editableMesh)) {
-        sculptableMesh->Deserialize(inJson);
-        SetMeshDirty(true);
-      }
+    if (inJson.contains("sculpt_vertices")) {
+      SculptableMesh loaded;
+      loaded.Deserialize(inJson);
+      SetLoadedMesh(std::move(loaded));
     }
   }
 
+  // Replaces the mesh with one read from a scene file.
+  virtual void SetLoadedMesh(SculptableMesh&& mesh) {
+    if (auto* sculptableMesh = dynamic_cast<SculptableMesh*>(GetEditableMesh())) {
+      *sculptableMesh = std::move(mesh);
+      SetMeshDirty(true);
+    }
+  }
+
+  // Copy of this object, or nullptr if the type cannot copy itself directly;
+  // SceneObjectFactory::Copy then round-trips it through Serialize. Not
+  // const: the copy may share this object's mesh, and from then on neither
+  // writes to it without taking its own copy first.
+  virtual std::unique_ptr<ISceneObject> Clone() { return nullptr; }
+
   virtual std::shared_ptr<Shader> GetShader() const = 0;
+  // Mutable access; objects that share their mesh take a private copy first.
   virtual IEditableMesh* GetEditableMesh() = 0;
+  // Read-only access that never copies.
+  virtual const IEditableMesh* GetMesh() const {
+    return const_cast<ISceneObject*>(this)->GetEditableMesh();
+  }
+  // GetMesh, but never the previous mesh while a rebuild is still running in
+  // the background; for saving and for edits that read before they write.
+  virtual const IEditableMesh* GetCurrentMesh() const { return GetMesh(); }
+  // The mesh the renderer draws and takes GPU deltas from. Like GetMesh it
+  // never forces a pending build, so the previous mesh stays up while a
+  // rebuild runs. Only for objects with no shared mesh.
+  virtual IEditableMesh* GetMeshForUpload() { return GetEditableMesh(); }
+  // The cached mesh this object shares with identical objects, if any.
+  virtual std::shared_ptr<const IEditableMesh> GetSharedMesh() const {
+    return nullptr;
+  }
   virtual bool IsMeshDirty() const = 0;
   virtual void SetMeshDirty(bool dirty) = 0;
+  // Counts RebuildMesh calls, so callers can tell that an edit threw the
+  // current mesh away.
+  virtual uint64_t GetMeshRebuildCount() const { return 0; }
   virtual bool IsUserCreatable() const { return true; }
 
+  // Multires sculpting. Level 0 is the mesh the object had before its first
+  // subdivision; objects without levels report 0 for both.
+  virtual int GetSubdivisionLevels() const { return 0; }
+  virtual int GetSubdivisionLevel() const { return 0; }
+  // Subdivides the finest level and shows it. False if it would be too dense.
+  virtual bool AddSubdivisionLevel() { return false; }
+  // Keeps the edits made at the shown level and shows another one.
+  virtual void SetSubdivisionLevel(int level) {}
+  // Keeps the shown level as the plain mesh and drops all the others.
+  virtual void ClearSubdivisionLevels() {}
+
   uint32_t id;
   std::string name;
   bool isSelected;
@@ -228,6 +289,14 @@ inline void PropertySet::Deserialize(const nlohmann::json& inJson) {
   }
 }
 
+inline void PropertySet::CopyValuesFrom(const PropertySet& other) {
+  for (auto& prop : m_Properties) {
+    if (IProperty* source = other.GetProperty(prop->GetName())) {
+      prop->CopyValueFrom(*source);
+    }
+  }
+}
+
 inline void IProperty::SetChangeCallback(std::function<void()> callback) {
   m_OnChangeCallback = callback;
 }
@@ -267,6 +336,13 @@ void TProperty<T>::Deserialize(const nlohmann::json& inJson) {
   }
 }
 
+template <typename T>
+void TProperty<T>::CopyValueFrom(const IProperty& other) {
+  if (auto* typed = dynamic_cast<const TProperty<T>*>(&other)) {
+    m_Value = typed->m_Value;
+  }
+}
+
 template <typename T>
 void TProperty<T>::DrawEditor() {
   T tempValue = m_Value;
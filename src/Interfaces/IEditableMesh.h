@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <unordered_set>
 #include <vector>
@@ -6,6 +7,31 @@
 
 // Forward-declare the custom hasher
 struct PairHash;
+class MeshBVH;
+class MeshConnectivity;
+struct VertexSoA;
+
+/**
+ * @brief What changed in a mesh since the renderer last uploaded it.
+ * Vertex data in [vertexBegin, vertexEnd) needs re-uploading; when
+ * topologyChanged is set, every buffer (including indices) does.
+ */
+struct MeshGpuDelta {
+  uint32_t vertexBegin = 0;
+  uint32_t vertexEnd = 0;
+  bool topologyChanged = false;
+
+  bool HasVertexChanges() const { return vertexEnd > vertexBegin; }
+};
+
+/**
+ * @brief Vertex-to-vertex adjacency in CSR form: the neighbors of vertex v are
+ * neighbors[offsets[v] .. offsets[v + 1]), each listed once.
+ */
+struct VertexAdjacency {
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> neighbors;
+};
 
 class IEditableMesh {
  public:
@@ -21,6 +47,73 @@ class IEditableMesh {
 
   virtual void RecalculateNormals() = 0;
 
+  /**
+   * @brief Changes whenever positions, normals or indices may have changed,
+   * including every mutable access. Lets callers cache derived data cheaply.
+   * Revisions come from a process-wide counter, so two meshes only report
+   * the same one when one is an unchanged copy of the other.
+   */
+  virtual uint64_t GetRevision() const = 0;
+
+  /**
+   * @brief Identifies the mesh data an edit started from. A new ID is taken
+   * whenever the mesh is generated or loaded, and kept through in-place
+   * edits and copies, so recorded deltas can refuse a mesh they were not
+   * taken on.
+   */
+  virtual uint64_t GetBaseId() const = 0;
+
+  /**
+   * @brief Returns the triangle BVH, rebuilt or refit first if the mesh
+   * changed since the last query.
+   */
+  virtual const MeshBVH& GetBVH() const = 0;
+
+  /**
+   * @brief Collects the vertices strictly inside a sphere (mesh-local space).
+   * Cost scales with the number of vertices near the sphere, not mesh size.
+   */
+  virtual void QueryVerticesInSphere(const glm::vec3& center, float radius,
+                                     std::vector<uint32_t>& outIndices) const = 0;
+
+  /**
+   * @brief Reports vertices moved through GetVertices() so the mesh can update
+   * its spatial structures incrementally. Unreported edits are still picked up,
+   * at the cost of a full rebuild on the next query.
+   */
+  virtual void MarkVerticesDirty(const std::vector<uint32_t>& vertexIndices) = 0;
+
+  /**
+   * @brief Structure-of-arrays copy of the positions for vectorized kernels.
+   * Kept in sync the same way as the spatial hash.
+   */
+  virtual const VertexSoA& GetPositionsSoA() const = 0;
+
+  /**
+   * @brief Returns the edge-connected neighbors of every vertex, rebuilt first
+   * if the topology changed since the last call.
+   */
+  virtual const VertexAdjacency& GetVertexAdjacency() const = 0;
+
+  /**
+   * @brief Returns the edge/face connectivity. Built on first use; extrude,
+   * weld and bevel patch only the faces they touch, while rewriting the
+   * indices through GetIndices() forces a rebuild.
+   */
+  virtual const MeshConnectivity& GetConnectivity() const = 0;
+
+  /**
+   * @brief Recomputes normals only for the vertices reported through
+   * MarkVerticesDirty since the last normal update, plus their one-ring.
+   */
+  virtual void RecalculateDirtyNormals() = 0;
+
+  /**
+   * @brief Returns the changes accumulated since the previous call and resets
+   * them. Intended for the renderer only.
+   */
+  virtual MeshGpuDelta ConsumeGpuDelta() = 0;
+
   virtual bool ExtrudeFaces(const std::unordered_set<uint32_t>& faceIndices, float distance) = 0;
   virtual bool WeldVertices(const std::unordered_set<uint32_t>& vertexIndices, const glm::vec3& weldPoint) = 0;
   virtual bool BevelEdges(const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>& edges, float amount) = 0;
@@ -0,0 +1,85 @@
+#include "Renderer/GpuTimer.h"
+
+#include "Core/Profiler.h"
+
+void GpuTimer::Initialize() {
+  m_Initialized = true;
+  calibrate();
+}
+
+void GpuTimer::Shutdown() {
+  for (auto& frame : m_Frames) {
+    for (auto& pass : frame.passes) {
+      glDeleteQueries(1, &pass.beginQuery);
+      glDeleteQueries(1, &pass.endQuery);
+    }
+    frame = FrameQueries{};
+  }
+  m_OpenPasses.clear();
+  m_Initialized = false;
+}
+
+void GpuTimer::calibrate() {
+  GLint64 gpuNs = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+  m_GpuToCpuOffsetNs = gpuNs - static_cast<int64_t>(Profiler::NowNs());
+}
+
+void GpuTimer::Begin(const char* name) {
+  if (!m_Initialized) return;
+  FrameQueries& frame = m_Frames[m_Current];
+  if (frame.used == frame.passes.size()) {
+    Pass pass;
+    glGenQueries(1, &pass.beginQuery);
+    glGenQueries(1, &pass.endQuery);
+    frame.passes.push_back(pass);
+  }
+  Pass& pass = frame.passes[frame.used];
+  pass.name = name;
+  pass.depth = static_cast<uint16_t>(m_OpenPasses.size());
+  glQueryCounter(pass.beginQuery, GL_TIMESTAMP);
+  m_OpenPasses.push_back(frame.used++);
+}
+
+void GpuTimer::End() {
+  if (!m_Initialized || m_OpenPasses.empty()) return;
+  glQueryCounter(m_Frames[m_Current].passes[m_OpenPasses.back()].endQuery,
+                 GL_TIMESTAMP);
+  m_OpenPasses.pop_back();
+}
+
+void GpuTimer::EndFrame(uint64_t frameIndex) {
+  if (!m_Initialized) return;
+  FrameQueries& current = m_Frames[m_Current];
+  current.frameIndex = frameIndex;
+  current.pending = current.used > 0;
+
+  m_Current = (m_Current + 1) % kFramesInFlight;
+  FrameQueries& oldest = m_Frames[m_Current];
+  if (oldest.pending) collect(oldest);
+  oldest.used = 0;
+  oldest.pending = false;
+}
+
+void GpuTimer::collect(FrameQueries& frame) {
+  // Reading a result that is not ready would stall until the GPU catches up.
+  for (size_t i = 0; i < frame.used; ++i) {
+    GLint available = 0;
+    glGetQueryObjectiv(frame.passes[i].endQuery, GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (!available) return;
+  }
+
+  Profiler& profiler = Profiler::Get();
+  for (size_t i = 0; i < frame.used; ++i) {
+    const Pass& pass = frame.passes[i];
+    GLuint64 beginNs = 0, endNs = 0;
+    glGetQueryObjectui64v(pass.beginQuery, GL_QUERY_RESULT, &beginNs);
+    glGetQueryObjectui64v(pass.endQuery, GL_QUERY_RESULT, &endNs);
+    profiler.SubmitGpuZone(
+        frame.frameIndex, pass.name,
+        static_cast<uint64_t>(static_cast<int64_t>(beginNs) - m_GpuToCpuOffsetNs),
+        static_cast<uint64_t>(static_cast<int64_t>(endNs) - m_GpuToCpuOffsetNs),
+        pass.depth);
+  }
+}
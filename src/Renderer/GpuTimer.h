@@ -0,0 +1,68 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Times GPU passes with GL timestamp queries and reports them to the
+ * Profiler.
+ *
+ * Queries are read back kFramesInFlight frames after they were issued, so
+ * the CPU never waits on the GPU; a frame whose results are still not ready
+ * by then is dropped. Passes may nest.
+ */
+class GpuTimer {
+ public:
+  static constexpr size_t kFramesInFlight = 4;
+
+  void Initialize();
+  void Shutdown();
+
+  void Begin(const char* name);
+  void End();
+
+  /** @brief Closes the current frame's queries and collects the oldest. */
+  void EndFrame(uint64_t frameIndex);
+
+ private:
+  struct Pass {
+    const char* name = nullptr;
+    GLuint beginQuery = 0;
+    GLuint endQuery = 0;
+    uint16_t depth = 0;
+  };
+
+  struct FrameQueries {
+    uint64_t frameIndex = 0;
+    std::vector<Pass> passes;  // Grows on demand; queries are reused
+    size_t used = 0;
+    bool pending = false;
+  };
+
+  void collect(FrameQueries& frame);
+  void calibrate();
+
+  std::array<FrameQueries, kFramesInFlight> m_Frames;
+  size_t m_Current = 0;
+  std::vector<size_t> m_OpenPasses;
+  // GPU timestamp minus CPU profiler time, measured once at startup.
+  int64_t m_GpuToCpuOffsetNs = 0;
+  bool m_Initialized = false;
+};
+
+/** @brief Times the enclosing scope as a GPU pass. */
+class GpuZone {
+ public:
+  GpuZone(GpuTimer& timer, const char* name) : m_Timer(timer) {
+    m_Timer.Begin(name);
+  }
+  ~GpuZone() { m_Timer.End(); }
+  GpuZone(const GpuZone&) = delete;
+  GpuZone& operator=(const GpuZone&) = delete;
+
+ private:
+  GpuTimer& m_Timer;
+};
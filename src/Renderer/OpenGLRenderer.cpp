@@ -3,6 +3,7 @@
 
 #include <GLFW/glfw3.h>
 
+#include <cstddef>
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "Core/Camera.h"
 #include "Core/Log.h"
 #include "Core/MathHelpers.h"
+#include "Core/Profiler.h"
 #include "Core/ResourceManager.h"
 #include "Interfaces.h"
 #include "Interfaces/IEditableMesh.h"
@@ -19,12 +21,33 @@
 #include "Shader.h"
 #include "imgui_impl_opengl3.h"
 #include "Core/SettingsManager.h"
+
+namespace {
+
+// Attribute slots of the per-instance data in lit_instanced.vert.
+constexpr GLuint kInstanceModelAttrib = 2;  // Takes slots 2-5
+constexpr GLuint kInstanceColorAttrib = 6;
+
+// Buffers are freed when the last object drawing them lets go.
+std::shared_ptr<GpuMeshResources> makeGpuMeshResources() {
+  return std::shared_ptr<GpuMeshResources>(new GpuMeshResources(),
+                                           [](GpuMeshResources* res) {
+                                             res->Release();
+                                             delete res;
+                                           });
+}
+
+}  // namespace
+
 const char* GIZMO_VERTEX_SHADER_SRC = R"glsl(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
+layout (std140) uniform Camera {
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_ViewPos;
+};
 void main() { gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 1.0); }
 )glsl";
 
@@ -64,9 +87,22 @@ bool OpenGLRenderer::Initialize(void* windowHandle) {
                                             "shaders/lit.frag");
   m_UnlitShader = ResourceManager::LoadShader("unlit", "shaders/default.vert",
                                               "shaders/unlit.frag");
+  m_LitInstancedShader = ResourceManager::LoadShader(
+      "lit_instanced_shader", "shaders/lit_instanced.vert",
+      "shaders/lit_instanced.frag");
+
+  glGenBuffers(1, &m_CameraUBO);
+  glBindBuffer(GL_UNIFORM_BUFFER, m_CameraUBO);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraUniforms), nullptr,
+               GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, Shader::kCameraBlockBinding, m_CameraUBO);
+  glGenBuffers(1, &m_InstanceVBO);
 
   glfwGetWindowSize(m_Window, &m_Width, &m_Height);
   createFramebuffers();
+  m_PickingBuffer.Initialize();
+  m_PickingBuffer.Resize(m_Width, m_Height);
   createGizmoResources();
   createAnchorMesh();
 
@@ -99,35 +135,110 @@ bool OpenGLRenderer::Initialize(void* windowHandle) {
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
 
   glBindVertexArray(0);
+  m_GpuTimer.Initialize();
 
   Log::Debug("OpenGLRenderer Initialized successfully.");
   return true;
 }
 
 void OpenGLRenderer::SyncSceneObjects(const Scene& scene) {
-  for (auto it = m_GpuResources.begin(); it != m_GpuResources.end();) {
-    if (scene.GetObjectByID(it->first) == nullptr) {
-      it->second.Release();
-      it = m_GpuResources.erase(it);
-    } else {
-      ++it;
+  PROFILE_SCOPE("SyncSceneObjects");
+  // Only removals need handling here; added objects start with a dirty mesh.
+  bool released = false;
+  bool complete = scene.ConsumeChanges(
+      m_SceneChangeCursor, [this, &released](const SceneChange& change) {
+        if (change.kind == SceneChange::Kind::Removed) {
+          released |= m_GpuResources.erase(change.id) > 0;
+        }
+      });
+  if (!complete) {
+    // First sync with this scene, or it changed faster than its log keeps.
+    for (auto it = m_GpuResources.begin(); it != m_GpuResources.end();) {
+      if (scene.GetObjectByID(it->first) == nullptr) {
+        it = m_GpuResources.erase(it);
+        released = true;
+      } else {
+        ++it;
+      }
     }
   }
+  if (released) {
+    std::erase_if(m_SharedGpuMeshes,
+                  [](const auto& entry) { return entry.second.gpu.expired(); });
+  }
   for (const auto& objectPtr : scene.GetSceneObjects()) {
-    if (objectPtr && objectPtr->GetEditableMesh() && objectPtr->IsMeshDirty()) {
-      updateGpuMesh(objectPtr.get());
+    if (objectPtr && objectPtr->GetMesh() && objectPtr->IsMeshDirty()) {
+      if (auto shared = objectPtr->GetSharedMesh()) {
+        attachSharedGpuMesh(*objectPtr, shared);
+      } else {
+        updateGpuMesh(objectPtr.get());
+      }
       objectPtr->SetMeshDirty(false);
     }
   }
 }
 
+void OpenGLRenderer::attachSharedGpuMesh(
+    const ISceneObject& object, const std::shared_ptr<const IEditableMesh>& mesh) {
+  if (mesh->GetVertices().empty()) return;
+  SharedGpuMesh& entry = m_SharedGpuMeshes[mesh.get()];
+  // An expired mesh means the address was reused by a different one.
+  std::shared_ptr<GpuMeshResources> gpu;
+  if (!entry.mesh.expired()) gpu = entry.gpu.lock();
+  if (!gpu) {
+    gpu = makeGpuMeshResources();
+    gpu->shared = true;
+    uploadGpuMesh(*gpu, *mesh);
+    entry = {mesh, gpu};
+    Log::Debug("Uploaded shared GPU mesh for object ID: ", object.id);
+  }
+  m_GpuResources[object.id] = std::move(gpu);
+}
+
 void OpenGLRenderer::updateGpuMesh(ISceneObject* object) {
   if (!object) return;
-  auto* meshData = object->GetEditableMesh();
-  if (!meshData || meshData->GetVertices().empty()) return;
+  // Never forces a pending rebuild; the last mesh is drawn until it lands.
+  IEditableMesh* editableMesh = object->GetMeshForUpload();
+  if (!editableMesh) return;
+  // Read through a const reference so the upload itself does not invalidate
+  // the mesh's acceleration structures.
+  const IEditableMesh& meshData = *editableMesh;
+  if (meshData.GetVertices().empty()) return;
+
+  MeshGpuDelta delta = editableMesh->ConsumeGpuDelta();
+  auto& slot = m_GpuResources[object->id];
+  // The object just stopped sharing: its old buffers belong to the others.
+  if (!slot || slot->shared) slot = makeGpuMeshResources();
+  GpuMeshResources& res = *slot;
+
+  const auto& vertices = meshData.GetVertices();
+  const auto& normals = meshData.GetNormals();
+
+  bool reallocate = delta.topologyChanged ||
+                    res.vertexCount != static_cast<GLsizei>(vertices.size()) ||
+                    normals.size() != vertices.size();
+
+  if (!reallocate) {
+    // Same layout as last time: only stream the vertices that moved.
+    if (!delta.HasVertexChanges()) return;
+    GLintptr offset = delta.vertexBegin * sizeof(glm::vec3);
+    GLsizeiptr size = (delta.vertexEnd - delta.vertexBegin) * sizeof(glm::vec3);
+    glBindBuffer(GL_ARRAY_BUFFER, res.vboPositions);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size,
+                    vertices.data() + delta.vertexBegin);
+    glBindBuffer(GL_ARRAY_BUFFER, res.vboNormals);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size,
+                    normals.data() + delta.vertexBegin);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return;
+  }
 
-  GpuMeshResources& res = m_GpuResources[object->id];
+  uploadGpuMesh(res, meshData);
+  Log::Debug("Updated GPU mesh for object ID: ", object->id);
+}
 
+void OpenGLRenderer::uploadGpuMesh(GpuMeshResources& res,
+                                   const IEditableMesh& meshData) {
   if (res.vao == 0) {
     glGenVertexArrays(1, &res.vao);
     glGenBuffers(1, &res.vboPositions);
@@ -135,10 +246,11 @@ void OpenGLRenderer::updateGpuMesh(ISceneObject* object) {
     glGenBuffers(1, &res.ebo);
   }
 
-  res.indexCount = static_cast<GLsizei>(meshData->GetIndices().size());
-  const auto& vertices = meshData->GetVertices();
-  const auto& normals = meshData->GetNormals();
-  const auto& indices = meshData->GetIndices();
+  const auto& vertices = meshData.GetVertices();
+  const auto& normals = meshData.GetNormals();
+  const auto& indices = meshData.GetIndices();
+  res.vertexCount = static_cast<GLsizei>(vertices.size());
+  res.indexCount = static_cast<GLsizei>(indices.size());
 
   glBindVertexArray(res.vao);
   glBindBuffer(GL_ARRAY_BUFFER, res.vboPositions);
@@ -160,8 +272,6 @@ void OpenGLRenderer::updateGpuMesh(ISceneObject* object) {
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
                indices.data(), GL_STATIC_DRAW);
   glBindVertexArray(0);
-
-  Log::Debug("Updated GPU mesh for object ID: ", object->id);
 }
 
 void OpenGLRenderer::cleanupFramebuffers() {
@@ -174,16 +284,23 @@ void OpenGLRenderer::cleanupFramebuffers() {
 }
 
 void OpenGLRenderer::ClearAllGpuResources() {
-  for (auto& pair : m_GpuResources) {
-    pair.second.Release();
-  }
   m_GpuResources.clear();
+  m_SharedGpuMeshes.clear();
 }
 
 void OpenGLRenderer::Shutdown() {
   Log::Debug("OpenGLRenderer shutdown.");
+  m_GpuTimer.Shutdown();
+  m_PickingBuffer.Shutdown();
   cleanupFramebuffers();
 
+  if (m_CameraUBO != 0) glDeleteBuffers(1, &m_CameraUBO);
+  if (m_InstanceVBO != 0) glDeleteBuffers(1, &m_InstanceVBO);
+  m_CameraUBO = m_InstanceVBO = 0;
+  m_InstanceVBOSize = 0;
+  m_CameraUniforms = CameraUniforms{};
+  m_RenderQueue.Clear();
+
   ClearAllGpuResources();
 
   if (m_GizmoVAO != 0) glDeleteVertexArrays(1, &m_GizmoVAO);
@@ -234,8 +351,7 @@ void OpenGLRenderer::RenderSelectedFaces(
   if (faceVertices.empty()) return;
   m_LitShader->Bind();
   m_LitShader->SetUniformMat4f("u_Model", modelMatrix);
-  m_LitShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_LitShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   m_LitShader->SetUniformVec4("u_Color", SettingsManager::Get().selectedFacesColor);
   glDisable(GL_DEPTH_TEST);
   glEnable(GL_BLEND);
@@ -255,13 +371,12 @@ void OpenGLRenderer::RenderObjectAsGhost(const ISceneObject& object,
                                          const glm::vec4& color) {
   auto it = m_GpuResources.find(object.id);
   if (it == m_GpuResources.end()) return;
-  const GpuMeshResources& res = it->second;
+  const GpuMeshResources& res = *it->second;
   if (res.vao == 0 || res.indexCount == 0) return;
 
   m_UnlitShader->Bind();
   m_UnlitShader->SetUniformMat4f("u_Model", object.GetTransform());
-  m_UnlitShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_UnlitShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   m_UnlitShader->SetUniformVec4("u_Color", color);
 
   glEnable(GL_BLEND);
@@ -287,15 +402,23 @@ void OpenGLRenderer::RenderVertexHighlights(
     const IEditableMesh& mesh,
     const std::unordered_set<uint32_t>& selectedVertexIndices,
     const glm::mat4& modelMatrix, const Camera& camera) {
+  RenderVertexHighlights(mesh, selectedVertexIndices, modelMatrix, camera,
+                         SettingsManager::Get().vertexHighlightColor);
+}
+
+void OpenGLRenderer::RenderVertexHighlights(
+    const IEditableMesh& mesh,
+    const std::unordered_set<uint32_t>& selectedVertexIndices,
+    const glm::mat4& modelMatrix, const Camera& camera,
+    const glm::vec4& color) {
   if (selectedVertexIndices.empty() || !m_LitShader) return;
 
   glPointSize(10.0f);
   glDisable(GL_DEPTH_TEST);
   m_LitShader->Bind();
   m_LitShader->SetUniformMat4f("u_Model", modelMatrix);
-  m_LitShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_LitShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
-  m_LitShader->SetUniformVec4("u_Color", SettingsManager::Get().vertexHighlightColor);
+  uploadCamera(camera);
+  m_LitShader->SetUniformVec4("u_Color", color);
 
   std::vector<glm::vec3> points;
   const auto& vertices = mesh.GetVertices();
@@ -325,15 +448,24 @@ void OpenGLRenderer::RenderSelectedEdges(
     const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>&
         selectedEdges,
     const glm::mat4& modelMatrix, const Camera& camera) {
+  RenderSelectedEdges(mesh, selectedEdges, modelMatrix, camera,
+                      SettingsManager::Get().edgeHighlightColor);
+}
+
+void OpenGLRenderer::RenderSelectedEdges(
+    const IEditableMesh& mesh,
+    const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>&
+        selectedEdges,
+    const glm::mat4& modelMatrix, const Camera& camera,
+    const glm::vec4& color) {
   if (selectedEdges.empty() || !m_LitShader) return;
 
   glLineWidth(4.0f);
   glDisable(GL_DEPTH_TEST);
   m_LitShader->Bind();
   m_LitShader->SetUniformMat4f("u_Model", modelMatrix);
-  m_LitShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_LitShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
-  m_LitShader->SetUniformVec4("u_Color", SettingsManager::Get().edgeHighlightColor);
+  uploadCamera(camera);
+  m_LitShader->SetUniformVec4("u_Color", color);
 
   std::vector<glm::vec3> lines;
   const auto& vertices = mesh.GetVertices();
@@ -370,8 +502,7 @@ void OpenGLRenderer::RenderHighlightedPath(
   glDisable(GL_DEPTH_TEST);
   m_LitShader->Bind();
   m_LitShader->SetUniformMat4f("u_Model", modelMatrix);
-  m_LitShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_LitShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   m_LitShader->SetUniformVec4("u_Color", SettingsManager::Get().pathHighlightColor);
 
   std::vector<glm::vec3> lines;
@@ -406,6 +537,7 @@ void OpenGLRenderer::OnWindowResize(int width, int height) {
   m_Height = height;
   cleanupFramebuffers();
   createFramebuffers();
+  m_PickingBuffer.Resize(width, height);
 }
 
 void OpenGLRenderer::BeginFrame() {
@@ -423,13 +555,20 @@ void OpenGLRenderer::RenderUI() {
 }
 
 void OpenGLRenderer::BeginSceneFrame() {
+  m_GpuTimer.Begin("Scene");
+  // Whatever changed the scene image may have changed the IDs too.
+  m_PickingBuffer.Invalidate();
+  m_SceneRenderedThisFrame = true;
   glBindFramebuffer(GL_FRAMEBUFFER, m_SceneFBO);
   glViewport(0, 0, m_Width, m_Height);
   glClearColor(0.12f, 0.13f, 0.15f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void OpenGLRenderer::EndSceneFrame() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+void OpenGLRenderer::EndSceneFrame() {
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  m_GpuTimer.End();
+}
 
 void OpenGLRenderer::RenderObject(const ISceneObject& object,
                                   const Camera& camera) {
@@ -439,27 +578,129 @@ void OpenGLRenderer::RenderObject(const ISceneObject& object,
   auto it = m_GpuResources.find(object.id);
   if (it == m_GpuResources.end()) return;
 
-  const GpuMeshResources& res = it->second;
+  const GpuMeshResources& res = *it->second;
   if (res.vao == 0 || res.indexCount == 0) return;
 
   shader->Bind();
   shader->SetUniformMat4f("u_Model", object.GetTransform());
-  shader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  shader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   shader->SetUniformVec4("u_Color",
                          object.GetPropertySet().GetValue<glm::vec4>("Color"));
-  shader->SetUniformVec3("u_ViewPos", camera.GetPosition());
 
   glBindVertexArray(res.vao);
   glDrawElements(GL_TRIANGLES, res.indexCount, GL_UNSIGNED_INT, nullptr);
   glBindVertexArray(0);
 }
 
+void OpenGLRenderer::SubmitObject(const ISceneObject& object) {
+  auto shader = object.GetShader();
+  if (!shader) return;
+  auto it = m_GpuResources.find(object.id);
+  if (it == m_GpuResources.end()) return;
+  const GpuMeshResources& res = *it->second;
+  if (res.vao == 0 || res.indexCount == 0) return;
+
+  m_RenderQueue.Submit(
+      {shader.get(), &res, object.GetTransform(),
+       object.GetPropertySet().GetValue<glm::vec4>("Color")});
+}
+
+void OpenGLRenderer::FlushRenderQueue(const Camera& camera) {
+  if (m_RenderQueue.IsEmpty()) return;
+  PROFILE_SCOPE("FlushRenderQueue");
+  uploadCamera(camera);
+
+  const auto& batches = m_RenderQueue.Sort();
+  const auto& items = m_RenderQueue.GetItems();
+
+  // All instance data goes up in one upload; batches then point into it.
+  m_InstanceData.clear();
+  m_InstanceData.reserve(items.size());
+  for (const auto& item : items) m_InstanceData.push_back({item.model, item.color});
+  GLsizeiptr bytes = m_InstanceData.size() * sizeof(InstanceData);
+  glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+  if (bytes > m_InstanceVBOSize) {
+    m_InstanceVBOSize = bytes;
+    glBufferData(GL_ARRAY_BUFFER, bytes, m_InstanceData.data(), GL_STREAM_DRAW);
+  } else {
+    // Orphan the old storage so the GPU can keep reading last frame's copy.
+    glBufferData(GL_ARRAY_BUFFER, m_InstanceVBOSize, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_InstanceData.data());
+  }
+
+  const Shader* bound = nullptr;
+  for (const auto& batch : batches) {
+    glBindVertexArray(batch.mesh->vao);
+    if (batch.shader == m_LitShader.get() && m_LitInstancedShader) {
+      if (bound != m_LitInstancedShader.get()) {
+        m_LitInstancedShader->Bind();
+        bound = m_LitInstancedShader.get();
+      }
+      bindInstanceAttributes(batch.first);
+      glDrawElementsInstanced(GL_TRIANGLES, batch.mesh->indexCount,
+                              GL_UNSIGNED_INT, nullptr,
+                              static_cast<GLsizei>(batch.count));
+      continue;
+    }
+
+    // Custom shaders only know the per-draw uniforms.
+    if (bound != batch.shader) {
+      batch.shader->Bind();
+      bound = batch.shader;
+    }
+    for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+      batch.shader->SetUniformMat4f("u_Model", items[i].model);
+      batch.shader->SetUniformVec4("u_Color", items[i].color);
+      glDrawElements(GL_TRIANGLES, batch.mesh->indexCount, GL_UNSIGNED_INT,
+                     nullptr);
+    }
+  }
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  m_RenderQueue.Clear();
+}
+
+void OpenGLRenderer::bindInstanceAttributes(size_t firstInstance) {
+  // GL 3.3 has no base instance, so the attributes are re-pointed per batch.
+  // Expects the batch's VAO and m_InstanceVBO to be bound.
+  const GLsizei stride = sizeof(InstanceData);
+  const size_t base = firstInstance * sizeof(InstanceData);
+  for (GLuint column = 0; column < 4; ++column) {
+    GLuint attrib = kInstanceModelAttrib + column;
+    glEnableVertexAttribArray(attrib);
+    glVertexAttribPointer(
+        attrib, 4, GL_FLOAT, GL_FALSE, stride,
+        reinterpret_cast<void*>(base + column * sizeof(glm::vec4)));
+    glVertexAttribDivisor(attrib, 1);
+  }
+  glEnableVertexAttribArray(kInstanceColorAttrib);
+  glVertexAttribPointer(
+      kInstanceColorAttrib, 4, GL_FLOAT, GL_FALSE, stride,
+      reinterpret_cast<void*>(base + offsetof(InstanceData, color)));
+  glVertexAttribDivisor(kInstanceColorAttrib, 1);
+}
+
+void OpenGLRenderer::uploadCamera(const Camera& camera) {
+  CameraUniforms uniforms;
+  uniforms.view = camera.GetViewMatrix();
+  uniforms.projection = camera.GetProjectionMatrix();
+  uniforms.viewPos = glm::vec4(camera.GetPosition(), 1.0f);
+  if (uniforms.view == m_CameraUniforms.view &&
+      uniforms.projection == m_CameraUniforms.projection &&
+      uniforms.viewPos == m_CameraUniforms.viewPos) {
+    return;
+  }
+  m_CameraUniforms = uniforms;
+  glBindBuffer(GL_UNIFORM_BUFFER, m_CameraUBO);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraUniforms), &uniforms);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 void OpenGLRenderer::RenderObjectHighlight(const ISceneObject& object,
                                            const Camera& camera) {
   auto it = m_GpuResources.find(object.id);
   if (it == m_GpuResources.end()) return;
-  const GpuMeshResources& res = it->second;
+  const GpuMeshResources& res = *it->second;
   if (res.vao == 0 || res.indexCount == 0) return;
 
   glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -469,9 +710,7 @@ void OpenGLRenderer::RenderObjectHighlight(const ISceneObject& object,
 
   m_HighlightShader->Bind();
   m_HighlightShader->SetUniformMat4f("u_Model", object.GetTransform());
-  m_HighlightShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_HighlightShader->SetUniformMat4f("u_Projection",
-                                     camera.GetProjectionMatrix());
+  uploadCamera(camera);
   m_HighlightShader->SetUniform4f("u_Color", SettingsManager::Get().vertexHighlightColor);
 
   glBindVertexArray(res.vao);
@@ -489,13 +728,12 @@ void OpenGLRenderer::RenderObjectForPicking(const ISceneObject& object,
                                             const Camera& camera) {
   auto it = m_GpuResources.find(object.id);
   if (it == m_GpuResources.end()) return;
-  const GpuMeshResources& res = it->second;
+  const GpuMeshResources& res = *it->second;
   if (res.vao == 0 || res.indexCount == 0) return;
 
   pickingShader.Bind();
   pickingShader.SetUniformMat4f("u_Model", object.GetTransform());
-  pickingShader.SetUniformMat4f("u_View", camera.GetViewMatrix());
-  pickingShader.SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   pickingShader.SetUniform1ui("u_ObjectID", object.id);
 
   glBindVertexArray(res.vao);
@@ -508,8 +746,7 @@ void OpenGLRenderer::RenderGizmo(const TransformGizmo& gizmo,
   if (!gizmo.GetTarget() || gizmo.GetHandles().empty()) return;
 
   m_GizmoShader->Bind();
-  m_GizmoShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_GizmoShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
 
   float distance =
       glm::length(camera.GetPosition() - gizmo.GetTarget()->GetPosition());
@@ -539,8 +776,7 @@ void OpenGLRenderer::RenderGrid(const Grid& grid, const Camera& camera) {
 
   m_GridShader->Bind();
   m_GridShader->SetUniformMat4f("u_Model", grid.GetTransform());
-  m_GridShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_GridShader->SetUniformMat4f("u_Projection", camera.GetProjectionMatrix());
+  uploadCamera(camera);
   m_GridShader->SetUniform4f("u_Color", 0.3f, 0.3f, 0.3f, 1.0f);
 
   glBindVertexArray(m_GridVAO);
@@ -551,17 +787,13 @@ void OpenGLRenderer::RenderGrid(const Grid& grid, const Camera& camera) {
 // --- Picking Implementations ---
 uint32_t OpenGLRenderer::ProcessPicking(int x, int y, const Scene& scene,
                                         const Camera& camera) {
+  PROFILE_SCOPE("ProcessPicking");
+  GpuZone gpuZone(m_GpuTimer, "Picking");
   glBindFramebuffer(GL_FRAMEBUFFER, m_PickingFBO);
   glViewport(0, 0, m_Width, m_Height);
   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-  for (const auto& object : scene.GetSceneObjects()) {
-    if (object->isSelectable) {
-      object->DrawForPicking(*m_PickingShader, camera.GetViewMatrix(),
-                             camera.GetProjectionMatrix());
-    }
-  }
+  drawPickingIds(scene, camera);
 
   glReadBuffer(GL_COLOR_ATTACHMENT0);
   uint32_t objectID = 0;
@@ -575,16 +807,36 @@ uint32_t OpenGLRenderer::ProcessGizmoPicking(int x, int y,
                                              const TransformGizmo& gizmo,
                                              const Camera& camera) {
   if (!gizmo.GetTarget()) return 0;
+  PROFILE_SCOPE("ProcessGizmoPicking");
+  GpuZone gpuZone(m_GpuTimer, "Gizmo Picking");
 
   glBindFramebuffer(GL_FRAMEBUFFER, m_PickingFBO);
   glViewport(0, 0, m_Width, m_Height);
   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  drawGizmoPickingIds(gizmo, camera);
+
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  uint32_t objectID = 0;
+  glReadPixels(x, m_Height - y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT,
+               &objectID);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  return objectID;
+}
+
+void OpenGLRenderer::drawPickingIds(const Scene& scene, const Camera& camera) {
+  for (const auto& object : scene.GetSceneObjects()) {
+    if (object->isSelectable) {
+      object->DrawForPicking(*m_PickingShader, camera.GetViewMatrix(),
+                             camera.GetProjectionMatrix());
+    }
+  }
+}
 
+void OpenGLRenderer::drawGizmoPickingIds(const TransformGizmo& gizmo,
+                                         const Camera& camera) {
   m_PickingShader->Bind();
-  m_PickingShader->SetUniformMat4f("u_View", camera.GetViewMatrix());
-  m_PickingShader->SetUniformMat4f("u_Projection",
-                                   camera.GetProjectionMatrix());
+  uploadCamera(camera);
 
   float distance =
       glm::length(camera.GetPosition() - gizmo.GetTarget()->GetPosition());
@@ -599,13 +851,50 @@ uint32_t OpenGLRenderer::ProcessGizmoPicking(int x, int y,
     glDrawElements(GL_TRIANGLES, m_GizmoIndexCount, GL_UNSIGNED_INT, 0);
   }
   glBindVertexArray(0);
+}
 
-  glReadBuffer(GL_COLOR_ATTACHMENT0);
-  uint32_t objectID = 0;
-  glReadPixels(x, m_Height - y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT,
-               &objectID);
+void OpenGLRenderer::UpdatePicking(const Scene& scene, const Camera& camera,
+                                   const TransformGizmo* gizmo) {
+  PROFILE_SCOPE("UpdatePicking");
+  m_PickingBuffer.Poll();
+  bool sceneSettled = !m_SceneRenderedThisFrame;
+  m_SceneRenderedThisFrame = false;
+
+  // While the camera or scene keeps changing, every redraw would be thrown
+  // away; wait for a quiet frame unless a click is waiting for an answer.
+  if (!m_PickingBuffer.NeedsReadback() ||
+      !(sceneSettled || m_PickingBuffer.HasPendingQueries())) {
+    return;
+  }
+
+  GpuZone gpuZone(m_GpuTimer, "Async Picking");
+  glBindFramebuffer(GL_FRAMEBUFFER, m_PickingFBO);
+  glViewport(0, 0, m_Width, m_Height);
+  glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  drawPickingIds(scene, camera);
+  if (gizmo && gizmo->GetTarget()) {
+    // Handles are picked before the objects behind them, as in sync mode.
+    glClear(GL_DEPTH_BUFFER_BIT);
+    drawGizmoPickingIds(*gizmo, camera);
+  }
+  m_PickingBuffer.BeginReadback();
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
-  return objectID;
+}
+
+void OpenGLRenderer::RequestPick(int x, int y, PickCallback callback) {
+  m_PickingBuffer.Enqueue(
+      [x, y, callback = std::move(callback)](const PickIdImage& image) {
+        callback(image.At(x, y));
+      });
+}
+
+void OpenGLRenderer::RequestPickRect(int x0, int y0, int x1, int y1,
+                                     PickRectCallback callback) {
+  m_PickingBuffer.Enqueue([x0, y0, x1, y1, callback = std::move(callback)](
+                              const PickIdImage& image) {
+    callback(image.CollectRect(x0, y0, x1, y1, TransformGizmo::IsGizmoID));
+  });
 }
 void OpenGLRenderer::createFramebuffers() {
   glGenTextures(1, &m_DepthTexture);
@@ -2,12 +2,16 @@
 #include <glad/glad.h>
 
 #include <cstdint>
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Renderer/GpuTimer.h"
+#include "Renderer/PickingBuffer.h"
+#include "Renderer/RenderQueue.h"
 #include "Sculpting/SubObjectSelection.h"
 
 class Scene;
@@ -25,6 +29,10 @@ struct GpuMeshResources {
   GLuint vboNormals = 0;
   GLuint ebo = 0;
   GLsizei indexCount = 0;
+  GLsizei vertexCount = 0;  // Size the vertex buffers were allocated for
+  // Uploaded from a MeshCache mesh and drawn by every object using it; never
+  // updated in place.
+  bool shared = false;
 
   void Release() {
     if (vao != 0) {
@@ -33,7 +41,7 @@ struct GpuMeshResources {
       if (vboNormals != 0) glDeleteBuffers(1, &vboNormals);
       glDeleteVertexArrays(1, &vao);
     }
-    vao = vboPositions = vboNormals = ebo = indexCount = 0;
+    vao = vboPositions = vboNormals = ebo = indexCount = vertexCount = 0;
   }
 };
 
@@ -55,6 +63,12 @@ class OpenGLRenderer {
   void EndSceneFrame();
 
   void RenderObject(const ISceneObject& object, const Camera& camera);
+  /**
+   * @brief Queues an object for FlushRenderQueue. Objects sharing a mesh and
+   * the lit shader are drawn with one instanced call.
+   */
+  void SubmitObject(const ISceneObject& object);
+  void FlushRenderQueue(const Camera& camera);
   void RenderObjectForPicking(const ISceneObject& object, Shader& pickingShader,
                               const Camera& camera);
   void RenderObjectHighlight(const ISceneObject& object, const Camera& camera);
@@ -71,6 +85,11 @@ class OpenGLRenderer {
       const IEditableMesh& mesh,
       const std::unordered_set<uint32_t>& selectedVertexIndices,
       const glm::mat4& modelMatrix, const Camera& camera);
+  void RenderVertexHighlights(
+      const IEditableMesh& mesh,
+      const std::unordered_set<uint32_t>& selectedVertexIndices,
+      const glm::mat4& modelMatrix, const Camera& camera,
+      const glm::vec4& color);
   void RenderObjectAsGhost(const ISceneObject& object, const Camera& camera,
                            const glm::vec4& color);
   void RenderSelectedEdges(
@@ -78,6 +97,12 @@ class OpenGLRenderer {
       const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>&
           selectedEdges,
       const glm::mat4& modelMatrix, const Camera& camera);
+  void RenderSelectedEdges(
+      const IEditableMesh& mesh,
+      const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>&
+          selectedEdges,
+      const glm::mat4& modelMatrix, const Camera& camera,
+      const glm::vec4& color);
 
   void RenderSelectedFaces(const IEditableMesh& mesh,
                            const std::unordered_set<uint32_t>& selectedFaces,
@@ -89,6 +114,24 @@ class OpenGLRenderer {
   uint32_t ProcessGizmoPicking(int x, int y, const TransformGizmo& gizmo,
                                const Camera& camera);
 
+  // --- Async Picking ---
+  // Object and gizmo IDs are drawn into one buffer that is read back without
+  // stalling and cached until the next scene pass. Requests are answered
+  // immediately while the cache is current, otherwise a few frames later.
+  using PickCallback = std::function<void(uint32_t id)>;
+  using PickRectCallback = std::function<void(const std::vector<uint32_t>& ids)>;
+
+  /**
+   * @brief Call once per frame, after the scene pass. Gizmo handles are
+   * only pickable when a gizmo is passed.
+   */
+  void UpdatePicking(const Scene& scene, const Camera& camera,
+                     const TransformGizmo* gizmo);
+  void RequestPick(int x, int y, PickCallback callback);
+  /** @brief Selectable object IDs (no gizmo handles) inside a rectangle. */
+  void RequestPickRect(int x0, int y0, int x1, int y1,
+                       PickRectCallback callback);
+
   // --- UI Rendering ---
   void RenderUI();
 
@@ -98,10 +141,14 @@ class OpenGLRenderer {
 
   void ClearAllGpuResources();
 
-  std::unordered_map<uint32_t, GpuMeshResources>& GetGpuResources() {
+  std::unordered_map<uint32_t, std::shared_ptr<GpuMeshResources>>&
+  GetGpuResources() {
     return m_GpuResources;
   }
 
+  // --- Profiling ---
+  GpuTimer& GetGpuTimer() { return m_GpuTimer; }
+
  private:
   void createFramebuffers();
   void cleanupFramebuffers();
@@ -109,6 +156,14 @@ class OpenGLRenderer {
   void createAnchorMesh();
   void createGridResources(const Grid& grid);
   void updateGpuMesh(ISceneObject* object);
+  void uploadGpuMesh(GpuMeshResources& res, const IEditableMesh& meshData);
+  void attachSharedGpuMesh(const ISceneObject& object,
+                           const std::shared_ptr<const IEditableMesh>& mesh);
+  void drawPickingIds(const Scene& scene, const Camera& camera);
+  // Updates the Camera uniform block if the camera moved since last time.
+  void uploadCamera(const Camera& camera);
+  void bindInstanceAttributes(size_t firstInstance);
+  void drawGizmoPickingIds(const TransformGizmo& gizmo, const Camera& camera);
 
   GLFWwindow* m_Window;
   int m_Width, m_Height;
@@ -120,6 +175,7 @@ class OpenGLRenderer {
 
   // Shaders
   std::shared_ptr<Shader> m_PickingShader;
+  std::shared_ptr<Shader> m_LitInstancedShader;
   std::shared_ptr<Shader> m_HighlightShader;
   std::shared_ptr<Shader> m_UnlitShader;
   std::shared_ptr<Shader> m_GizmoShader;
@@ -128,7 +184,15 @@ class OpenGLRenderer {
   std::shared_ptr<Shader> m_LitShader;
 
   // Mesh Data & GPU Buffers
-  std::unordered_map<uint32_t, GpuMeshResources> m_GpuResources;
+  std::unordered_map<uint32_t, std::shared_ptr<GpuMeshResources>> m_GpuResources;
+  uint64_t m_SceneChangeCursor = 0;  // Position in the synced scene's change log
+  // One upload per cached mesh, keyed by the mesh it came from. Both sides
+  // are weak so the entry dies with its last user.
+  struct SharedGpuMesh {
+    std::weak_ptr<const IEditableMesh> mesh;
+    std::weak_ptr<GpuMeshResources> gpu;
+  };
+  std::unordered_map<const IEditableMesh*, SharedGpuMesh> m_SharedGpuMeshes;
   GLuint m_SelectedEdgesVAO = 0, m_SelectedEdgesVBO = 0;
 
   // Gizmo Resources
@@ -146,4 +210,26 @@ class OpenGLRenderer {
   GLuint m_SelectedFacesVAO = 0, m_SelectedFacesVBO = 0;
   GLuint m_SelectedVerticesVAO = 0, m_SelectedVerticesVBO = 0;
   GLuint m_HighlightedPathVAO = 0, m_HighlightedPathVBO = 0;
+
+  // Per-frame uniforms and batched submission
+  struct CameraUniforms {
+    glm::mat4 view{0.0f};
+    glm::mat4 projection{0.0f};
+    glm::vec4 viewPos{0.0f};
+  };
+  struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+  };
+  GLuint m_CameraUBO = 0;
+  CameraUniforms m_CameraUniforms;
+  RenderQueue m_RenderQueue;
+  GLuint m_InstanceVBO = 0;
+  GLsizeiptr m_InstanceVBOSize = 0;
+  std::vector<InstanceData> m_InstanceData;
+
+  GpuTimer m_GpuTimer;
+
+  PickingBuffer m_PickingBuffer;
+  bool m_SceneRenderedThisFrame = false;
 };
\ No newline at end of file
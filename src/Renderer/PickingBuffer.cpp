@@ -0,0 +1,160 @@
+#include "Renderer/PickingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+
+#include "Core/Log.h"
+
+std::vector<uint32_t> PickIdImage::CollectRect(
+    int x0, int y0, int x1, int y1,
+    const std::function<bool(uint32_t)>& skip) const {
+  std::vector<uint32_t> result;
+  if (width == 0 || height == 0) return result;
+  int minX = std::clamp(std::min(x0, x1), 0, width - 1);
+  int maxX = std::clamp(std::max(x0, x1), 0, width - 1);
+  int minY = std::clamp(std::min(y0, y1), 0, height - 1);
+  int maxY = std::clamp(std::max(y0, y1), 0, height - 1);
+
+  std::unordered_set<uint32_t> seen;
+  for (int y = minY; y <= maxY; ++y) {
+    const uint32_t* row = ids.data() + static_cast<size_t>(height - 1 - y) * width;
+    uint32_t last = 0;  // Runs of the same ID are common; skip the set lookup
+    for (int x = minX; x <= maxX; ++x) {
+      uint32_t id = row[x];
+      if (id == 0 || id == last) continue;
+      last = id;
+      if ((!skip || !skip(id)) && seen.insert(id).second) result.push_back(id);
+    }
+  }
+  return result;
+}
+
+void PickQueryQueue::Invalidate() {
+  m_Current = false;
+  ++m_Generation;
+}
+
+void PickQueryQueue::Reset() {
+  m_Image = PickIdImage{};
+  m_Current = false;
+  m_InFlight = false;
+  m_Pending.clear();
+}
+
+void PickQueryQueue::BeginReadback() {
+  m_InFlight = true;
+  m_ReadbackGeneration = m_Generation;
+  ++m_ReadbackSerial;
+}
+
+void PickQueryQueue::DropReadback() {
+  m_InFlight = false;
+  for (auto& pending : m_Pending) pending.readbackSerial = m_ReadbackSerial + 1;
+}
+
+void PickQueryQueue::CompleteReadback(PickIdImage& image) {
+  m_InFlight = false;
+  std::swap(m_Image, image);
+  m_Current = m_ReadbackGeneration == m_Generation;
+
+  // Answering a query may enqueue another, so work on a swapped-out list.
+  std::vector<PendingQuery> pending;
+  pending.swap(m_Pending);
+  for (auto& entry : pending) {
+    if (entry.readbackSerial <= m_ReadbackSerial) {
+      entry.query(m_Image);
+    } else {
+      m_Pending.push_back(std::move(entry));
+    }
+  }
+}
+
+void PickQueryQueue::Enqueue(Query query) {
+  if (m_Current) {
+    query(m_Image);
+    return;
+  }
+  // A readback already in flight still shows this scene if nothing was
+  // invalidated since it started.
+  bool inFlightIsCurrent = m_InFlight && m_ReadbackGeneration == m_Generation;
+  m_Pending.push_back(
+      {std::move(query), inFlightIsCurrent ? m_ReadbackSerial : m_ReadbackSerial + 1});
+}
+
+void PickingBuffer::Initialize() { glGenBuffers(1, &m_Pbo); }
+
+void PickingBuffer::Shutdown() {
+  if (m_Fence) glDeleteSync(m_Fence);
+  m_Fence = nullptr;
+  if (m_Pbo != 0) glDeleteBuffers(1, &m_Pbo);
+  m_Pbo = 0;
+  m_Width = m_Height = 0;
+  m_Staging = PickIdImage{};
+  m_Queries.Reset();
+}
+
+void PickingBuffer::Resize(int width, int height) {
+  if (m_Fence) {
+    glDeleteSync(m_Fence);
+    m_Fence = nullptr;
+  }
+  m_Width = width;
+  m_Height = height;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Pbo);
+  glBufferData(GL_PIXEL_PACK_BUFFER,
+               static_cast<GLsizeiptr>(width) * height * sizeof(uint32_t),
+               nullptr, GL_STREAM_READ);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  m_Queries.DropReadback();
+  m_Queries.Invalidate();
+}
+
+void PickingBuffer::BeginReadback() {
+  if (m_Pbo == 0 || m_Fence || m_Width == 0 || m_Height == 0) return;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Pbo);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glReadPixels(0, 0, m_Width, m_Height, GL_RED_INTEGER, GL_UNSIGNED_INT,
+               nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  // Make sure the fence reaches the GPU, or polling it could never succeed.
+  glFlush();
+  m_Queries.BeginReadback();
+}
+
+void PickingBuffer::Poll() {
+  if (!m_Fence) return;
+  GLenum status = glClientWaitSync(m_Fence, 0, 0);
+  if (status == GL_WAIT_FAILED) {
+    // The fence will never signal; give its queries to the next readback
+    // instead of blocking all of them behind it.
+    Log::Debug("ERROR: Picking readback fence wait failed, dropping it.");
+    glDeleteSync(m_Fence);
+    m_Fence = nullptr;
+    m_Queries.DropReadback();
+    return;
+  }
+  if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+  glDeleteSync(m_Fence);
+  m_Fence = nullptr;
+
+  size_t count = static_cast<size_t>(m_Width) * m_Height;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Pbo);
+  const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                        count * sizeof(uint32_t), GL_MAP_READ_BIT);
+  if (mapped) {
+    m_Staging.width = m_Width;
+    m_Staging.height = m_Height;
+    m_Staging.ids.resize(count);
+    std::memcpy(m_Staging.ids.data(), mapped, count * sizeof(uint32_t));
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (mapped) {
+    m_Queries.CompleteReadback(m_Staging);
+  } else {
+    m_Queries.DropReadback();
+  }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief CPU copy of the picking framebuffer: one object ID per pixel, 0 for
+ * background. Rows are stored bottom-up as GL reads them; queries take
+ * viewport coordinates with the origin at the top-left.
+ */
+struct PickIdImage {
+  int width = 0;
+  int height = 0;
+  std::vector<uint32_t> ids;
+
+  uint32_t At(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+    return ids[static_cast<size_t>(height - 1 - y) * width + x];
+  }
+
+  /**
+   * @brief Unique IDs inside the rectangle spanned by two corners (inclusive,
+   * any order, clamped to the image), in first-seen order. IDs for which
+   * `skip` returns true are left out.
+   */
+  std::vector<uint32_t> CollectRect(
+      int x0, int y0, int x1, int y1,
+      const std::function<bool(uint32_t)>& skip = nullptr) const;
+};
+
+/**
+ * @brief Decides which readback may answer which pick query, independent of
+ * how the pixels get to the CPU.
+ *
+ * Invalidate() bumps a generation counter; a completed readback only becomes
+ * the current image if no invalidation happened since it was started. Each
+ * query remembers the serial of the first readback allowed to answer it, so a
+ * query made after the scene changed is never answered by an older readback
+ * that was still in flight.
+ */
+class PickQueryQueue {
+ public:
+  using Query = std::function<void(const PickIdImage&)>;
+
+  void Invalidate();
+  /** @brief Forgets the image and all waiting queries. */
+  void Reset();
+
+  bool IsCurrent() const { return m_Current; }
+  bool IsReadbackInFlight() const { return m_InFlight; }
+  bool HasPendingQueries() const { return !m_Pending.empty(); }
+  const PickIdImage& GetImage() const { return m_Image; }
+
+  /** @brief Records that a readback of the scene as it is now has started. */
+  void BeginReadback();
+  /** @brief The in-flight readback will never land; its queries wait for the next. */
+  void DropReadback();
+  /**
+   * @brief Takes the image of the in-flight readback and answers every query
+   * it is allowed to. The previous image is swapped back into `image` so its
+   * storage can be reused.
+   */
+  void CompleteReadback(PickIdImage& image);
+  void Enqueue(Query query);
+
+ private:
+  struct PendingQuery {
+    Query query;
+    uint64_t readbackSerial;  // First readback allowed to answer it
+  };
+
+  PickIdImage m_Image;
+  bool m_Current = false;
+  bool m_InFlight = false;
+  // Bumped by Invalidate(); a readback is only current if none happened
+  // since it was started.
+  uint64_t m_Generation = 0;
+  uint64_t m_ReadbackGeneration = 0;
+  // Number of readbacks started so far; the in-flight one has this serial.
+  uint64_t m_ReadbackSerial = 0;
+  std::vector<PendingQuery> m_Pending;
+};
+
+/**
+ * @brief Asynchronous readback of the picking framebuffer.
+ *
+ * The whole ID buffer is copied into a pixel buffer object and fenced; Poll()
+ * maps it on a later frame, once the fence has signalled, so the CPU never
+ * waits on the GPU. The CPU copy stays valid until Invalidate() is called
+ * (the scene or camera changed), and every query against a valid copy is
+ * answered immediately. Queries made while it is stale wait for the first
+ * readback that reflects the scene as it was when they were made.
+ */
+class PickingBuffer {
+ public:
+  using Query = PickQueryQueue::Query;
+
+  void Initialize();
+  void Shutdown();
+
+  /** @brief Reallocates for a new framebuffer size and drops the CPU copy. */
+  void Resize(int width, int height);
+  void Invalidate() { m_Queries.Invalidate(); }
+
+  /** @brief True when a new readback should be started this frame. */
+  bool NeedsReadback() const { return !m_Queries.IsCurrent() && !m_Fence; }
+  bool HasPendingQueries() const { return m_Queries.HasPendingQueries(); }
+  bool IsCurrent() const { return m_Queries.IsCurrent(); }
+  const PickIdImage& GetImage() const { return m_Queries.GetImage(); }
+
+  /** @brief Starts copying the currently bound read framebuffer. */
+  void BeginReadback();
+  /** @brief Collects a finished readback and answers waiting queries. */
+  void Poll();
+  void Enqueue(Query query) { m_Queries.Enqueue(std::move(query)); }
+
+ private:
+  GLuint m_Pbo = 0;
+  GLsync m_Fence = nullptr;
+  int m_Width = 0, m_Height = 0;
+  PickIdImage m_Staging;
+  PickQueryQueue m_Queries;
+};
@@ -0,0 +1,32 @@
+#include "Renderer/RenderQueue.h"
+
+#include <algorithm>
+#include <functional>
+
+void RenderQueue::Clear() {
+  m_Items.clear();
+  m_Batches.clear();
+}
+
+const std::vector<RenderQueue::Batch>& RenderQueue::Sort() {
+  // std::less gives pointers a total order; only grouping matters here.
+  std::stable_sort(m_Items.begin(), m_Items.end(),
+                   [](const RenderItem& a, const RenderItem& b) {
+                     if (a.shader != b.shader) {
+                       return std::less<Shader*>()(a.shader, b.shader);
+                     }
+                     return std::less<const GpuMeshResources*>()(a.mesh, b.mesh);
+                   });
+
+  m_Batches.clear();
+  for (size_t i = 0; i < m_Items.size(); ++i) {
+    const RenderItem& item = m_Items[i];
+    if (!m_Batches.empty() && m_Batches.back().shader == item.shader &&
+        m_Batches.back().mesh == item.mesh) {
+      ++m_Batches.back().count;
+    } else {
+      m_Batches.push_back({item.shader, item.mesh, i, 1});
+    }
+  }
+  return m_Batches;
+}
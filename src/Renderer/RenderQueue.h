@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Shader;
+struct GpuMeshResources;
+
+/** @brief One mesh draw collected for the current frame. */
+struct RenderItem {
+  Shader* shader = nullptr;
+  const GpuMeshResources* mesh = nullptr;
+  glm::mat4 model{1.0f};
+  glm::vec4 color{1.0f};
+};
+
+/**
+ * @brief Collects the frame's object draws so they can be submitted grouped
+ * by shader and mesh: each group binds its state once and can be drawn as a
+ * single instanced call.
+ */
+class RenderQueue {
+ public:
+  /** @brief A run of items sharing shader and mesh, in the sorted items. */
+  struct Batch {
+    Shader* shader;
+    const GpuMeshResources* mesh;
+    size_t first;
+    size_t count;
+  };
+
+  void Submit(const RenderItem& item) { m_Items.push_back(item); }
+  void Clear();
+
+  /**
+   * @brief Sorts the items by shader, then mesh, keeping submission order
+   * within a group, and returns the groups.
+   */
+  const std::vector<Batch>& Sort();
+
+  const std::vector<RenderItem>& GetItems() const { return m_Items; }
+  bool IsEmpty() const { return m_Items.empty(); }
+
+ private:
+  std::vector<RenderItem> m_Items;
+  std::vector<Batch> m_Batches;
+};
@@ -0,0 +1,61 @@
+#include "Scene/MeshCache.h"
+
+#include <algorithm>
+
+MeshCache& MeshCache::Get() {
+  static MeshCache instance;
+  return instance;
+}
+
+std::shared_ptr<SculptableMesh> MeshCache::Acquire(const std::string& key,
+                                                   const Builder& build) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Entries.find(key);
+    if (it != m_Entries.end()) {
+      if (auto mesh = it->second.lock()) return mesh;
+    }
+  }
+
+  // Build outside the lock; if another thread got there first, use theirs.
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  build(vertices, indices);
+  auto mesh = std::make_shared<SculptableMesh>();
+  mesh->Initialize(vertices, indices);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto& entry = m_Entries[key];
+  if (auto existing = entry.lock()) return existing;
+  entry = mesh;
+  if (m_Entries.size() >= m_PruneThreshold) pruneExpired();
+  return mesh;
+}
+
+std::shared_ptr<SculptableMesh> MeshCache::Adopt(
+    const std::string& key, std::shared_ptr<SculptableMesh> mesh) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto& entry = m_Entries[key];
+  if (auto existing = entry.lock()) return existing;
+  entry = mesh;
+  if (m_Entries.size() >= m_PruneThreshold) pruneExpired();
+  return mesh;
+}
+
+std::shared_ptr<SculptableMesh> MeshCache::Find(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = m_Entries.find(key);
+  return it != m_Entries.end() ? it->second.lock() : nullptr;
+}
+
+size_t MeshCache::GetLiveCount() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return std::count_if(m_Entries.begin(), m_Entries.end(),
+                       [](const auto& entry) { return !entry.second.expired(); });
+}
+
+void MeshCache::pruneExpired() {
+  std::erase_if(m_Entries,
+                [](const auto& entry) { return entry.second.expired(); });
+  m_PruneThreshold = std::max<size_t>(64, m_Entries.size() * 2);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Sculpting/SculptableMesh.h"
+
+/**
+ * @brief Process-wide cache of procedurally built meshes, keyed by the
+ * object type and the properties the mesh is built from.
+ *
+ * Objects with the same key share one SculptableMesh and treat it as
+ * immutable; an object that wants to edit its mesh takes a private copy
+ * first. Entries are held weakly and die with their last user.
+ */
+class MeshCache {
+ public:
+  using Builder =
+      std::function<void(std::vector<float>&, std::vector<unsigned int>&)>;
+
+  static MeshCache& Get();
+
+  /** @brief Returns the mesh for `key`, building it with `build` on a miss. */
+  std::shared_ptr<SculptableMesh> Acquire(const std::string& key,
+                                          const Builder& build);
+
+  /**
+   * @brief Makes `mesh` the entry for `key` unless a live one exists.
+   * @return The entry for `key` afterwards.
+   */
+  std::shared_ptr<SculptableMesh> Adopt(const std::string& key,
+                                        std::shared_ptr<SculptableMesh> mesh);
+
+  /** @brief The live entry for `key`, or nullptr. Never builds. */
+  std::shared_ptr<SculptableMesh> Find(const std::string& key) const;
+
+  /** @brief Number of distinct meshes currently alive. */
+  size_t GetLiveCount() const;
+
+ private:
+  void pruneExpired();
+
+  mutable std::mutex m_Mutex;
+  std::unordered_map<std::string, std::weak_ptr<SculptableMesh>> m_Entries;
+  size_t m_PruneThreshold = 64;
+};
@@ -0,0 +1,76 @@
+#include "Scene/MeshRebuildScheduler.h"
+
+#include "Core/Profiler.h"
+
+bool MeshRebuildScheduler::Job::Cancel() {
+  State queued = State::Queued;
+  return m_State.compare_exchange_strong(queued, State::Cancelled);
+}
+
+MeshRebuildScheduler& MeshRebuildScheduler::Get() {
+  static MeshRebuildScheduler s_Instance;
+  return s_Instance;
+}
+
+MeshRebuildScheduler::MeshRebuildScheduler()
+    : m_Worker(&MeshRebuildScheduler::workerLoop, this) {}
+
+MeshRebuildScheduler::~MeshRebuildScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_WorkAvailable.notify_all();
+  m_Worker.join();
+}
+
+std::shared_ptr<MeshRebuildScheduler::Job> MeshRebuildScheduler::Schedule(
+    Builder build) {
+  auto job = std::make_shared<Job>();
+  job->m_Build = std::move(build);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Queue.push_back(job);
+  }
+  m_WorkAvailable.notify_one();
+  return job;
+}
+
+void MeshRebuildScheduler::WaitIdle() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Idle.wait(lock, [this] { return m_Queue.empty() && m_Running == 0; });
+}
+
+void MeshRebuildScheduler::workerLoop() {
+  Profiler::Get().SetThreadName("Mesh Rebuild");
+  for (;;) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WorkAvailable.wait(lock,
+                           [this] { return m_Stopping || !m_Queue.empty(); });
+      if (m_Stopping) return;
+      job = std::move(m_Queue.front());
+      m_Queue.pop_front();
+      ++m_Running;
+    }
+
+    Job::State queued = Job::State::Queued;
+    if (job->m_State.compare_exchange_strong(queued, Job::State::Running)) {
+      PROFILE_SCOPE("RebuildMesh");
+      std::vector<float> vertices;
+      std::vector<unsigned int> indices;
+      job->m_Build(vertices, indices);
+      auto mesh = std::make_shared<SculptableMesh>();
+      mesh->Initialize(vertices, indices);
+      job->m_Build = nullptr;
+      job->m_Result = std::move(mesh);
+      ++m_BuildCount;
+      job->m_State.store(Job::State::Done);
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    --m_Running;
+    if (m_Queue.empty() && m_Running == 0) m_Idle.notify_all();
+  }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Sculpting/SculptableMesh.h"
+
+/**
+ * @brief Background thread that builds procedural meshes while the object
+ * keeps showing its previous one.
+ *
+ * Objects hand in a builder that owns a snapshot of everything it reads and
+ * poll the returned job from the main thread; a finished job's mesh is
+ * swapped in by its object, never by the scheduler. While disabled (the
+ * default, and in headless tools) objects build synchronously instead.
+ */
+class MeshRebuildScheduler {
+ public:
+  using Builder =
+      std::function<void(std::vector<float>&, std::vector<unsigned int>&)>;
+
+  class Job {
+   public:
+    /** @brief True once the mesh is built; safe to call from any thread. */
+    bool IsDone() const { return m_State.load() == State::Done; }
+    /** @brief The built mesh. Only valid once IsDone(). */
+    std::shared_ptr<SculptableMesh> TakeResult() { return std::move(m_Result); }
+    /**
+     * @brief Skips the build if it has not started yet.
+     * @return False if it is already running or done.
+     */
+    bool Cancel();
+
+    // MeshCache key the result belongs under, or empty.
+    std::string cacheKey;
+
+   private:
+    friend class MeshRebuildScheduler;
+    enum class State { Queued, Running, Done, Cancelled };
+
+    Builder m_Build;
+    std::shared_ptr<SculptableMesh> m_Result;
+    std::atomic<State> m_State{State::Queued};
+  };
+
+  static MeshRebuildScheduler& Get();
+
+  MeshRebuildScheduler();
+  ~MeshRebuildScheduler();
+
+  MeshRebuildScheduler(const MeshRebuildScheduler&) = delete;
+  MeshRebuildScheduler& operator=(const MeshRebuildScheduler&) = delete;
+
+  void SetEnabled(bool enabled) { m_Enabled = enabled; }
+  bool IsEnabled() const { return m_Enabled; }
+
+  /** @brief Queues a build. The builder runs on the scheduler's thread. */
+  std::shared_ptr<Job> Schedule(Builder build);
+
+  /** @brief Blocks until every queued job has finished or been skipped. */
+  void WaitIdle();
+
+  /** @brief Number of meshes built so far. */
+  size_t GetBuildCount() const { return m_BuildCount.load(); }
+
+ private:
+  void workerLoop();
+
+  std::atomic<bool> m_Enabled{false};
+  std::atomic<size_t> m_BuildCount{0};
+  std::deque<std::shared_ptr<Job>> m_Queue;
+  size_t m_Running = 0;
+  std::mutex m_Mutex;
+  std::condition_variable m_WorkAvailable;
+  std::condition_variable m_Idle;
+  bool m_Stopping = false;
+  std::thread m_Worker;  // Last, so it starts after everything it uses
+};
@@ -1,8 +1,10 @@
 #include "Scene/Objects/BaseObject.h"
 
+#include <cstring>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/quaternion.hpp> 
+#include <utility>
 
 #include "Core/Application.h"
 #include "Core/JsonGlmHelpers.h"
@@ -10,10 +12,11 @@
 #include "Core/PropertyNames.h"
 #include "Core/ResourceManager.h"
 #include "Renderer/OpenGLRenderer.h"
+#include "Scene/MeshCache.h"
 #include "Shader.h"
 
 BaseObject::BaseObject() {
-  m_SculptableMesh = std::make_unique<SculptableMesh>();
+  m_SculptableMesh = std::make_shared<SculptableMesh>();
   m_Shader = ResourceManager::LoadShader("lit_shader", "shaders/lit.vert",
                                          "shaders/lit.frag");
 
@@ -35,25 +38,257 @@ BaseObject::BaseObject() {
                    onRenderStateChanged);
 }
 
-BaseObject::~BaseObject() = default;
+BaseObject::~BaseObject() {
+  if (m_RebuildJob) m_RebuildJob->Cancel();
+}
 
 void BaseObject::RebuildMesh() {
-  std::vector<float> verts;
-  std::vector<unsigned int> inds;
-  BuildMeshData(verts, inds);
+  m_Multires.reset();
+  m_SubdivisionLevel = 0;
+  m_MeshBuildPending = true;
+  ++m_MeshRebuildCount;
+  m_IsMeshDirty = true;
+
+  m_IsTransformDirty = true;
+  Application::Get().RequestSceneRender();
+}
 
-  if (m_SculptableMesh) {
+void BaseObject::ensureMeshBuilt(bool allowAsync) {
+  if (m_RebuildJob) {
+    if (m_RebuildJob->IsDone()) {
+      adoptRebuiltMesh();
+    } else if (!allowAsync) {
+      // Needed now. A build that is already running finishes, but its mesh
+      // is dropped.
+      m_RebuildJob->Cancel();
+      m_RebuildJob.reset();
+      m_MeshBuildPending = true;
+    } else if (!m_MeshBuildPending) {
+      // Nothing changed since it was scheduled.
+      return;
+    } else {
+      const bool cancelled = m_RebuildJob->Cancel();
+      if (!cancelled) {
+        // Still running; edits made meanwhile are built once it lands, so
+        // there is at most one build in flight per object.
+        return;
+      }
+      // Superseded before it started; build the current state instead.
+      m_RebuildJob.reset();
+    }
+  }
+
+  if (!m_MeshBuildPending) return;
+  m_MeshBuildPending = false;
+  std::string key = isPristine ? GetMeshCacheKey() : std::string();
+  // Only replacements go to the background; a first build is needed for
+  // the object to show up at all.
+  if (allowAsync && MeshRebuildScheduler::Get().IsEnabled() &&
+      !std::as_const(*m_SculptableMesh).GetIndices().empty() &&
+      (key.empty() || !MeshCache::Get().Find(key)) && scheduleRebuild(key)) {
+    return;
+  }
+  if (!key.empty()) {
+    m_SculptableMesh = MeshCache::Get().Acquire(
+        key, [this](std::vector<float>& verts, std::vector<unsigned int>& inds) {
+          BuildMeshData(verts, inds);
+        });
+    m_MeshShared = true;
+  } else {
+    std::vector<float> verts;
+    std::vector<unsigned int> inds;
+    BuildMeshData(verts, inds);
+    if (m_MeshShared) {
+      m_SculptableMesh = std::make_shared<SculptableMesh>();
+      m_MeshShared = false;
+    }
     m_SculptableMesh->Initialize(verts, inds);
+  }
+}
+
+bool BaseObject::scheduleRebuild(const std::string& key) {
+  // The builder works on a copy of the properties, so edits made while it
+  // runs cannot race it.
+  std::shared_ptr<BaseObject> snapshot = CloneState();
+  if (!snapshot) return false;
+  snapshot->m_SculptableMesh.reset();
+  snapshot->m_Shader.reset();
+
+  m_RebuildJob = MeshRebuildScheduler::Get().Schedule(
+      [snapshot](std::vector<float>& verts, std::vector<unsigned int>& inds) {
+        snapshot->BuildMeshData(verts, inds);
+      });
+  m_RebuildJob->cacheKey = key;
+  return true;
+}
+
+void BaseObject::adoptRebuiltMesh() {
+  std::shared_ptr<SculptableMesh> mesh = m_RebuildJob->TakeResult();
+  const std::string key = std::move(m_RebuildJob->cacheKey);
+  m_RebuildJob.reset();
+  if (!key.empty()) {
+    m_SculptableMesh = MeshCache::Get().Adopt(key, std::move(mesh));
+    m_MeshShared = true;
+  } else {
+    m_SculptableMesh = std::move(mesh);
+    m_MeshShared = false;
+  }
+  m_IsMeshDirty = true;
+  Application::Get().RequestSceneRender();
+}
+
+const IEditableMesh* BaseObject::GetMesh() const {
+  const_cast<BaseObject*>(this)->ensureMeshBuilt(true);
+  return m_SculptableMesh.get();
+}
+
+const IEditableMesh* BaseObject::GetCurrentMesh() const {
+  const_cast<BaseObject*>(this)->ensureMeshBuilt(false);
+  return m_SculptableMesh.get();
+}
+
+IEditableMesh* BaseObject::GetMeshForUpload() {
+  ensureMeshBuilt(true);
+  return m_SculptableMesh.get();
+}
+
+IEditableMesh* BaseObject::GetEditableMesh() {
+  ensureMeshBuilt(false);
+  if (m_MeshShared) {
+    // Copy on write: the cached mesh stays untouched for everyone else.
+    m_SculptableMesh = std::make_shared<SculptableMesh>(*m_SculptableMesh);
+    m_MeshShared = false;
     m_IsMeshDirty = true;
   }
+  return m_SculptableMesh.get();
+}
 
+std::unique_ptr<ISceneObject> BaseObject::Clone() {
+  std::unique_ptr<BaseObject> clone = CloneState();
+  if (clone) ShareMeshWith(*clone);
+  return clone;
+}
+
+void BaseObject::CopyStateFrom(const BaseObject& source) {
+  // Not the ID, which the scene assigns, nor the selection.
+  name = source.name;
+  isSelectable = source.isSelectable;
+  isStatic = source.isStatic;
+  isPristine = source.isPristine;
+  m_Properties.CopyValuesFrom(source.m_Properties);
   m_IsTransformDirty = true;
+}
+
+void BaseObject::ShareMeshWith(BaseObject& clone) {
+  // A source that has not built its mesh yet is copied as unbuilt too.
+  clone.m_MeshBuildPending = m_MeshBuildPending || m_RebuildJob;
+  clone.m_SculptableMesh = m_SculptableMesh;
+  clone.m_MeshShared = true;
+  m_MeshShared = true;
+  clone.m_IsMeshDirty = true;
+  clone.m_Multires =
+      m_Multires ? std::make_unique<MultiresMesh>(*m_Multires) : nullptr;
+  clone.m_SubdivisionLevel = m_SubdivisionLevel;
+}
+
+int BaseObject::GetSubdivisionLevels() const {
+  return m_Multires ? m_Multires->GetMaxLevel() : 0;
+}
+
+bool BaseObject::AddSubdivisionLevel() {
+  IEditableMesh* mesh = GetEditableMesh();
+  // A failed store means the topology changed under the levels; the shown
+  // mesh becomes the new base.
+  if (!m_Multires || !m_Multires->Store(m_SubdivisionLevel, *mesh)) {
+    m_Multires = std::make_unique<MultiresMesh>(*mesh);
+    m_SubdivisionLevel = 0;
+  }
+  if (!m_Multires->AddLevel()) {
+    Log::Debug("Subdivision level ", m_Multires->GetMaxLevel() + 1,
+                 " would exceed ", MultiresMesh::kMaxFaces, " faces.");
+    return false;
+  }
+  isPristine = false;
+  m_SubdivisionLevel = m_Multires->GetMaxLevel();
+  m_Multires->Extract(m_SubdivisionLevel, *m_SculptableMesh);
+  m_IsMeshDirty = true;
+  Application::Get().RequestSceneRender();
+  return true;
+}
+
+void BaseObject::SetSubdivisionLevel(int level) {
+  if (!m_Multires || level == m_SubdivisionLevel || level < 0 ||
+      level > m_Multires->GetMaxLevel()) {
+    return;
+  }
+  if (!m_Multires->Store(m_SubdivisionLevel, *GetEditableMesh())) {
+    Log::Debug("Mesh topology changed; subdivision levels were dropped.");
+    m_Multires.reset();
+    m_SubdivisionLevel = 0;
+    return;
+  }
+  m_SubdivisionLevel = level;
+  m_Multires->Extract(level, *m_SculptableMesh);
+  m_IsMeshDirty = true;
   Application::Get().RequestSceneRender();
 }
 
+void BaseObject::ClearSubdivisionLevels() {
+  m_Multires.reset();
+  m_SubdivisionLevel = 0;
+}
+
+std::shared_ptr<const IEditableMesh> BaseObject::GetSharedMesh() const {
+  const_cast<BaseObject*>(this)->ensureMeshBuilt(true);
+  return m_MeshShared ? m_SculptableMesh : nullptr;
+}
+
+void BaseObject::SetLoadedMesh(SculptableMesh&& mesh) {
+  if (m_RebuildJob) {
+    m_RebuildJob->Cancel();
+    m_RebuildJob.reset();
+  }
+  m_MeshBuildPending = false;
+  m_IsMeshDirty = true;
+  ClearSubdivisionLevels();
+  auto loaded = std::make_shared<SculptableMesh>(std::move(mesh));
+
+  // A saved pristine object shares an identical live cache entry, but file
+  // data never seeds the cache: edits that leave isPristine set would
+  // otherwise leak into every new object with the same properties.
+  std::string key = isPristine ? GetMeshCacheKey() : std::string();
+  if (!key.empty()) {
+    if (auto cached = MeshCache::Get().Find(key)) {
+      const SculptableMesh& cachedMesh = *cached;
+      if (cachedMesh.GetVertices() == loaded->GetVertices() &&
+          cachedMesh.GetIndices() == loaded->GetIndices()) {
+        m_SculptableMesh = std::move(cached);
+        m_MeshShared = true;
+        return;
+      }
+    }
+  }
+  m_SculptableMesh = std::move(loaded);
+  m_MeshShared = false;
+}
+
+std::string BaseObject::BuildMeshCacheKey(
+    std::initializer_list<const char*> floatProperties) const {
+  std::string key = GetTypeString();
+  for (const char* name : floatProperties) {
+    // Exact bits, so only meshes built from identical values are shared.
+    float value = m_Properties.GetValue<float>(name);
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    key += '|';
+    key += std::to_string(bits);
+  }
+  return key;
+}
+
 void BaseObject::Draw(OpenGLRenderer& renderer, const glm::mat4& view,
                       const glm::mat4& projection) {
-  renderer.RenderObject(*this, *Application::Get().GetCamera());
+  renderer.SubmitObject(*this);
 }
 
 void BaseObject::DrawHighlight(const glm::mat4& view,
@@ -2,11 +2,14 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "Interfaces.h"
+#include "Scene/MeshRebuildScheduler.h"
+#include "Sculpting/MultiresMesh.h"
 #include "Sculpting/SculptableMesh.h"
 
 class Shader;
@@ -42,24 +45,83 @@ class BaseObject : public ISceneObject {
   std::vector<GizmoHandleDef> GetGizmoHandleDefs() override;
   void OnGizmoUpdate(const std::string& propertyName, float delta,
                      const glm::vec3& axis) override;
-  IEditableMesh* GetEditableMesh() override { return m_SculptableMesh.get(); }
+  IEditableMesh* GetEditableMesh() override;
+  const IEditableMesh* GetMesh() const override;
+  const IEditableMesh* GetCurrentMesh() const override;
+  IEditableMesh* GetMeshForUpload() override;
+  std::shared_ptr<const IEditableMesh> GetSharedMesh() const override;
+  void SetLoadedMesh(SculptableMesh&& mesh) override;
   bool IsMeshDirty() const override { return m_IsMeshDirty; }
   void SetMeshDirty(bool dirty) override { m_IsMeshDirty = dirty; }
+  uint64_t GetMeshRebuildCount() const override { return m_MeshRebuildCount; }
+  int GetSubdivisionLevels() const override;
+  int GetSubdivisionLevel() const override { return m_SubdivisionLevel; }
+  bool AddSubdivisionLevel() override;
+  void SetSubdivisionLevel(int level) override;
+  void ClearSubdivisionLevels() override;
+  // CloneState plus this object's mesh, shared with the clone.
+  std::unique_ptr<ISceneObject> Clone() override;
 
  protected:
   virtual void BuildMeshData(std::vector<float>& vertices,
                              std::vector<unsigned int>& indices) = 0;
   virtual glm::vec3 GetLocalCenter() const;
 
+  // Copy of everything but the mesh, or nullptr if the type cannot copy
+  // itself directly.
+  virtual std::unique_ptr<BaseObject> CloneState() const { return nullptr; }
+  // CloneState() for types whose state is all in BaseObject: a default T
+  // with this object's state copied in.
+  template <typename T>
+  std::unique_ptr<BaseObject> CloneAs() const {
+    auto clone = std::make_unique<T>();
+    clone->CopyStateFrom(*this);
+    return clone;
+  }
+  // Copies the name, the ISceneObject flags and the property values.
+  void CopyStateFrom(const BaseObject& source);
+  // Gives clone this object's mesh and subdivision levels. The mesh is
+  // shared until either object writes to it.
+  void ShareMeshWith(BaseObject& clone);
+
+  // Key of the MeshCache entry this object's procedural mesh can share, or
+  // empty if the mesh is not purely a function of the object's properties.
+  virtual std::string GetMeshCacheKey() const { return {}; }
+  // Type string plus the exact values of the given float properties.
+  std::string BuildMeshCacheKey(
+      std::initializer_list<const char*> floatProperties) const;
+
   std::shared_ptr<Shader> m_Shader;
   PropertySet m_Properties;
 
   mutable bool m_IsTransformDirty = true;
   bool m_IsMeshDirty = true;
 
-  std::unique_ptr<SculptableMesh> m_SculptableMesh;
+  // Set by RebuildMesh; the procedural mesh is built on the next access, so
+  // a mesh loaded from a file replaces it without it ever being generated.
+  bool m_MeshBuildPending = false;
+  uint64_t m_MeshRebuildCount = 0;
+  // Background build of the pending mesh; m_SculptableMesh keeps the
+  // previous mesh until the next access after it finishes.
+  std::shared_ptr<MeshRebuildScheduler::Job> m_RebuildJob;
+
+  // Shared with identical pristine objects through the MeshCache, or with
+  // clones, while m_MeshShared is set; copied on the first mutable access.
+  std::shared_ptr<SculptableMesh> m_SculptableMesh;
+  bool m_MeshShared = false;
+
+  // Subdivision levels, if any were added; m_SculptableMesh then holds
+  // m_SubdivisionLevel as the editable mesh.
+  std::unique_ptr<MultiresMesh> m_Multires;
+  int m_SubdivisionLevel = 0;
 
  private:
   void RecalculateTransformMatrix() const;
+  // Builds a pending mesh. With allowAsync the build may be handed to the
+  // MeshRebuildScheduler and the previous mesh kept meanwhile.
+  void ensureMeshBuilt(bool allowAsync);
+  // False if the object cannot snapshot itself for a background build.
+  bool scheduleRebuild(const std::string& key);
+  void adoptRebuiltMesh();
   mutable glm::mat4 m_TransformMatrix;
 };
\ No newline at end of file
@@ -18,6 +18,14 @@ std::string CustomMesh::GetTypeString() const {
   return std::string(ObjectTypes::CustomMesh);
 }
 
+std::unique_ptr<BaseObject> CustomMesh::CloneState() const {
+  auto clone = std::make_unique<CustomMesh>();
+  clone->m_InitialVertices = m_InitialVertices;
+  clone->m_InitialIndices = m_InitialIndices;
+  clone->CopyStateFrom(*this);
+  return clone;
+}
+
 void CustomMesh::BuildMeshData(std::vector<float>& vertices,
                                std::vector<unsigned int>& indices) {
   vertices = m_InitialVertices;
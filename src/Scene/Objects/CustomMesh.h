@@ -15,6 +15,7 @@ class CustomMesh : public BaseObject {
  protected:
   void BuildMeshData(std::vector<float>& vertices,
                      std::vector<unsigned int>& indices) override;
+  std::unique_ptr<BaseObject> CloneState() const override;
 
  private:
   std::vector<float> m_InitialVertices;
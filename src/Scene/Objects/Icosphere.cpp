@@ -1,10 +1,107 @@
 #include "Scene/Objects/Icosphere.h"
 
+#include <algorithm>
+#include <cmath>
 #include <glm/glm.hpp>
-#include <glm/gtc/constants.hpp>
+#include <memory>
+#include <mutex>
 
+#include "Core/JobSystem.h"
 #include "Core/PropertyNames.h"
 #include "Scene/Objects/ObjectTypes.h"
+#include "Sculpting/MeshConnectivity.h"
+
+namespace {
+
+constexpr size_t kMinVerticesPerJob = 4096;
+// Finest level kept for the life of the process; objects use level 4.
+constexpr int kMaxCachedLevel = 5;
+
+struct UnitIcosphere {
+  std::vector<glm::vec3> positions;
+  std::vector<unsigned int> indices;
+};
+
+UnitIcosphere makeIcosahedron() {
+  const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+  UnitIcosphere ico;
+  ico.positions = {{-1, t, 0}, {1, t, 0},  {-1, -t, 0}, {1, -t, 0},
+                   {0, -1, t}, {0, 1, t},  {0, -1, -t}, {0, 1, -t},
+                   {t, 0, -1}, {t, 0, 1},  {-t, 0, -1}, {-t, 0, 1}};
+  for (auto& p : ico.positions) p = glm::normalize(p);
+  ico.indices = {0, 11, 5,  0, 5,  1,  0,  1,  7,  0,  7,  10, 0,  10, 11,
+                 1, 5,  9,  5, 11, 4,  11, 10, 2,  10, 7,  6,  7,  1,  8,
+                 3, 9,  4,  3, 4,  2,  3,  2,  6,  3,  6,  8,  3,  8,  9,
+                 4, 9,  5,  2, 4,  11, 6,  2,  10, 8,  6,  7,  9,  8,  1};
+  return ico;
+}
+
+// Splits every triangle into four. Edge e of the coarse mesh gets the new
+// vertex vertexCount + e, so the midpoint table is the flat edge list of a
+// fresh MeshConnectivity and both passes run in parallel.
+UnitIcosphere subdivide(const UnitIcosphere& coarse) {
+  const uint32_t vertexCount = static_cast<uint32_t>(coarse.positions.size());
+  const size_t faceCount = coarse.indices.size() / 3;
+  MeshConnectivity edges;
+  edges.Build(coarse.indices, vertexCount);
+  const size_t edgeCount = edges.GetEdgeSlotCount();
+
+  UnitIcosphere fine;
+  fine.positions.resize(vertexCount + edgeCount);
+  std::copy(coarse.positions.begin(), coarse.positions.end(),
+            fine.positions.begin());
+  JobSystem::Get().ParallelFor(edgeCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+      const MeshConnectivity::Edge& edge = edges.GetEdge(static_cast<uint32_t>(e));
+      fine.positions[vertexCount + e] =
+          glm::normalize(coarse.positions[edge.v0] + coarse.positions[edge.v1]);
+    }
+  });
+
+  fine.indices.resize(faceCount * 12);
+  JobSystem::Get().ParallelFor(faceCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t f = begin; f < end; ++f) {
+      const uint32_t face = static_cast<uint32_t>(f);
+      const unsigned int x = coarse.indices[f * 3];
+      const unsigned int y = coarse.indices[f * 3 + 1];
+      const unsigned int z = coarse.indices[f * 3 + 2];
+      const unsigned int a = vertexCount + edges.GetFaceEdge(face, 0);
+      const unsigned int b = vertexCount + edges.GetFaceEdge(face, 1);
+      const unsigned int c = vertexCount + edges.GetFaceEdge(face, 2);
+      const unsigned int split[12] = {x, a, c, y, b, a, z, c, b, a, b, c};
+      std::copy(std::begin(split), std::end(split), &fine.indices[f * 12]);
+    }
+  });
+  return fine;
+}
+
+// Unit spheres depend only on the level, so the coarse levels are built once
+// per process, each from the one below it. Finer levels are subdivided from
+// the finest cached one on every call and freed by the caller, so one large
+// request does not pin millions of triangles for good.
+std::shared_ptr<const UnitIcosphere> unitIcosphere(int level) {
+  static std::mutex s_Mutex;
+  static std::vector<std::shared_ptr<const UnitIcosphere>> s_Levels;
+  std::shared_ptr<const UnitIcosphere> sphere;
+  {
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    if (s_Levels.empty()) {
+      s_Levels.push_back(std::make_shared<const UnitIcosphere>(makeIcosahedron()));
+    }
+    const int cachedLevel = std::min(level, kMaxCachedLevel);
+    while (static_cast<int>(s_Levels.size()) <= cachedLevel) {
+      s_Levels.push_back(
+          std::make_shared<const UnitIcosphere>(subdivide(*s_Levels.back())));
+    }
+    sphere = s_Levels[cachedLevel];
+  }
+  for (int finer = kMaxCachedLevel; finer < level; ++finer) {
+    sphere = std::make_shared<const UnitIcosphere>(subdivide(*sphere));
+  }
+  return sphere;
+}
+
+}  // namespace
 
 Icosphere::Icosphere() {
   name = std::string(ObjectTypes::Icosphere);
@@ -17,111 +114,40 @@ std::string Icosphere::GetTypeString() const {
   return std::string(ObjectTypes::Icosphere);
 }
 
+std::string Icosphere::GetMeshCacheKey() const {
+  return BuildMeshCacheKey({PropertyNames::Radius}) + "|level" +
+         std::to_string(m_RecursionLevel);
+}
+
 // Icospheres also use the default scale gizmo from BaseObject.
 std::vector<GizmoHandleDef> Icosphere::GetGizmoHandleDefs() {
   return BaseObject::GetGizmoHandleDefs();
 }
 
-// Helper function to find or create the midpoint of an edge,
-// ensuring each new vertex is unique.
-int Icosphere::getMiddlePoint(int p1, int p2, std::vector<glm::vec3>& vertices,
-                              std::map<int64_t, int>& middlePointIndexCache) {
-  bool firstIsSmaller = p1 < p2;
-  int64_t smallerIndex = firstIsSmaller ? p1 : p2;
-  int64_t greaterIndex = firstIsSmaller ? p2 : p1;
-  int64_t key = (smallerIndex << 32) + greaterIndex;
-
-  auto it = middlePointIndexCache.find(key);
-  if (it != middlePointIndexCache.end()) {
-    return it->second;
-  }
-
-  glm::vec3 point1 = vertices[p1];
-  glm::vec3 point2 = vertices[p2];
-  glm::vec3 middle =
-      glm::vec3((point1.x + point2.x) / 2.0f, (point1.y + point2.y) / 2.0f,
-                (point1.z + point2.z) / 2.0f);
-
-  // Add the new vertex and normalize it to keep it on the sphere's surface
-  vertices.push_back(glm::normalize(middle));
-  int i = vertices.size() - 1;
-
-  middlePointIndexCache[key] = i;
-  return i;
-}
-
-// This function generates the vertices and indices for an icosphere
-// by starting with an icosahedron and recursively subdividing its faces.
 void Icosphere::BuildMeshData(std::vector<float>& outVertices,
                               std::vector<unsigned int>& outIndices) {
-  std::vector<glm::vec3> positions;
-  std::map<int64_t, int> middlePointIndexCache;
-  float radius = m_Properties.GetValue<float>(PropertyNames::Radius);
-
-  // Create the 12 initial vertices of an icosahedron
-  float t = (1.0f + sqrt(5.0f)) / 2.0f;
-  positions.push_back(glm::normalize(glm::vec3(-1, t, 0)));
-  positions.push_back(glm::normalize(glm::vec3(1, t, 0)));
-  positions.push_back(glm::normalize(glm::vec3(-1, -t, 0)));
-  positions.push_back(glm::normalize(glm::vec3(1, -t, 0)));
-  positions.push_back(glm::normalize(glm::vec3(0, -1, t)));
-  positions.push_back(glm::normalize(glm::vec3(0, 1, t)));
-  positions.push_back(glm::normalize(glm::vec3(0, -1, -t)));
-  positions.push_back(glm::normalize(glm::vec3(0, 1, -t)));
-  positions.push_back(glm::normalize(glm::vec3(t, 0, -1)));
-  positions.push_back(glm::normalize(glm::vec3(t, 0, 1)));
-  positions.push_back(glm::normalize(glm::vec3(-t, 0, -1)));
-  positions.push_back(glm::normalize(glm::vec3(-t, 0, 1)));
-
-  // Create the 20 initial faces of the icosahedron
-  std::vector<glm::ivec3> faces;
-  faces.push_back({0, 11, 5});
-  faces.push_back({0, 5, 1});
-  faces.push_back({0, 1, 7});
-  faces.push_back({0, 7, 10});
-  faces.push_back({0, 10, 11});
-  faces.push_back({1, 5, 9});
-  faces.push_back({5, 11, 4});
-  faces.push_back({11, 10, 2});
-  faces.push_back({10, 7, 6});
-  faces.push_back({7, 1, 8});
-  faces.push_back({3, 9, 4});
-  faces.push_back({3, 4, 2});
-  faces.push_back({3, 2, 6});
-  faces.push_back({3, 6, 8});
-  faces.push_back({3, 8, 9});
-  faces.push_back({4, 9, 5});
-  faces.push_back({2, 4, 11});
-  faces.push_back({6, 2, 10});
-  faces.push_back({8, 6, 7});
-  faces.push_back({9, 8, 1});
-
-  // Subdivide the faces recursively
-  for (int i = 0; i < m_RecursionLevel; i++) {
-    std::vector<glm::ivec3> faces2;
-    for (auto& tri : faces) {
-      int a = getMiddlePoint(tri.x, tri.y, positions, middlePointIndexCache);
-      int b = getMiddlePoint(tri.y, tri.z, positions, middlePointIndexCache);
-      int c = getMiddlePoint(tri.z, tri.x, positions, middlePointIndexCache);
-      faces2.push_back({tri.x, a, c});
-      faces2.push_back({tri.y, b, a});
-      faces2.push_back({tri.z, c, b});
-      faces2.push_back({a, b, c});
-    }
-    faces = faces2;
-  }
+  GenerateMesh(m_RecursionLevel,
+               m_Properties.GetValue<float>(PropertyNames::Radius), outVertices,
+               outIndices);
+}
 
-  // Finalize the vertex and index lists
-  outVertices.clear();
-  outIndices.clear();
-  for (const auto& pos : positions) {
-    outVertices.push_back(pos.x * radius);
-    outVertices.push_back(pos.y * radius);
-    outVertices.push_back(pos.z * radius);
-  }
-  for (const auto& face : faces) {
-    outIndices.push_back(face.x);
-    outIndices.push_back(face.y);
-    outIndices.push_back(face.z);
-  }
-}
\ No newline at end of file
+// Positions and indices come from the unit sphere of that level, so for the
+// cached levels only the scale pass below runs per object.
+void Icosphere::GenerateMesh(int recursionLevel, float radius,
+                             std::vector<float>& outVertices,
+                             std::vector<unsigned int>& outIndices) {
+  const std::shared_ptr<const UnitIcosphere> sphere =
+      unitIcosphere(std::clamp(recursionLevel, 0, kMaxRecursionLevel));
+  const UnitIcosphere& unit = *sphere;
+  const size_t vertexCount = unit.positions.size();
+  outVertices.resize(vertexCount * 3);
+  JobSystem::Get().ParallelFor(vertexCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      const glm::vec3 position = unit.positions[v] * radius;
+      outVertices[v * 3] = position.x;
+      outVertices[v * 3 + 1] = position.y;
+      outVertices[v * 3 + 2] = position.z;
+    }
+  });
+  outIndices = unit.indices;
+}
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <map>
-
 #include "Scene/Objects/ScalableSphereObject.h"
 
 class Icosphere : public ScalableSphereObject {
@@ -13,14 +11,25 @@ class Icosphere : public ScalableSphereObject {
   std::string GetTypeString() const override;
   std::vector<GizmoHandleDef> GetGizmoHandleDefs() override;
 
+  // Finest level GenerateMesh builds (20 * 4^9, about 5M triangles).
+  static constexpr int kMaxRecursionLevel = 9;
+
+  // Builds a unit icosahedron subdivided recursionLevel times (clamped to
+  // [0, kMaxRecursionLevel]), scaled to radius. Needs no GL context. The
+  // coarse unit spheres are built once per process and shared.
+  static void GenerateMesh(int recursionLevel, float radius,
+                           std::vector<float>& outVertices,
+                           std::vector<unsigned int>& outIndices);
+
  protected:
   // BaseObject override to define the object's geometry
   void BuildMeshData(std::vector<float>& vertices,
                      std::vector<unsigned int>& indices) override;
+  std::string GetMeshCacheKey() const override;
+  std::unique_ptr<BaseObject> CloneState() const override {
+    return CloneAs<Icosphere>();
+  }
 
  private:
-  // Helper function for recursively subdividing the mesh
-  int getMiddlePoint(int p1, int p2, std::vector<glm::vec3>& vertices,
-                     std::map<int64_t, int>& middlePointIndexCache);
   int m_RecursionLevel = 4;
 };
\ No newline at end of file
@@ -17,6 +17,11 @@ std::string Pyramid::GetTypeString() const {
   return std::string(ObjectTypes::Pyramid);
 }
 
+std::string Pyramid::GetMeshCacheKey() const {
+  return BuildMeshCacheKey({PropertyNames::Width, PropertyNames::Height,
+                            PropertyNames::Depth});
+}
+
 glm::vec3 Pyramid::GetLocalCenter() const {
   return glm::vec3(
       0.0f, m_Properties.GetValue<float>(PropertyNames::Height) * 0.25f, 0.0f);
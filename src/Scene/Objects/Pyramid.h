@@ -16,4 +16,8 @@ class Pyramid : public BaseObject {
   // BaseObject override
   void BuildMeshData(std::vector<float>& vertices,
                      std::vector<unsigned int>& indices) override;
+  std::string GetMeshCacheKey() const override;
+  std::unique_ptr<BaseObject> CloneState() const override {
+    return CloneAs<Pyramid>();
+  }
 };
\ No newline at end of file
@@ -20,6 +20,10 @@ std::string Sphere::GetTypeString() const {
   return std::string(ObjectTypes::Sphere);
 }
 
+std::string Sphere::GetMeshCacheKey() const {
+  return BuildMeshCacheKey({PropertyNames::Radius});
+}
+
 std::vector<GizmoHandleDef> Sphere::GetGizmoHandleDefs() {
   return BaseObject::GetGizmoHandleDefs();
 }
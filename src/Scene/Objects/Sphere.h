@@ -13,4 +13,8 @@ class Sphere : public ScalableSphereObject {
  protected:
   void BuildMeshData(std::vector<float>& vertices,
                      std::vector<unsigned int>& indices) override;
+  std::string GetMeshCacheKey() const override;
+  std::unique_ptr<BaseObject> CloneState() const override {
+    return CloneAs<Sphere>();
+  }
 };
\ No newline at end of file
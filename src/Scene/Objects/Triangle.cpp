@@ -21,6 +21,10 @@ std::string Triangle::GetTypeString() const {
   return std::string(ObjectTypes::Triangle);
 }
 
+std::string Triangle::GetMeshCacheKey() const {
+  return BuildMeshCacheKey({PropertyNames::Width, PropertyNames::Height});
+}
+
 glm::vec3 Triangle::GetLocalCenter() const {
   return glm::vec3(
       0.0f, m_Properties.GetValue<float>(PropertyNames::Height) * 0.5f, 0.0f);
@@ -18,4 +18,8 @@ class Triangle : public BaseObject {
   // BaseObject override
   void BuildMeshData(std::vector<float>& vertices,
                      std::vector<unsigned int>& indices) override;
+  std::string GetMeshCacheKey() const override;
+  std::unique_ptr<BaseObject> CloneState() const override {
+    return CloneAs<Triangle>();
+  }
 };
\ No newline at end of file
@@ -1,46 +1,120 @@
 #include "Scene/Scene.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <iomanip>
 #include <iostream>
+#include <unordered_set>
 
 #include "Core/Application.h"
 #include "Core/Log.h"
+#include "Core/MappedFile.h"
 #include "Core/SettingsManager.h"
 #include "Factories/SceneObjectFactory.h"
 #include "Interfaces.h"
+#include "Scene/SceneBinaryFormat.h"
 #include "nlohmann/json.hpp"
 
-Scene::Scene(SceneObjectFactory* factory) : m_ObjectFactory(factory) {}
+namespace {
+// Scenes are also used headless, where there is no window to redraw.
+void RequestSceneRender() {
+  if (Application::HasInstance()) Application::Get().RequestSceneRender();
+}
+
+// The change log keeps at least this many entries, or twice the object
+// count if that is more, before dropping its older half.
+constexpr size_t kMinChangeLogSize = 4096;
+
+// Each scene numbers its changes from its own base, so a cursor taken from
+// one scene is always out of range for another.
+uint64_t nextChangeLogBase() {
+  static std::atomic<uint64_t> s_NextBase{uint64_t(1) << 40};
+  return s_NextBase.fetch_add(uint64_t(1) << 40);
+}
+}  // namespace
+
+Scene::Scene(SceneObjectFactory* factory)
+    : m_ChangeLogStart(nextChangeLogBase()), m_ObjectFactory(factory) {}
 
 Scene::~Scene() = default;
 
+void Scene::insertObject(std::unique_ptr<ISceneObject> object) {
+  // The index needs unique IDs; a clash (e.g. a hand-edited file) gets a
+  // fresh one.
+  if (m_SlotByID.count(object->id)) object->id = m_NextObjectID++;
+
+  uint32_t slot;
+  if (!m_FreeSlots.empty()) {
+    slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(m_Slots.size());
+    m_Slots.push_back({0, 0});
+  }
+  m_Slots[slot].objectIndex = static_cast<uint32_t>(m_Objects.size());
+  m_SlotByID[object->id] = slot;
+  logChange(SceneChange::Kind::Added, object->id);
+  m_ObjectSlots.push_back(slot);
+  m_Objects.push_back(std::move(object));
+}
+
+template <typename Pred>
+void Scene::removeObjectsIf(Pred shouldRemove) {
+  size_t kept = 0;
+  for (size_t i = 0; i < m_Objects.size(); ++i) {
+    const uint32_t slot = m_ObjectSlots[i];
+    if (shouldRemove(*m_Objects[i])) {
+      logChange(SceneChange::Kind::Removed, m_Objects[i]->id);
+      m_SlotByID.erase(m_Objects[i]->id);
+      ++m_Slots[slot].generation;
+      m_FreeSlots.push_back(slot);
+      continue;
+    }
+    if (kept != i) {
+      m_Objects[kept] = std::move(m_Objects[i]);
+      m_ObjectSlots[kept] = slot;
+      m_Slots[slot].objectIndex = static_cast<uint32_t>(kept);
+    }
+    ++kept;
+  }
+  m_Objects.resize(kept);
+  m_ObjectSlots.resize(kept);
+}
+
+void Scene::logChange(SceneChange::Kind kind, uint32_t id) {
+  // Bounded so a scene whose changes nobody reads does not grow without
+  // limit; a consumer that falls that far behind resynchronizes instead.
+  if (m_ChangeLog.size() >= std::max(kMinChangeLogSize, 2 * m_Objects.size())) {
+    const size_t dropped = m_ChangeLog.size() / 2;
+    m_ChangeLog.erase(m_ChangeLog.begin(), m_ChangeLog.begin() + dropped);
+    m_ChangeLogStart += dropped;
+  }
+  m_ChangeLog.push_back({kind, id});
+}
+
 // Existing Clear method (only removes selectable objects)
 void Scene::Clear() {
-  m_Objects.erase(
-      std::remove_if(m_Objects.begin(), m_Objects.end(),
-                     [](const auto& obj) { return obj->isSelectable; }),
-      m_Objects.end());
+  removeObjectsIf([](const ISceneObject& obj) { return obj.isSelectable; });
 
   m_DeferredDeletions.clear();
-  m_SelectedIndex = -1;
+  m_Selected = {};
 
   uint32_t maxId = 0;
   for (const auto& o : m_Objects) {
     if (o) maxId = std::max(maxId, o->id);
   }
   m_NextObjectID = maxId + 1; // Update next ID based on what remains
-  Application::Get().RequestSceneRender();
+  RequestSceneRender();
 }
 
 void Scene::ClearAllObjects() {
-    m_Objects.clear();
+    removeObjectsIf([](const ISceneObject&) { return true; });
     m_DeferredDeletions.clear();
-    m_SelectedIndex = -1;
+    m_Selected = {};
     m_NextObjectID = 1; // Reset to initial ID
-    Application::Get().RequestSceneRender();
+    RequestSceneRender();
 }
 
 
@@ -49,30 +123,30 @@ void Scene::ProcessDeferredDeletions() {
     return;
   }
 
+  std::unordered_set<uint32_t> doomed;
+  for (uint32_t id : m_DeferredDeletions) {
+    if (m_SlotByID.count(id)) doomed.insert(id);
+  }
+  m_DeferredDeletions.clear();
+  if (doomed.empty()) return;
+
   ISceneObject* selectedObject = GetSelectedObject();
-  if (selectedObject != nullptr) {
-    bool isSelectedForDeletion =
-        std::find(m_DeferredDeletions.begin(), m_DeferredDeletions.end(),
-                  selectedObject->id) != m_DeferredDeletions.end();
-    if (isSelectedForDeletion) {
-      SetSelectedObjectByID(0);
-    }
+  if (selectedObject != nullptr && doomed.count(selectedObject->id)) {
+    SetSelectedObjectByID(0);
   }
 
-  m_Objects.erase(std::remove_if(m_Objects.begin(), m_Objects.end(),
-                                 [this](const auto& obj) {
-                                   return std::find(m_DeferredDeletions.begin(),
-                                                    m_DeferredDeletions.end(),
-                                                    obj->id) !=
-                                          m_DeferredDeletions.end();
-                                 }),
-                  m_Objects.end());
+  removeObjectsIf(
+      [&doomed](const ISceneObject& obj) { return doomed.count(obj.id) != 0; });
 
-  m_DeferredDeletions.clear();
-  Application::Get().RequestSceneRender();
+  RequestSceneRender();
 }
 
 void Scene::Save(const std::string& filepath) const {
+  if (SceneBinaryFormat::IsBinaryScenePath(filepath)) {
+    SaveBinary(filepath);
+    return;
+  }
+
   nlohmann::json sceneJ;
   sceneJ["objects"] = nlohmann::json::array();
   uint32_t maxId = 0;
@@ -89,14 +163,52 @@ void Scene::Save(const std::string& filepath) const {
   ofs << std::setw(4) << sceneJ << "\n";
 }
 
+void Scene::SaveBinary(const std::string& filepath) const {
+  SceneBinaryFormat::Writer writer;
+  if (!writer.Open(filepath)) return;
+
+  nlohmann::json sceneJ;
+  sceneJ["objects"] = nlohmann::json::array();
+  uint32_t maxId = 0;
+  for (auto const& o : m_Objects) {
+    if (o->isSelectable) {
+      nlohmann::json oj;
+      o->SerializeProperties(oj);
+      if (const SculptableMesh* mesh = o->GetSculptableMesh()) {
+        oj["sculpt_blocks"] = writer.WriteMeshBlocks(*mesh);
+      }
+      sceneJ["objects"].push_back(oj);
+    }
+    maxId = std::max(maxId, o->id);
+  }
+  sceneJ["next_object_id"] = maxId + 1;
+  if (!writer.Finish(sceneJ)) {
+    Log::Debug("Failed to write binary scene file: ", filepath);
+  }
+}
+
 void Scene::Load(const std::string& filepath) {
-  std::ifstream in(filepath);
-  if (!in.is_open()) {
+  // Map the file either way: JSON parses straight from the mapped pages, and
+  // binary scenes copy their mesh blocks out of them.
+  MappedFile file;
+  if (!file.Open(filepath)) {
     Log::Debug("Could not open scene file for loading: ", filepath);
     return;
   }
+
   nlohmann::json sceneJson;
-  in >> sceneJson;
+  if (SceneBinaryFormat::HasMagic(file.GetData(), file.GetSize())) {
+    if (!SceneBinaryFormat::ReadDocument(file, sceneJson)) return;
+    LoadObjects(sceneJson, &file);
+  } else {
+    const char* text = reinterpret_cast<const char*>(file.GetData());
+    sceneJson = nlohmann::json::parse(text, text + file.GetSize());
+    LoadObjects(sceneJson, nullptr);
+  }
+}
+
+void Scene::LoadObjects(const nlohmann::json& sceneJson,
+                        const MappedFile* blockFile) {
   // Use ClearAllObjects to ensure a clean state before loading
   // This might be redundant if ClearAllObjects is always called in test SetUp,
   // but it's good practice for scene loading in general.
@@ -109,17 +221,24 @@ void Scene::Load(const std::string& filepath) {
     auto clone = m_ObjectFactory->Create(type);
     if (!clone) continue;
     clone->Deserialize(objJson);
+    if (blockFile && objJson.contains("sculpt_blocks")) {
+      SculptableMesh loaded;
+      if (SceneBinaryFormat::ReadMeshBlocks(*blockFile, objJson["sculpt_blocks"],
+                                            loaded)) {
+        clone->SetLoadedMesh(std::move(loaded));
+      }
+    }
     if (clone->id >= m_NextObjectID) m_NextObjectID = clone->id + 1;
-    m_Objects.push_back(std::move(clone));
+    insertObject(std::move(clone));
   }
-  Application::Get().RequestSceneRender();
+  RequestSceneRender();
 }
 
 void Scene::AddObject(std::unique_ptr<ISceneObject> object) {
   if (!object) return;
   object->id = m_NextObjectID++;
-  m_Objects.push_back(std::move(object));
-  Application::Get().RequestSceneRender();
+  insertObject(std::move(object));
+  RequestSceneRender();
 }
 
 const std::vector<std::unique_ptr<ISceneObject>>& Scene::GetSceneObjects()
@@ -128,30 +247,39 @@ const std::vector<std::unique_ptr<ISceneObject>>& Scene::GetSceneObjects()
 }
 
 ISceneObject* Scene::GetObjectByID(uint32_t id) {
-  auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
-                         [id](auto const& o) { return o->id == id; });
-  return (it != m_Objects.end() ? it->get() : nullptr);
+  return Resolve(GetHandle(id));
 }
 
 const ISceneObject* Scene::GetObjectByID(uint32_t id) const {
-  auto it = std::find_if(m_Objects.begin(), m_Objects.end(),
-                         [id](auto const& o) { return o->id == id; });
-  return (it != m_Objects.end() ? it->get() : nullptr);
+  return Resolve(GetHandle(id));
+}
+
+ObjectHandle Scene::GetHandle(uint32_t id) const {
+  auto it = m_SlotByID.find(id);
+  if (it == m_SlotByID.end()) return {};
+  return {it->second, m_Slots[it->second].generation};
+}
+
+ISceneObject* Scene::Resolve(ObjectHandle handle) const {
+  if (handle.slot >= m_Slots.size() ||
+      m_Slots[handle.slot].generation != handle.generation) {
+    return nullptr;
+  }
+  return m_Objects[m_Slots[handle.slot].objectIndex].get();
 }
 
 void Scene::SetSelectedObjectByID(uint32_t id) {
-  if (m_SelectedIndex >= 0 && m_SelectedIndex < (int)m_Objects.size())
-    m_Objects[m_SelectedIndex]->isSelected = false;
-
-  m_SelectedIndex = -1;
-  for (int i = 0; i < (int)m_Objects.size(); ++i) {
-    if (m_Objects[i]->id == id && m_Objects[i]->isSelectable) {
-      m_SelectedIndex = i;
-      m_Objects[i]->isSelected = true;
-      break;
-    }
+  if (ISceneObject* previous = Resolve(m_Selected)) {
+    previous->isSelected = false;
+  }
+
+  m_Selected = {};
+  ISceneObject* object = GetObjectByID(id);
+  if (object && object->isSelectable) {
+    m_Selected = GetHandle(id);
+    object->isSelected = true;
   }
-  Application::Get().RequestSceneRender();
+  RequestSceneRender();
 }
 
 void Scene::SelectNextObject() {
@@ -159,7 +287,9 @@ void Scene::SelectNextObject() {
     SetSelectedObjectByID(0);
     return;
   }
-  int start = (m_SelectedIndex < 0 ? 0 : m_SelectedIndex + 1);
+  const ISceneObject* selected = Resolve(m_Selected);
+  int start =
+      selected ? static_cast<int>(m_Slots[m_Selected.slot].objectIndex) + 1 : 0;
   for (int d = 0; d < (int)m_Objects.size(); ++d) {
     int i = (start + d) % m_Objects.size();
     if (m_Objects[i]->isSelectable) {
@@ -171,10 +301,8 @@ void Scene::SelectNextObject() {
 }
 
 void Scene::QueueForDeletion(uint32_t id) {
-  if (std::find(m_DeferredDeletions.begin(), m_DeferredDeletions.end(), id) ==
-      m_DeferredDeletions.end()) {
-    m_DeferredDeletions.push_back(id);
-  }
+  // Duplicates are dropped when the queue is processed.
+  m_DeferredDeletions.push_back(id);
 }
 
 void Scene::DeleteSelectedObject() {
@@ -183,12 +311,7 @@ void Scene::DeleteSelectedObject() {
   }
 }
 
-ISceneObject* Scene::GetSelectedObject() {
-  if (m_SelectedIndex >= 0 && m_SelectedIndex < (int)m_Objects.size()) {
-    return m_Objects[m_SelectedIndex].get();
-  }
-  return nullptr;
-}
+ISceneObject* Scene::GetSelectedObject() { return Resolve(m_Selected); }
 
 int Scene::GetNextAvailableIndexForName(const std::string& baseName) const {
   int maxNum = 0;
@@ -208,27 +331,29 @@ int Scene::GetNextAvailableIndexForName(const std::string& baseName) const {
   return maxNum + 1;
 }
 
-void Scene::DuplicateObject(uint32_t sourceID) {
+void Scene::DuplicateObject(uint32_t sourceID, int count) {
   ISceneObject* orig = GetObjectByID(sourceID);
-  if (!orig || !orig->isSelectable || !m_ObjectFactory) return;
-
-  auto clone = m_ObjectFactory->Copy(*orig);
-  if (!clone) return;
-
-  clone->id = m_NextObjectID++;
-
-  {
-    std::string base = orig->name;
-    int idx = GetNextAvailableIndexForName(base);
+  if (!orig || !orig->isSelectable || !m_ObjectFactory || count < 1) return;
+
+  // Names and positions are worked out once for the whole array rather
+  // than by rescanning the scene per copy.
+  const std::string base = orig->name;
+  int idx = GetNextAvailableIndexForName(base);
+  const glm::vec3 origPos = orig->GetPosition();
+  const glm::vec3 offset = SettingsManager::Get().cloneOffset;
+
+  m_Objects.reserve(m_Objects.size() + count);
+  m_ObjectSlots.reserve(m_ObjectSlots.size() + count);
+  for (int i = 0; i < count; ++i) {
+    auto clone = m_ObjectFactory->Copy(*orig);
+    if (!clone) break;
+
+    clone->id = m_NextObjectID++;
     clone->name = (idx == 0) ? base : base + " (" + std::to_string(idx) + ")";
-  }
+    ++idx;
+    clone->SetPosition(origPos + offset * static_cast<float>(i + 1));
 
-  {
-    auto p = orig->GetPosition();
-    glm::vec3 origPos = orig->GetPosition();
-    clone->SetPosition(origPos + SettingsManager::Get().cloneOffset);
+    insertObject(std::move(clone));
   }
-
-  m_Objects.push_back(std::move(clone));
-  Application::Get().RequestSceneRender();
+  RequestSceneRender();
 }
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <limits>
 #include <memory>
+#include <nlohmann/json_fwd.hpp>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -10,6 +12,7 @@
 
 // Forward declarations
 class ISceneObject;
+class MappedFile;
 class SceneObjectFactory;
 
 // Hash function for glm::vec3 to use it as a key in unordered_map
@@ -22,9 +25,32 @@ struct Vec3Hash {
   }
 };
 
+/// Reference to a scene object that goes stale, rather than dangling or
+/// aliasing a newer object, once the object is removed.
+struct ObjectHandle {
+  static constexpr uint32_t kInvalidSlot = std::numeric_limits<uint32_t>::max();
+  uint32_t slot = kInvalidSlot;
+  uint32_t generation = 0;
+
+  bool operator==(const ObjectHandle&) const = default;
+};
+
+/// One entry of the scene's change log.
+struct SceneChange {
+  enum class Kind : uint8_t { Added, Removed };
+  Kind kind;
+  uint32_t id;
+};
+
 /**
  * @brief Manages a collection of ISceneObject, selection, save/load,
  * duplication, etc.
+ *
+ * Objects are kept in insertion order for iteration, and indexed through a
+ * generational slot map: each object owns a slot that knows its position in
+ * the list, and an ID -> slot table makes lookups by ID constant time.
+ * Additions and removals are appended to a change log that consumers such as
+ * the renderer read incrementally instead of diffing the whole scene.
  */
 class Scene {
  public:
@@ -38,10 +64,12 @@ class Scene {
   /// Processes the queue of objects marked for deletion.
   void ProcessDeferredDeletions();
 
-  /// Serialize only selectable objects to disk.
+  /// Serialize only selectable objects to disk. Paths ending in ".imscene"
+  /// get the binary format, anything else gets JSON.
   void Save(const std::string& filepath) const;
 
-  /// Load scene from disk, replacing existing objects.
+  /// Load scene from disk, replacing existing objects. Binary scenes are
+  /// recognized by their header, whatever the extension.
   void Load(const std::string& filepath);
 
   /// Add a freshly constructed object (assigns it a new ID).
@@ -50,8 +78,9 @@ class Scene {
   /// Get full list (for UI outliner).
   const std::vector<std::unique_ptr<ISceneObject>>& GetSceneObjects() const;
 
-  /// Duplicate an object by ID, carrying over all properties.
-  void DuplicateObject(uint32_t sourceID);
+  /// Duplicate an object by ID, carrying over all properties. With a count
+  /// above one, makes an array of copies, each one clone offset further.
+  void DuplicateObject(uint32_t sourceID, int count = 1);
 
   /// Queue an object for deletion at the start of the next frame.
   void QueueForDeletion(uint32_t id);
@@ -70,13 +99,61 @@ class Scene {
   ISceneObject* GetObjectByID(uint32_t id);
   const ISceneObject* GetObjectByID(uint32_t id) const;
 
+  /// Handle to the object with @p id, or an invalid handle.
+  ObjectHandle GetHandle(uint32_t id) const;
+  /// The object behind @p handle, or nullptr once it has been removed.
+  ISceneObject* Resolve(ObjectHandle handle) const;
+
+  /// Calls @p onChange for every change logged since @p cursor and advances
+  /// the cursor. Returns false, after advancing the cursor to the end, if
+  /// older changes were dropped from the log; the consumer then has to
+  /// resynchronize against GetSceneObjects().
+  template <typename Fn>
+  bool ConsumeChanges(uint64_t& cursor, Fn&& onChange) const {
+    const uint64_t end = m_ChangeLogStart + m_ChangeLog.size();
+    bool complete = cursor >= m_ChangeLogStart && cursor <= end;
+    if (complete) {
+      for (uint64_t i = cursor; i < end; ++i) {
+        onChange(m_ChangeLog[i - m_ChangeLogStart]);
+      }
+    }
+    cursor = end;
+    return complete;
+  }
+
  private:
   /// Helper for naming duplicates: returns 0 if no conflict, else next integer.
   int GetNextAvailableIndexForName(const std::string& baseName) const;
 
+  void SaveBinary(const std::string& filepath) const;
+  /// Replaces the scene with the objects in @p sceneJson. Mesh data comes
+  /// from @p blockFile for binary scenes, from the JSON itself otherwise.
+  void LoadObjects(const nlohmann::json& sceneJson,
+                   const MappedFile* blockFile);
+
+  struct Slot {
+    uint32_t objectIndex;  // Position in m_Objects while live
+    uint32_t generation;   // Bumped when the slot is freed
+  };
+
+  /// Appends @p object (whose ID is already set) and indexes it.
+  void insertObject(std::unique_ptr<ISceneObject> object);
+  /// Removes every object matching @p shouldRemove, keeping the order of
+  /// the rest.
+  template <typename Pred>
+  void removeObjectsIf(Pred shouldRemove);
+  void logChange(SceneChange::Kind kind, uint32_t id);
+
   std::vector<std::unique_ptr<ISceneObject>> m_Objects;
+  std::vector<uint32_t> m_ObjectSlots;  // Slot of each entry in m_Objects
+  std::vector<Slot> m_Slots;
+  std::vector<uint32_t> m_FreeSlots;
+  std::unordered_map<uint32_t, uint32_t> m_SlotByID;
+  std::vector<SceneChange> m_ChangeLog;
+  uint64_t m_ChangeLogStart = 0;  // Sequence number of m_ChangeLog[0]
+
   std::vector<uint32_t> m_DeferredDeletions;
-  int m_SelectedIndex = -1;
+  ObjectHandle m_Selected;
   uint32_t m_NextObjectID = 1;
   SceneObjectFactory* m_ObjectFactory;
 };
\ No newline at end of file
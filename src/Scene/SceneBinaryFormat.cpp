@@ -0,0 +1,196 @@
+#include "Scene/SceneBinaryFormat.h"
+
+#include <bit>
+#include <cstring>
+#include <span>
+
+#include "Core/Log.h"
+#include "Core/MappedFile.h"
+#include "Sculpting/SculptableMesh.h"
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float),
+              "Mesh blocks are written as tightly packed vec3");
+// Headers and blocks are written and mapped back in host byte order; the
+// format is little-endian, so a big-endian port would have to byte-swap here.
+static_assert(std::endian::native == std::endian::little,
+              "Binary scenes are read and written without byte swapping");
+
+namespace SceneBinaryFormat {
+namespace {
+
+// Reads an optional unsigned field (0 if absent). False if it holds anything
+// else; json::value() would throw on such a file instead.
+bool readUnsigned(const nlohmann::json& object, const char* key,
+                  uint64_t& out) {
+  out = 0;
+  auto it = object.find(key);
+  if (it == object.end()) return true;
+  if (!it->is_number_unsigned()) return false;
+  out = it->get<uint64_t>();
+  return true;
+}
+
+// Returns the block's bytes, or nullptr if it is malformed, does not lie
+// inside the file or is not a whole number of elements.
+const std::byte* blockData(const MappedFile& file, const nlohmann::json& block,
+                           size_t elementSize, size_t& outCount) {
+  outCount = 0;
+  uint64_t offset = 0, count = 0;
+  if (!block.is_object() || !readUnsigned(block, "offset", offset) ||
+      !readUnsigned(block, "count", count)) {
+    return nullptr;
+  }
+  if (count == 0) return file.GetData();
+  if (offset % alignof(float) != 0 || offset > file.GetSize() ||
+      count > (file.GetSize() - offset) / elementSize) {
+    return nullptr;
+  }
+  outCount = static_cast<size_t>(count);
+  return file.GetData() + offset;
+}
+
+nlohmann::json blockRecord(uint64_t offset, size_t count) {
+  return {{"offset", offset}, {"count", count}};
+}
+
+}  // namespace
+
+bool HasMagic(const std::byte* data, size_t size) {
+  return data && size >= sizeof(kMagic) &&
+         std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool IsBinaryScenePath(const std::string& filepath) {
+  const size_t length = std::strlen(kExtension);
+  return filepath.size() >= length &&
+         filepath.compare(filepath.size() - length, length, kExtension) == 0;
+}
+
+bool ReadDocument(const MappedFile& file, nlohmann::json& outJson) {
+  if (file.GetSize() < sizeof(Header) ||
+      !HasMagic(file.GetData(), file.GetSize())) {
+    Log::Debug("SceneBinaryFormat: Not a binary scene file");
+    return false;
+  }
+  Header header;
+  std::memcpy(&header, file.GetData(), sizeof(Header));
+  if (header.version != kVersion) {
+    Log::Debug("SceneBinaryFormat: Unsupported version ", header.version);
+    return false;
+  }
+  if (header.jsonOffset > file.GetSize() ||
+      header.jsonSize > file.GetSize() - header.jsonOffset) {
+    Log::Debug("SceneBinaryFormat: Document lies outside the file");
+    return false;
+  }
+
+  const char* text =
+      reinterpret_cast<const char*>(file.GetData() + header.jsonOffset);
+  outJson = nlohmann::json::parse(text, text + header.jsonSize, nullptr,
+                                  /*allow_exceptions=*/false);
+  if (outJson.is_discarded()) {
+    Log::Debug("SceneBinaryFormat: Malformed scene document");
+    return false;
+  }
+  return true;
+}
+
+bool ReadMeshBlocks(const MappedFile& file, const nlohmann::json& blocksJson,
+                    SculptableMesh& mesh) {
+  if (!blocksJson.is_object()) {
+    Log::Debug("SceneBinaryFormat: Malformed mesh block record, skipping mesh");
+    return false;
+  }
+  size_t vertexCount = 0, indexCount = 0, normalCount = 0;
+  const std::byte* vertices = blockData(
+      file, blocksJson.value("vertices", nlohmann::json()), sizeof(glm::vec3),
+      vertexCount);
+  const std::byte* indices = blockData(
+      file, blocksJson.value("indices", nlohmann::json()), sizeof(unsigned int),
+      indexCount);
+  if (!vertices || !indices) {
+    Log::Debug("SceneBinaryFormat: Mesh block malformed or out of bounds, "
+               "skipping mesh");
+    return false;
+  }
+  // Normals are optional; without them the mesh recomputes its own.
+  const std::byte* normals = blockData(
+      file, blocksJson.value("normals", nlohmann::json()), sizeof(glm::vec3),
+      normalCount);
+  if (!normals) normalCount = 0;
+
+  mesh.InitializeFromBuffers(
+      {reinterpret_cast<const glm::vec3*>(vertices), vertexCount},
+      {reinterpret_cast<const unsigned int*>(indices), indexCount},
+      {reinterpret_cast<const glm::vec3*>(normals), normalCount});
+  return true;
+}
+
+bool Writer::Open(const std::string& filepath) {
+  m_Stream.open(filepath, std::ios::binary | std::ios::trunc);
+  if (!m_Stream.is_open()) {
+    Log::Debug("SceneBinaryFormat: Could not open ", filepath, " for writing");
+    return false;
+  }
+  // Placeholder; Finish() rewrites it once the document offset is known.
+  Header header{};
+  m_Stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_Offset = sizeof(header);
+  return true;
+}
+
+uint64_t Writer::WriteBlock(const void* data, size_t size) {
+  padTo(kBlockAlignment);
+  uint64_t offset = m_Offset;
+  m_Stream.write(static_cast<const char*>(data),
+                 static_cast<std::streamsize>(size));
+  m_Offset += size;
+  return offset;
+}
+
+nlohmann::json Writer::WriteMeshBlocks(const SculptableMesh& mesh) {
+  const auto& vertices = mesh.GetVertices();
+  const auto& indices = mesh.GetIndices();
+  const auto& normals = mesh.GetNormals();
+
+  nlohmann::json blocks;
+  blocks["vertices"] = blockRecord(
+      WriteBlock(vertices.data(), vertices.size() * sizeof(glm::vec3)),
+      vertices.size());
+  blocks["indices"] = blockRecord(
+      WriteBlock(indices.data(), indices.size() * sizeof(unsigned int)),
+      indices.size());
+  if (normals.size() == vertices.size()) {
+    blocks["normals"] = blockRecord(
+        WriteBlock(normals.data(), normals.size() * sizeof(glm::vec3)),
+        normals.size());
+  }
+  return blocks;
+}
+
+bool Writer::Finish(const nlohmann::json& sceneJson) {
+  const std::string document = sceneJson.dump();
+  padTo(kBlockAlignment);
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.jsonOffset = m_Offset;
+  header.jsonSize = document.size();
+
+  m_Stream.write(document.data(),
+                 static_cast<std::streamsize>(document.size()));
+  m_Stream.seekp(0);
+  m_Stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_Stream.close();
+  return !m_Stream.fail();
+}
+
+void Writer::padTo(uint64_t alignment) {
+  static const char kZeros[kBlockAlignment] = {};
+  uint64_t padding = (alignment - m_Offset % alignment) % alignment;
+  m_Stream.write(kZeros, static_cast<std::streamsize>(padding));
+  m_Offset += padding;
+}
+
+}  // namespace SceneBinaryFormat
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+class MappedFile;
+class SculptableMesh;
+
+/**
+ * @brief Chunked binary scene files (".imscene").
+ *
+ * Layout, all little-endian (only little-endian hosts are supported; the
+ * data is mapped back without byte swapping):
+ *   Header (32 bytes): magic, version, JSON offset and size
+ *   Raw data blocks, each starting on a kBlockAlignment boundary
+ *   JSON document: the same object records as a .json scene, except that
+ *     mesh data is replaced by "sculpt_blocks" references into the file
+ *
+ * Loading maps the file and copies each block straight into the mesh, so no
+ * number is ever parsed from text.
+ */
+namespace SceneBinaryFormat {
+
+inline constexpr char kMagic[8] = {'I', 'M', 'S', 'C', 'E', 'N', 'E', '\x1a'};
+inline constexpr uint32_t kVersion = 1;
+inline constexpr uint64_t kBlockAlignment = 64;
+inline constexpr const char* kExtension = ".imscene";
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t jsonOffset;
+  uint64_t jsonSize;
+};
+static_assert(sizeof(Header) == 32, "Header layout is part of the format");
+
+/** @brief True if the data starts with a binary scene header. */
+bool HasMagic(const std::byte* data, size_t size);
+
+/** @brief True if the path ends in kExtension (case-sensitive). */
+bool IsBinaryScenePath(const std::string& filepath);
+
+/**
+ * @brief Reads and validates the header and JSON document of a mapped file.
+ * @return False (after logging why) if the file is not a readable scene.
+ */
+bool ReadDocument(const MappedFile& file, nlohmann::json& outJson);
+
+/**
+ * @brief Loads the mesh referenced by an object's "sculpt_blocks" record.
+ * @return False if a block is missing, malformed or out of bounds; the mesh is
+ * then left untouched.
+ */
+bool ReadMeshBlocks(const MappedFile& file, const nlohmann::json& blocksJson,
+                    SculptableMesh& mesh);
+
+/**
+ * @brief Streams a binary scene: blocks first, the JSON document last.
+ */
+class Writer {
+ public:
+  bool Open(const std::string& filepath);
+
+  /** @brief Appends an aligned raw block; returns its offset in the file. */
+  uint64_t WriteBlock(const void* data, size_t size);
+
+  /** @brief Writes the mesh as blocks and returns its "sculpt_blocks" record. */
+  nlohmann::json WriteMeshBlocks(const SculptableMesh& mesh);
+
+  /** @brief Appends the JSON document, patches the header, closes the file. */
+  bool Finish(const nlohmann::json& sceneJson);
+
+ private:
+  void padTo(uint64_t alignment);
+
+  std::ofstream m_Stream;
+  uint64_t m_Offset = 0;
+};
+
+}  // namespace SceneBinaryFormat
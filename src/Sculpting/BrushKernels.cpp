@@ -0,0 +1,173 @@
+#include "Sculpting/BrushKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Core/UI/Curve.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define BRUSH_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions inside functions that opt in;
+// MSVC allows the intrinsics anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define BRUSH_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BRUSH_KERNELS_TARGET_AVX2
+#endif
+
+void VertexSoA::Assign(const std::vector<glm::vec3>& positions) {
+  x.resize(positions.size());
+  y.resize(positions.size());
+  z.resize(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    x[i] = positions[i].x;
+    y[i] = positions[i].y;
+    z[i] = positions[i].z;
+  }
+}
+
+namespace BrushKernels {
+namespace {
+
+// Reference implementation. The AVX2 path performs the same operations as
+// Curve::EvaluateBaked in the same order, so the two agree to the last bit on
+// IEEE-conformant hardware.
+void computeWeightsScalar(const VertexSoA& positions, const uint32_t* indices,
+                          size_t count, const glm::vec3& center, float radius,
+                          const Curve& falloff, float* outWeights) {
+  const float radiusSq = radius * radius;
+  const float invRadius = 1.0f / radius;
+
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t v = indices[i];
+    float dx = positions.x[v] - center.x;
+    float dy = positions.y[v] - center.y;
+    float dz = positions.z[v] - center.z;
+    float distSq = dx * dx + dy * dy + dz * dz;
+    outWeights[i] = distSq < radiusSq
+                        ? falloff.EvaluateBaked(std::sqrt(distSq) * invRadius)
+                        : 0.0f;
+  }
+}
+
+#ifdef BRUSH_KERNELS_X86
+BRUSH_KERNELS_TARGET_AVX2
+void computeWeightsAVX2(const VertexSoA& positions, const uint32_t* indices,
+                        size_t count, const glm::vec3& center, float radius,
+                        const Curve& falloff, float* outWeights) {
+  const float* table = falloff.GetBakedTable().data();
+  const __m256 cx = _mm256_set1_ps(center.x);
+  const __m256 cy = _mm256_set1_ps(center.y);
+  const __m256 cz = _mm256_set1_ps(center.z);
+  const __m256 radiusSq = _mm256_set1_ps(radius * radius);
+  const __m256 invRadius = _mm256_set1_ps(1.0f / radius);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 resolution =
+      _mm256_set1_ps(static_cast<float>(Curve::kBakeResolution));
+  const __m256i oneI = _mm256_set1_epi32(1);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i vi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+    __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(positions.x.data(), vi, 4), cx);
+    __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(positions.y.data(), vi, 4), cy);
+    __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(positions.z.data(), vi, 4), cz);
+    __m256 distSq = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+        _mm256_mul_ps(dz, dz));
+    __m256 inside = _mm256_cmp_ps(distSq, radiusSq, _CMP_LT_OQ);
+
+    __m256 t = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(distSq), invRadius),
+                             one);
+    __m256 scaled = _mm256_mul_ps(t, resolution);
+    __m256i slot = _mm256_cvttps_epi32(scaled);
+    __m256 frac = _mm256_sub_ps(scaled, _mm256_cvtepi32_ps(slot));
+    // Lanes outside the brush may hold any slot; point them at 0 so the table
+    // gather stays in bounds, then mask their weight away.
+    slot = _mm256_and_si256(slot, _mm256_castps_si256(inside));
+    __m256 a = _mm256_i32gather_ps(table, slot, 4);
+    __m256 b = _mm256_i32gather_ps(table, _mm256_add_epi32(slot, oneI), 4);
+    __m256 weight = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), frac));
+
+    _mm256_storeu_ps(outWeights + i, _mm256_and_ps(weight, inside));
+  }
+
+  computeWeightsScalar(positions, indices + i, count - i, center, radius,
+                       falloff, outWeights + i);
+}
+
+bool cpuSupportsAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);
+  const bool osSavesYmm = (info[2] & (1 << 27)) != 0 &&
+                          (_xgetbv(0) & 0x6) == 0x6;  // OSXSAVE, XMM+YMM state
+  if (!osSavesYmm) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif  // BRUSH_KERNELS_X86
+
+Path detectPath() {
+#ifdef BRUSH_KERNELS_X86
+  if (cpuSupportsAVX2()) return Path::AVX2;
+#endif
+  return Path::Scalar;
+}
+
+}  // namespace
+
+bool IsPathSupported(Path path) {
+  if (path == Path::Scalar) return true;
+  return GetActivePath() == Path::AVX2;
+}
+
+Path GetActivePath() {
+  static const Path s_Path = detectPath();
+  return s_Path;
+}
+
+void ComputeFalloffWeights(const VertexSoA& positions, const uint32_t* indices,
+                           size_t count, const glm::vec3& center,
+                           float radius, const Curve& falloff,
+                           float* outWeights) {
+  ComputeFalloffWeights(GetActivePath(), positions, indices, count, center,
+                        radius, falloff, outWeights);
+}
+
+void ComputeFalloffWeights(Path path, const VertexSoA& positions,
+                           const uint32_t* indices, size_t count,
+                           const glm::vec3& center, float radius,
+                           const Curve& falloff, float* outWeights) {
+  if (count == 0) return;
+  if (radius <= 0.0f) {
+    std::fill(outWeights, outWeights + count, 0.0f);
+    return;
+  }
+
+#ifdef BRUSH_KERNELS_X86
+  if (path == Path::AVX2 && IsPathSupported(Path::AVX2)) {
+    computeWeightsAVX2(positions, indices, count, center, radius, falloff,
+                       outWeights);
+    return;
+  }
+#endif
+  computeWeightsScalar(positions, indices, count, center, radius, falloff,
+                       outWeights);
+}
+
+}  // namespace BrushKernels
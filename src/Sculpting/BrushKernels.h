@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Curve;
+
+/**
+ * @brief Structure-of-arrays copy of mesh positions, so vector kernels can
+ * load eight x (or y, or z) coordinates at once.
+ */
+struct VertexSoA {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+
+  size_t Size() const { return x.size(); }
+  void Assign(const std::vector<glm::vec3>& positions);
+  void Set(uint32_t index, const glm::vec3& position) {
+    x[index] = position.x;
+    y[index] = position.y;
+    z[index] = position.z;
+  }
+};
+
+namespace BrushKernels {
+
+enum class Path { Scalar, AVX2 };
+
+/** @brief True if the CPU (and OS) can run the given path. */
+bool IsPathSupported(Path path);
+
+/** @brief The fastest supported path, detected once per process. */
+Path GetActivePath();
+
+/**
+ * @brief Computes the brush weight of each listed vertex: the baked falloff
+ * at its normalized distance from center, or 0 outside the radius.
+ * @param indices Vertex indices into positions; weights are written in the
+ * same order.
+ */
+void ComputeFalloffWeights(const VertexSoA& positions, const uint32_t* indices,
+                           size_t count, const glm::vec3& center,
+                           float radius, const Curve& falloff,
+                           float* outWeights);
+
+/** @brief Same as above with an explicit path, for tests and benchmarks. */
+void ComputeFalloffWeights(Path path, const VertexSoA& positions,
+                           const uint32_t* indices, size_t count,
+                           const glm::vec3& center, float radius,
+                           const Curve& falloff, float* outWeights);
+
+}  // namespace BrushKernels
@@ -0,0 +1,310 @@
+#include "Sculpting/MeshBVH.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "Core/Raycaster.h"
+
+namespace {
+
+constexpr int kBinCount = 12;
+constexpr uint32_t kMinSplitTriangles = 3;
+// Bounds the build depth so traversal can use a fixed-size stack.
+constexpr int kMaxDepth = 60;
+
+struct Bounds {
+  glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+  glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+  void Grow(const glm::vec3& p) {
+    min = glm::min(min, p);
+    max = glm::max(max, p);
+  }
+  void Grow(const Bounds& other) {
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+  }
+  float HalfArea() const {
+    glm::vec3 e = max - min;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+  }
+};
+
+float HalfArea(const MeshBVH::Node& node) {
+  glm::vec3 e = node.boundsMax - node.boundsMin;
+  return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+bool IntersectBounds(const glm::vec3& rayOrigin, const glm::vec3& invDirection,
+                     const MeshBVH::Node& node, float maxDistance,
+                     float& outNear) {
+  glm::vec3 t0 = (node.boundsMin - rayOrigin) * invDirection;
+  glm::vec3 t1 = (node.boundsMax - rayOrigin) * invDirection;
+  glm::vec3 tSmall = glm::min(t0, t1);
+  glm::vec3 tLarge = glm::max(t0, t1);
+  float tNear = std::max(std::max(tSmall.x, tSmall.y), tSmall.z);
+  float tFar = std::min(std::min(tLarge.x, tLarge.y), tLarge.z);
+  outNear = tNear;
+  return tFar >= std::max(tNear, 0.0f) && tNear < maxDistance;
+}
+
+}  // namespace
+
+void MeshBVH::Clear() {
+  m_Nodes.clear();
+  m_TriIndices.clear();
+  m_Centroids.clear();
+}
+
+void MeshBVH::Build(const std::vector<glm::vec3>& vertices,
+                    const std::vector<unsigned int>& indices) {
+  Clear();
+
+  const size_t triangleCount = indices.size() / 3;
+  m_Centroids.resize(triangleCount);
+  m_TriIndices.reserve(triangleCount);
+
+  for (size_t t = 0; t < triangleCount; ++t) {
+    unsigned int i0 = indices[t * 3];
+    unsigned int i1 = indices[t * 3 + 1];
+    unsigned int i2 = indices[t * 3 + 2];
+    if (i0 >= vertices.size() || i1 >= vertices.size() ||
+        i2 >= vertices.size()) {
+      continue;
+    }
+    m_Centroids[t] = (vertices[i0] + vertices[i1] + vertices[i2]) / 3.0f;
+    m_TriIndices.push_back(static_cast<uint32_t>(t));
+  }
+
+  if (m_TriIndices.empty()) {
+    m_Centroids.clear();
+    return;
+  }
+
+  // A binary tree over N leaves never needs more than 2N - 1 nodes.
+  m_Nodes.reserve(m_TriIndices.size() * 2);
+  Node root{};
+  root.leftFirst = 0;
+  root.triCount = static_cast<uint32_t>(m_TriIndices.size());
+  m_Nodes.push_back(root);
+  updateNodeBounds(m_Nodes[0], vertices, indices);
+
+  subdivide(0, vertices, indices);
+
+  m_Centroids.clear();
+  m_Centroids.shrink_to_fit();
+}
+
+void MeshBVH::Refit(const std::vector<glm::vec3>& vertices,
+                    const std::vector<unsigned int>& indices) {
+  // Children are always stored after their parent, so walking backwards
+  // visits both children before the node that encloses them.
+  for (size_t i = m_Nodes.size(); i-- > 0;) {
+    Node& node = m_Nodes[i];
+    if (node.IsLeaf()) {
+      updateNodeBounds(node, vertices, indices);
+      continue;
+    }
+    const Node& left = m_Nodes[node.leftFirst];
+    const Node& right = m_Nodes[node.leftFirst + 1];
+    node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+    node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+  }
+}
+
+bool MeshBVH::Intersect(const glm::vec3& rayOrigin,
+                        const glm::vec3& rayDirection,
+                        const std::vector<glm::vec3>& vertices,
+                        const std::vector<unsigned int>& indices,
+                        float& outDistance, int& outTriangleIndex) const {
+  outDistance = std::numeric_limits<float>::max();
+  outTriangleIndex = -1;
+  if (m_Nodes.empty()) return false;
+
+  const glm::vec3 invDirection = 1.0f / rayDirection;
+
+  float rootNear = 0.0f;
+  if (!IntersectBounds(rayOrigin, invDirection, m_Nodes[0], outDistance,
+                       rootNear)) {
+    return false;
+  }
+
+  std::array<uint32_t, kMaxDepth + 4> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const Node& node = m_Nodes[stack[--stackSize]];
+
+    if (node.IsLeaf()) {
+      for (uint32_t i = 0; i < node.triCount; ++i) {
+        uint32_t tri = m_TriIndices[node.leftFirst + i];
+        float t = 0.0f;
+        if (Raycaster::IntersectTriangle(rayOrigin, rayDirection,
+                                         vertices[indices[tri * 3]],
+                                         vertices[indices[tri * 3 + 1]],
+                                         vertices[indices[tri * 3 + 2]], t) &&
+            t < outDistance) {
+          outDistance = t;
+          outTriangleIndex = static_cast<int>(tri);
+        }
+      }
+      continue;
+    }
+
+    uint32_t nearChild = node.leftFirst;
+    uint32_t farChild = node.leftFirst + 1;
+    float nearDist = 0.0f, farDist = 0.0f;
+    bool hitNear = IntersectBounds(rayOrigin, invDirection, m_Nodes[nearChild],
+                                   outDistance, nearDist);
+    bool hitFar = IntersectBounds(rayOrigin, invDirection, m_Nodes[farChild],
+                                  outDistance, farDist);
+
+    if (hitNear && hitFar && farDist < nearDist) {
+      std::swap(nearChild, farChild);
+    }
+    // Push the far child first so the near one is popped (and can shrink
+    // outDistance) before the far one is visited.
+    if (hitNear && hitFar) {
+      stack[stackSize++] = farChild;
+      stack[stackSize++] = nearChild;
+    } else if (hitNear) {
+      stack[stackSize++] = nearChild;
+    } else if (hitFar) {
+      stack[stackSize++] = farChild;
+    }
+  }
+
+  return outTriangleIndex >= 0;
+}
+
+void MeshBVH::updateNodeBounds(Node& node,
+                               const std::vector<glm::vec3>& vertices,
+                               const std::vector<unsigned int>& indices) const {
+  Bounds bounds;
+  for (uint32_t i = 0; i < node.triCount; ++i) {
+    uint32_t tri = m_TriIndices[node.leftFirst + i];
+    bounds.Grow(vertices[indices[tri * 3]]);
+    bounds.Grow(vertices[indices[tri * 3 + 1]]);
+    bounds.Grow(vertices[indices[tri * 3 + 2]]);
+  }
+  node.boundsMin = bounds.min;
+  node.boundsMax = bounds.max;
+}
+
+void MeshBVH::subdivide(uint32_t nodeIndex,
+                        const std::vector<glm::vec3>& vertices,
+                        const std::vector<unsigned int>& indices) {
+  std::vector<std::pair<uint32_t, int>> pending;
+  pending.emplace_back(nodeIndex, 0);
+
+  while (!pending.empty()) {
+    auto [current, depth] = pending.back();
+    pending.pop_back();
+
+    const Node node = m_Nodes[current];
+    if (node.triCount < kMinSplitTriangles || depth >= kMaxDepth) continue;
+
+    int axis = 0;
+    float splitPos = 0.0f;
+    float splitCost = findBestSplit(node, vertices, indices, axis, splitPos);
+    float leafCost = static_cast<float>(node.triCount) * HalfArea(node);
+    if (splitCost >= leafCost) continue;
+
+    // Partition the triangle ids in place around the split plane.
+    uint32_t first = node.leftFirst;
+    uint32_t i = first;
+    uint32_t end = first + node.triCount;
+    while (i < end) {
+      if (m_Centroids[m_TriIndices[i]][axis] < splitPos) {
+        ++i;
+      } else {
+        std::swap(m_TriIndices[i], m_TriIndices[--end]);
+      }
+    }
+
+    uint32_t leftCount = i - first;
+    if (leftCount == 0 || leftCount == node.triCount) continue;
+
+    uint32_t leftIndex = static_cast<uint32_t>(m_Nodes.size());
+    Node left{};
+    left.leftFirst = first;
+    left.triCount = leftCount;
+    Node right{};
+    right.leftFirst = i;
+    right.triCount = node.triCount - leftCount;
+    m_Nodes.push_back(left);
+    m_Nodes.push_back(right);
+    updateNodeBounds(m_Nodes[leftIndex], vertices, indices);
+    updateNodeBounds(m_Nodes[leftIndex + 1], vertices, indices);
+
+    m_Nodes[current].leftFirst = leftIndex;
+    m_Nodes[current].triCount = 0;
+
+    pending.emplace_back(leftIndex, depth + 1);
+    pending.emplace_back(leftIndex + 1, depth + 1);
+  }
+}
+
+float MeshBVH::findBestSplit(const Node& node,
+                             const std::vector<glm::vec3>& vertices,
+                             const std::vector<unsigned int>& indices,
+                             int& outAxis, float& outSplitPos) const {
+  float bestCost = std::numeric_limits<float>::max();
+
+  for (int axis = 0; axis < 3; ++axis) {
+    float centroidMin = std::numeric_limits<float>::max();
+    float centroidMax = -std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < node.triCount; ++i) {
+      float c = m_Centroids[m_TriIndices[node.leftFirst + i]][axis];
+      centroidMin = std::min(centroidMin, c);
+      centroidMax = std::max(centroidMax, c);
+    }
+    if (centroidMin == centroidMax) continue;
+
+    std::array<Bounds, kBinCount> binBounds{};
+    std::array<uint32_t, kBinCount> binCounts{};
+    const float scale = kBinCount / (centroidMax - centroidMin);
+
+    for (uint32_t i = 0; i < node.triCount; ++i) {
+      uint32_t tri = m_TriIndices[node.leftFirst + i];
+      int bin = std::min(
+          kBinCount - 1,
+          static_cast<int>((m_Centroids[tri][axis] - centroidMin) * scale));
+      binCounts[bin]++;
+      binBounds[bin].Grow(vertices[indices[tri * 3]]);
+      binBounds[bin].Grow(vertices[indices[tri * 3 + 1]]);
+      binBounds[bin].Grow(vertices[indices[tri * 3 + 2]]);
+    }
+
+    // Sweep from both sides to get the cost of every bin boundary.
+    std::array<float, kBinCount - 1> leftArea{}, rightArea{};
+    std::array<uint32_t, kBinCount - 1> leftCount{}, rightCount{};
+    Bounds leftBox, rightBox;
+    uint32_t leftSum = 0, rightSum = 0;
+    for (int b = 0; b < kBinCount - 1; ++b) {
+      leftSum += binCounts[b];
+      leftCount[b] = leftSum;
+      leftBox.Grow(binBounds[b]);
+      leftArea[b] = leftBox.HalfArea();
+
+      rightSum += binCounts[kBinCount - 1 - b];
+      rightCount[kBinCount - 2 - b] = rightSum;
+      rightBox.Grow(binBounds[kBinCount - 1 - b]);
+      rightArea[kBinCount - 2 - b] = rightBox.HalfArea();
+    }
+
+    for (int b = 0; b < kBinCount - 1; ++b) {
+      if (leftCount[b] == 0 || rightCount[b] == 0) continue;
+      float cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+      if (cost < bestCost) {
+        bestCost = cost;
+        outAxis = axis;
+        outSplitPos = centroidMin + (b + 1) / scale;
+      }
+    }
+  }
+
+  return bestCost;
+}
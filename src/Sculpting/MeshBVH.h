@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @brief Bounding volume hierarchy over the triangles of an indexed mesh.
+ *
+ * Built top-down with a binned surface area heuristic and stored as a flat
+ * array of 32-byte nodes. Interior nodes keep their two children next to each
+ * other (left, left + 1) and always after themselves, so a refit is a single
+ * reverse sweep over the node array.
+ */
+class MeshBVH {
+ public:
+  struct Node {
+    glm::vec3 boundsMin;
+    uint32_t leftFirst;  // Left child for interior nodes, first tri for leaves
+    glm::vec3 boundsMax;
+    uint32_t triCount;  // 0 for interior nodes
+
+    bool IsLeaf() const { return triCount > 0; }
+  };
+
+  /**
+   * @brief Builds the hierarchy from scratch. Triangles that reference
+   * out-of-range vertices are left out.
+   */
+  void Build(const std::vector<glm::vec3>& vertices,
+             const std::vector<unsigned int>& indices);
+
+  /**
+   * @brief Recomputes node bounds for moved vertices. The topology must be the
+   * one the hierarchy was built with.
+   */
+  void Refit(const std::vector<glm::vec3>& vertices,
+             const std::vector<unsigned int>& indices);
+
+  /**
+   * @brief Finds the closest triangle hit along a ray (mesh-local space).
+   * @param outDistance Distance along the ray to the closest hit.
+   * @param outTriangleIndex Index of the hit triangle in the index buffer / 3.
+   * @return True if any triangle was hit.
+   */
+  bool Intersect(const glm::vec3& rayOrigin, const glm::vec3& rayDirection,
+                 const std::vector<glm::vec3>& vertices,
+                 const std::vector<unsigned int>& indices, float& outDistance,
+                 int& outTriangleIndex) const;
+
+  void Clear();
+  bool IsEmpty() const { return m_Nodes.empty(); }
+
+  const std::vector<Node>& GetNodes() const { return m_Nodes; }
+
+ private:
+  void updateNodeBounds(Node& node, const std::vector<glm::vec3>& vertices,
+                        const std::vector<unsigned int>& indices) const;
+  void subdivide(uint32_t nodeIndex, const std::vector<glm::vec3>& vertices,
+                 const std::vector<unsigned int>& indices);
+  float findBestSplit(const Node& node, const std::vector<glm::vec3>& vertices,
+                      const std::vector<unsigned int>& indices, int& outAxis,
+                      float& outSplitPos) const;
+
+  std::vector<Node> m_Nodes;
+  std::vector<uint32_t> m_TriIndices;  // Triangle ids, reordered by the build
+  std::vector<glm::vec3> m_Centroids;  // Per triangle id, only used to build
+};
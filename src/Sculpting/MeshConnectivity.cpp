@@ -0,0 +1,142 @@
+#include "Sculpting/MeshConnectivity.h"
+
+#include <algorithm>
+
+void MeshConnectivity::Build(std::span<const unsigned int> indices,
+                             size_t vertexCount) {
+  Clear();
+  const size_t faceCount = indices.size() / 3;
+  // A closed triangle mesh has about 1.5 edges per face.
+  m_Edges.reserve(faceCount + faceCount / 2 + 3);
+  m_VertexFirstEdge.assign(vertexCount, kInvalid);
+  m_HalfEdgeEdge.assign(faceCount * 3, kInvalid);
+  m_HalfEdgeNext.assign(faceCount * 3, kInvalid);
+  for (size_t face = 0; face < faceCount; ++face) {
+    attachFace(indices, static_cast<uint32_t>(face));
+  }
+}
+
+void MeshConnectivity::UpdateFaces(std::span<const unsigned int> indices,
+                                   size_t vertexCount,
+                                   std::span<const uint32_t> faces) {
+  const size_t faceCount = indices.size() / 3;
+  m_VertexFirstEdge.resize(std::max(vertexCount, m_VertexFirstEdge.size()),
+                           kInvalid);
+  m_HalfEdgeEdge.resize(faceCount * 3, kInvalid);
+  m_HalfEdgeNext.resize(faceCount * 3, kInvalid);
+
+  m_FaceScratch.assign(faces.begin(), faces.end());
+  std::sort(m_FaceScratch.begin(), m_FaceScratch.end());
+  m_FaceScratch.erase(std::unique(m_FaceScratch.begin(), m_FaceScratch.end()),
+                      m_FaceScratch.end());
+
+  // Detach everything first so an edge that only moves between the changed
+  // faces keeps its ID instead of being freed and reallocated.
+  for (uint32_t face : m_FaceScratch) {
+    if (face < faceCount) detachFace(face);
+  }
+  for (uint32_t face : m_FaceScratch) {
+    if (face < faceCount) attachFace(indices, face);
+  }
+}
+
+void MeshConnectivity::Clear() {
+  m_Edges.clear();
+  m_FreeEdges.clear();
+  m_VertexFirstEdge.clear();
+  m_HalfEdgeEdge.clear();
+  m_HalfEdgeNext.clear();
+}
+
+uint32_t MeshConnectivity::FindEdge(uint32_t a, uint32_t b) const {
+  if (a >= m_VertexFirstEdge.size() || b >= m_VertexFirstEdge.size()) {
+    return kInvalid;
+  }
+  const uint32_t lo = std::min(a, b);
+  const uint32_t hi = std::max(a, b);
+  for (uint32_t e = m_VertexFirstEdge[a]; e != kInvalid;) {
+    const Edge& edge = m_Edges[e];
+    if (edge.v0 == lo && edge.v1 == hi) return e;
+    e = edge.nextAt[edge.v0 == a ? 0 : 1];
+  }
+  return kInvalid;
+}
+
+size_t MeshConnectivity::GetMemoryBytes() const {
+  return m_Edges.capacity() * sizeof(Edge) +
+         (m_FreeEdges.capacity() + m_VertexFirstEdge.capacity() +
+          m_HalfEdgeEdge.capacity() + m_HalfEdgeNext.capacity()) *
+             sizeof(uint32_t);
+}
+
+void MeshConnectivity::detachFace(uint32_t face) {
+  for (uint32_t h = face * 3; h < face * 3 + 3; ++h) {
+    uint32_t e = m_HalfEdgeEdge[h];
+    if (e == kInvalid) continue;
+    // Rings hold a handful of half-edges, so a linear unlink is fine.
+    uint32_t* link = &m_Edges[e].firstHalfEdge;
+    while (*link != h) link = &m_HalfEdgeNext[*link];
+    *link = m_HalfEdgeNext[h];
+    m_HalfEdgeEdge[h] = kInvalid;
+    m_HalfEdgeNext[h] = kInvalid;
+    if (m_Edges[e].firstHalfEdge == kInvalid) releaseEdge(e);
+  }
+}
+
+void MeshConnectivity::attachFace(std::span<const unsigned int> indices,
+                                  uint32_t face) {
+  const size_t vertexCount = m_VertexFirstEdge.size();
+  const unsigned int* corners = &indices[face * 3];
+  if (corners[0] >= vertexCount || corners[1] >= vertexCount ||
+      corners[2] >= vertexCount) {
+    return;
+  }
+  for (int k = 0; k < 3; ++k) {
+    uint32_t a = corners[k];
+    uint32_t b = corners[(k + 1) % 3];
+    if (a == b) continue;
+    uint32_t e = FindEdge(a, b);
+    if (e == kInvalid) e = allocateEdge(a, b);
+    uint32_t h = face * 3 + k;
+    m_HalfEdgeEdge[h] = e;
+    m_HalfEdgeNext[h] = m_Edges[e].firstHalfEdge;
+    m_Edges[e].firstHalfEdge = h;
+  }
+}
+
+uint32_t MeshConnectivity::allocateEdge(uint32_t a, uint32_t b) {
+  uint32_t e;
+  if (!m_FreeEdges.empty()) {
+    e = m_FreeEdges.back();
+    m_FreeEdges.pop_back();
+  } else {
+    e = static_cast<uint32_t>(m_Edges.size());
+    m_Edges.emplace_back();
+  }
+  Edge& edge = m_Edges[e];
+  edge.v0 = std::min(a, b);
+  edge.v1 = std::max(a, b);
+  edge.firstHalfEdge = kInvalid;
+  edge.nextAt[0] = m_VertexFirstEdge[edge.v0];
+  edge.nextAt[1] = m_VertexFirstEdge[edge.v1];
+  m_VertexFirstEdge[edge.v0] = e;
+  m_VertexFirstEdge[edge.v1] = e;
+  return e;
+}
+
+void MeshConnectivity::releaseEdge(uint32_t edge) {
+  unlinkFromVertex(edge, m_Edges[edge].v0);
+  unlinkFromVertex(edge, m_Edges[edge].v1);
+  m_Edges[edge] = Edge{};
+  m_FreeEdges.push_back(edge);
+}
+
+void MeshConnectivity::unlinkFromVertex(uint32_t edge, uint32_t vertex) {
+  uint32_t* link = &m_VertexFirstEdge[vertex];
+  while (*link != edge) {
+    Edge& current = m_Edges[*link];
+    link = &current.nextAt[current.v0 == vertex ? 0 : 1];
+  }
+  const Edge& removed = m_Edges[edge];
+  *link = removed.nextAt[removed.v0 == vertex ? 0 : 1];
+}
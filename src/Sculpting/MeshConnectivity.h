@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Edge connectivity of an indexed triangle mesh, kept in flat arrays.
+ *
+ * Corner k of face f owns the half-edge 3f + k, which runs from that corner
+ * to the next one. Every undirected edge keeps a ring of the half-edges lying
+ * on it (two on a manifold interior edge, one on a boundary), and every
+ * vertex keeps a linked list of its edges threaded through the edge records.
+ * Lookups, vertex rings and edge faces therefore cost O(valence), and faces
+ * can be rewritten or appended without touching the rest of the mesh.
+ *
+ * Edge IDs are stable while the edge exists. Edges that lose their last face
+ * are recycled, so IDs may have gaps; check IsEdgeLive when iterating.
+ */
+class MeshConnectivity {
+ public:
+  static constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+
+  struct Edge {
+    uint32_t v0 = kInvalid;  // Smaller vertex index; kInvalid for a free slot
+    uint32_t v1 = kInvalid;
+    uint32_t firstHalfEdge = kInvalid;
+    uint32_t nextAt[2] = {kInvalid, kInvalid};  // Next edge around v0 / v1
+  };
+
+  /**
+   * @brief Rebuilds everything from an index buffer. Triangles referencing
+   * out-of-range vertices and the collapsed sides of degenerate triangles
+   * get no edges.
+   */
+  void Build(std::span<const unsigned int> indices, size_t vertexCount);
+
+  /**
+   * @brief Re-links the given faces after their indices were rewritten or
+   * appended. Faces past the previous end of the buffer are new. The buffer
+   * must not have shrunk.
+   */
+  void UpdateFaces(std::span<const unsigned int> indices, size_t vertexCount,
+                   std::span<const uint32_t> faces);
+
+  void Clear();
+
+  size_t GetVertexCount() const { return m_VertexFirstEdge.size(); }
+  size_t GetFaceCount() const { return m_HalfEdgeEdge.size() / 3; }
+  /** @brief Number of edge slots, including free ones. */
+  size_t GetEdgeSlotCount() const { return m_Edges.size(); }
+  size_t GetEdgeCount() const { return m_Edges.size() - m_FreeEdges.size(); }
+
+  bool IsEdgeLive(uint32_t edge) const { return m_Edges[edge].v0 != kInvalid; }
+  const Edge& GetEdge(uint32_t edge) const { return m_Edges[edge]; }
+  uint32_t GetOtherVertex(uint32_t edge, uint32_t vertex) const {
+    const Edge& e = m_Edges[edge];
+    return e.v0 == vertex ? e.v1 : e.v0;
+  }
+
+  /** @brief Returns the edge between two vertices, or kInvalid. */
+  uint32_t FindEdge(uint32_t a, uint32_t b) const;
+
+  /** @brief Edge on the side from corner k to corner k + 1 of a face. */
+  uint32_t GetFaceEdge(uint32_t face, int k) const {
+    return m_HalfEdgeEdge[face * 3 + k];
+  }
+
+  template <typename Fn>
+  void ForEachVertexEdge(uint32_t vertex, Fn&& fn) const {
+    for (uint32_t e = m_VertexFirstEdge[vertex]; e != kInvalid;) {
+      const Edge& edge = m_Edges[e];
+      uint32_t next = edge.nextAt[edge.v0 == vertex ? 0 : 1];
+      fn(e);
+      e = next;
+    }
+  }
+
+  template <typename Fn>
+  void ForEachVertexNeighbor(uint32_t vertex, Fn&& fn) const {
+    ForEachVertexEdge(vertex,
+                      [&](uint32_t e) { fn(GetOtherVertex(e, vertex), e); });
+  }
+
+  template <typename Fn>
+  void ForEachEdgeFace(uint32_t edge, Fn&& fn) const {
+    for (uint32_t h = m_Edges[edge].firstHalfEdge; h != kInvalid;
+         h = m_HalfEdgeNext[h]) {
+      fn(h / 3);
+    }
+  }
+
+  size_t GetMemoryBytes() const;
+
+ private:
+  void detachFace(uint32_t face);
+  void attachFace(std::span<const unsigned int> indices, uint32_t face);
+  uint32_t allocateEdge(uint32_t a, uint32_t b);
+  void releaseEdge(uint32_t edge);
+  void unlinkFromVertex(uint32_t edge, uint32_t vertex);
+
+  std::vector<Edge> m_Edges;
+  std::vector<uint32_t> m_FreeEdges;
+  std::vector<uint32_t> m_VertexFirstEdge;
+  std::vector<uint32_t> m_HalfEdgeEdge;  // Per corner; kInvalid if collapsed
+  std::vector<uint32_t> m_HalfEdgeNext;  // Next half-edge on the same edge
+  std::vector<uint32_t> m_FaceScratch;
+};
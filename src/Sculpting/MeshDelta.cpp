@@ -0,0 +1,217 @@
+#include "Sculpting/MeshDelta.h"
+
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "Interfaces/IEditableMesh.h"
+
+namespace {
+
+constexpr float kMaxQuantized = 32767.0f;
+
+void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t readVarint(const uint8_t*& cursor) {
+  uint32_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    uint8_t byte = *cursor++;
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return value;
+  }
+}
+
+}  // namespace
+
+VertexDelta VertexDelta::Encode(uint64_t meshBaseId,
+                                std::span<const uint32_t> indices,
+                                std::span<const glm::vec3> before,
+                                std::span<const glm::vec3> after) {
+  VertexDelta delta;
+  delta.m_BaseId = meshBaseId;
+  float maxOffset = 0.0f;
+  for (size_t k = 0; k < indices.size(); ++k) {
+    glm::vec3 offset = after[k] - before[k];
+    maxOffset = std::max({maxOffset, std::abs(offset.x), std::abs(offset.y),
+                          std::abs(offset.z)});
+  }
+  if (maxOffset == 0.0f) return delta;
+
+  delta.m_Step = maxOffset / kMaxQuantized;
+  uint32_t previous = 0;
+  for (size_t k = 0; k < indices.size(); ++k) {
+    glm::vec3 units = (after[k] - before[k]) / delta.m_Step;
+    auto x = static_cast<int16_t>(std::lround(units.x));
+    auto y = static_cast<int16_t>(std::lround(units.y));
+    auto z = static_cast<int16_t>(std::lround(units.z));
+    if (x == 0 && y == 0 && z == 0) continue;
+    appendVarint(delta.m_IndexGaps, indices[k] - previous);
+    previous = indices[k];
+    delta.m_Offsets.insert(delta.m_Offsets.end(), {x, y, z});
+    ++delta.m_Count;
+  }
+  delta.m_IndexGaps.shrink_to_fit();
+  delta.m_Offsets.shrink_to_fit();
+  return delta;
+}
+
+void VertexDelta::Decode(std::vector<uint32_t>& outIndices,
+                         std::vector<glm::vec3>& outOffsets) const {
+  outIndices.resize(m_Count);
+  outOffsets.resize(m_Count);
+  const uint8_t* cursor = m_IndexGaps.data();
+  uint32_t index = 0;
+  for (size_t k = 0; k < m_Count; ++k) {
+    index += readVarint(cursor);
+    outIndices[k] = index;
+    outOffsets[k] = glm::vec3(m_Offsets[3 * k], m_Offsets[3 * k + 1],
+                              m_Offsets[3 * k + 2]) *
+                    m_Step;
+  }
+}
+
+bool VertexDelta::Apply(IEditableMesh& mesh, bool forward) const {
+  if (IsEmpty()) return true;
+  // A regenerated mesh can have the same vertex count as the one the edit
+  // was made on; offsets applied to it would carve arbitrary dents.
+  if (mesh.GetBaseId() != m_BaseId) return false;
+  std::vector<uint32_t> indices;
+  std::vector<glm::vec3> offsets;
+  Decode(indices, offsets);
+  if (indices.back() >= std::as_const(mesh).GetVertices().size()) return false;
+
+  const float sign = forward ? 1.0f : -1.0f;
+  auto& vertices = mesh.GetVertices();
+  for (size_t k = 0; k < indices.size(); ++k) {
+    vertices[indices[k]] += offsets[k] * sign;
+  }
+  mesh.MarkVerticesDirty(indices);
+  mesh.RecalculateDirtyNormals();
+  return true;
+}
+
+size_t VertexDelta::GetMemoryBytes() const {
+  return sizeof(*this) + m_IndexGaps.capacity() +
+         m_Offsets.capacity() * sizeof(int16_t);
+}
+
+void VertexDeltaRecorder::Begin(const IEditableMesh& mesh) {
+  m_Indices.clear();
+  m_Before.clear();
+  m_Stamps.resize(mesh.GetVertices().size(), 0);
+  m_BaseId = mesh.GetBaseId();
+  if (++m_Generation == 0) {
+    std::fill(m_Stamps.begin(), m_Stamps.end(), 0);
+    m_Generation = 1;
+  }
+  m_Recording = true;
+}
+
+void VertexDeltaRecorder::Capture(const IEditableMesh& mesh,
+                                  std::span<const uint32_t> indices) {
+  if (!m_Recording) return;
+  const auto& vertices = mesh.GetVertices();
+  for (uint32_t index : indices) {
+    if (index >= m_Stamps.size() || m_Stamps[index] == m_Generation) continue;
+    m_Stamps[index] = m_Generation;
+    m_Indices.push_back(index);
+    m_Before.push_back(vertices[index]);
+  }
+}
+
+void VertexDeltaRecorder::CaptureSphere(const IEditableMesh& mesh,
+                                        const glm::vec3& center, float radius) {
+  if (!m_Recording) return;
+  mesh.QueryVerticesInSphere(center, radius, m_Scratch);
+  Capture(mesh, m_Scratch);
+}
+
+VertexDelta VertexDeltaRecorder::End(IEditableMesh& mesh) {
+  m_Recording = false;
+  const auto& current = std::as_const(mesh).GetVertices();
+  if (m_Indices.empty() || current.size() != m_Stamps.size() ||
+      mesh.GetBaseId() != m_BaseId) {
+    m_Indices.clear();
+    m_Before.clear();
+    return {};
+  }
+
+  std::vector<uint32_t> order(m_Indices.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return m_Indices[a] < m_Indices[b];
+  });
+  std::vector<uint32_t> indices(order.size());
+  std::vector<glm::vec3> before(order.size()), after(order.size());
+  for (size_t k = 0; k < order.size(); ++k) {
+    indices[k] = m_Indices[order[k]];
+    before[k] = m_Before[order[k]];
+    after[k] = current[indices[k]];
+  }
+  VertexDelta delta = VertexDelta::Encode(m_BaseId, indices, before, after);
+
+  // Snap every captured vertex to original + decoded offset; vertices left
+  // out of the delta go back to exactly where they were.
+  std::vector<uint32_t> encodedIndices;
+  std::vector<glm::vec3> offsets;
+  delta.Decode(encodedIndices, offsets);
+  auto& vertices = mesh.GetVertices();
+  size_t next = 0;
+  for (size_t k = 0; k < indices.size(); ++k) {
+    glm::vec3 snapped = before[k];
+    if (next < encodedIndices.size() && encodedIndices[next] == indices[k]) {
+      snapped += offsets[next++];
+    }
+    vertices[indices[k]] = snapped;
+  }
+  mesh.MarkVerticesDirty(indices);
+  mesh.RecalculateDirtyNormals();
+
+  m_Indices.clear();
+  m_Before.clear();
+  return delta;
+}
+
+void VertexDeltaRecorder::Cancel() {
+  m_Recording = false;
+  m_Indices.clear();
+  m_Before.clear();
+}
+
+TopologyDelta TopologyDelta::Compute(
+    const std::vector<glm::vec3>& beforeVertices,
+    const std::vector<unsigned int>& beforeIndices, const IEditableMesh& after) {
+  TopologyDelta delta;
+  delta.m_BaseId = after.GetBaseId();
+  delta.m_Vertices =
+      ArrayDiff<glm::vec3>::Compute(beforeVertices, after.GetVertices());
+  delta.m_Indices =
+      ArrayDiff<unsigned int>::Compute(beforeIndices, after.GetIndices());
+  return delta;
+}
+
+bool TopologyDelta::Apply(IEditableMesh& mesh, bool forward) const {
+  const IEditableMesh& view = mesh;
+  if (view.GetBaseId() != m_BaseId ||
+      view.GetVertices().size() !=
+          (forward ? m_Vertices.oldSize : m_Vertices.newSize) ||
+      view.GetIndices().size() !=
+          (forward ? m_Indices.oldSize : m_Indices.newSize)) {
+    return false;
+  }
+  m_Vertices.Apply(mesh.GetVertices(), forward);
+  m_Indices.Apply(mesh.GetIndices(), forward);
+  mesh.RecalculateNormals();
+  return true;
+}
+
+size_t TopologyDelta::GetMemoryBytes() const {
+  return sizeof(*this) + m_Vertices.GetMemoryBytes() +
+         m_Indices.GetMemoryBytes();
+}
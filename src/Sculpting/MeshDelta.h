@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+class IEditableMesh;
+
+/**
+ * @brief Sparse, compressed record of the vertices an edit moved and by how
+ * much, for undoing and redoing edits that keep the topology (sculpt
+ * strokes, vertex drags).
+ *
+ * Vertex indices are sorted and stored as LEB128-encoded gaps, so a brush
+ * footprint costs one or two bytes per vertex. Offsets are quantized to
+ * 16 bits per component against the largest offset in the edit. Vertices
+ * whose offset rounds to zero are left out.
+ */
+class VertexDelta {
+ public:
+  /**
+   * @brief Encodes after[i] - before[i] for each vertex indices[i] of the
+   * mesh with base ID `meshBaseId`. `indices` must be sorted and unique.
+   */
+  static VertexDelta Encode(uint64_t meshBaseId,
+                            std::span<const uint32_t> indices,
+                            std::span<const glm::vec3> before,
+                            std::span<const glm::vec3> after);
+
+  /** @brief Decodes into parallel index/offset arrays. */
+  void Decode(std::vector<uint32_t>& outIndices,
+              std::vector<glm::vec3>& outOffsets) const;
+
+  /**
+   * @brief Adds the offsets to the mesh (redo) or subtracts them (undo) and
+   * updates the normals of the moved vertices. Returns false, leaving the
+   * mesh alone, if it is not the mesh the delta was encoded for or an index
+   * is out of range.
+   */
+  bool Apply(IEditableMesh& mesh, bool forward) const;
+
+  bool IsEmpty() const { return m_Count == 0; }
+  size_t GetVertexCount() const { return m_Count; }
+  size_t GetMemoryBytes() const;
+
+ private:
+  std::vector<uint8_t> m_IndexGaps;
+  std::vector<int16_t> m_Offsets;  // Three per vertex
+  float m_Step = 0.0f;             // Offset of one quantization unit
+  size_t m_Count = 0;
+  uint64_t m_BaseId = 0;  // IEditableMesh::GetBaseId of the edited mesh
+};
+
+/**
+ * @brief Collects the original positions of the vertices an edit touches
+ * and turns them into a VertexDelta when the edit ends.
+ *
+ * Capture the vertices that are about to move before each change; a vertex
+ * keeps the position it had when it was first captured. Memory scales with
+ * the touched vertices, not the mesh, apart from one stamp per vertex that
+ * is reused between edits.
+ */
+class VertexDeltaRecorder {
+ public:
+  void Begin(const IEditableMesh& mesh);
+  bool IsRecording() const { return m_Recording; }
+
+  void Capture(const IEditableMesh& mesh, std::span<const uint32_t> indices);
+  /** @brief Captures what a brush dab at `center` can reach. */
+  void CaptureSphere(const IEditableMesh& mesh, const glm::vec3& center,
+                     float radius);
+
+  /**
+   * @brief Encodes the moves since Begin. The moved vertices are snapped to
+   * the encoded offsets, so undoing lands back on the original positions.
+   * Empty if `mesh` was regenerated or replaced since Begin.
+   */
+  VertexDelta End(IEditableMesh& mesh);
+  void Cancel();
+
+ private:
+  std::vector<uint32_t> m_Indices;
+  std::vector<glm::vec3> m_Before;
+  std::vector<uint32_t> m_Stamps;  // m_Generation where captured this edit
+  uint32_t m_Generation = 0;
+  uint64_t m_BaseId = 0;
+  std::vector<uint32_t> m_Scratch;
+  bool m_Recording = false;
+};
+
+/**
+ * @brief Difference between two versions of an array: the elements that
+ * changed in place plus whatever was appended or cut off at the end.
+ */
+template <typename T>
+struct ArrayDiff {
+  uint32_t oldSize = 0;
+  uint32_t newSize = 0;
+  std::vector<uint32_t> changed;  // Positions below min(oldSize, newSize)
+  std::vector<T> oldValues;
+  std::vector<T> newValues;
+  std::vector<T> oldTail;  // before[newSize .. oldSize)
+  std::vector<T> newTail;  // after[oldSize .. newSize)
+
+  static ArrayDiff Compute(const std::vector<T>& before,
+                           const std::vector<T>& after);
+  /** @brief Turns `values` from before into after, or back if !forward. */
+  bool Apply(std::vector<T>& values, bool forward) const;
+  bool IsEmpty() const { return oldSize == newSize && changed.empty(); }
+  size_t GetMemoryBytes() const;
+};
+
+/**
+ * @brief Minimal vertex and index changes of a topology edit (extrude,
+ * weld, bevel). Normals are recomputed when applied instead of stored.
+ */
+class TopologyDelta {
+ public:
+  static TopologyDelta Compute(const std::vector<glm::vec3>& beforeVertices,
+                               const std::vector<unsigned int>& beforeIndices,
+                               const IEditableMesh& after);
+
+  /**
+   * @brief Redoes (forward) or undoes the edit. Returns false, leaving the
+   * mesh alone, if it is not the mesh the edit was made on or not in the
+   * state the delta starts from.
+   */
+  bool Apply(IEditableMesh& mesh, bool forward) const;
+
+  bool IsEmpty() const { return m_Vertices.IsEmpty() && m_Indices.IsEmpty(); }
+  size_t GetMemoryBytes() const;
+
+ private:
+  ArrayDiff<glm::vec3> m_Vertices;
+  ArrayDiff<unsigned int> m_Indices;
+  uint64_t m_BaseId = 0;
+};
+
+template <typename T>
+ArrayDiff<T> ArrayDiff<T>::Compute(const std::vector<T>& before,
+                                   const std::vector<T>& after) {
+  ArrayDiff diff;
+  diff.oldSize = static_cast<uint32_t>(before.size());
+  diff.newSize = static_cast<uint32_t>(after.size());
+  const uint32_t common = std::min(diff.oldSize, diff.newSize);
+  for (uint32_t i = 0; i < common; ++i) {
+    if (before[i] != after[i]) {
+      diff.changed.push_back(i);
+      diff.oldValues.push_back(before[i]);
+      diff.newValues.push_back(after[i]);
+    }
+  }
+  diff.oldTail.assign(before.begin() + common, before.end());
+  diff.newTail.assign(after.begin() + common, after.end());
+  return diff;
+}
+
+template <typename T>
+bool ArrayDiff<T>::Apply(std::vector<T>& values, bool forward) const {
+  if (values.size() != (forward ? oldSize : newSize)) return false;
+  const auto& replacements = forward ? newValues : oldValues;
+  values.resize(std::min(oldSize, newSize));
+  for (size_t k = 0; k < changed.size(); ++k) {
+    values[changed[k]] = replacements[k];
+  }
+  const auto& tail = forward ? newTail : oldTail;
+  values.insert(values.end(), tail.begin(), tail.end());
+  return true;
+}
+
+template <typename T>
+size_t ArrayDiff<T>::GetMemoryBytes() const {
+  return changed.capacity() * sizeof(uint32_t) +
+         (oldValues.capacity() + newValues.capacity() + oldTail.capacity() +
+          newTail.capacity()) *
+             sizeof(T);
+}
@@ -1,5 +1,8 @@
 #include "Sculpting/MeshEditor.h"
 
+#include <utility>
+#include <vector>
+
 #include "Core/Log.h"
 #include "Interfaces/IEditableMesh.h"
 #include "Sculpting/SubObjectSelection.h"
@@ -16,7 +19,7 @@ void MeshEditor::Weld(IEditableMesh& mesh, SubObjectSelection& selection) {
 
   glm::vec3 weldPoint(0.0f);
   for (uint32_t index : selectedVertices) {
-    weldPoint += mesh.GetVertices()[index];
+    weldPoint += std::as_const(mesh).GetVertices()[index];
   }
   weldPoint /= selectedVertices.size();
 
@@ -42,8 +45,12 @@ void MeshEditor::MoveAlongNormal(IEditableMesh& mesh,
   }
   averageNormal = glm::normalize(averageNormal);
 
-  for (uint32_t index : selectedVertices) {
-    mesh.GetVertices()[index] += averageNormal * distance;
+  auto& vertices = mesh.GetVertices();
+  std::vector<uint32_t> movedVertices(selectedVertices.begin(),
+                                      selectedVertices.end());
+  for (uint32_t index : movedVertices) {
+    vertices[index] += averageNormal * distance;
   }
-  mesh.RecalculateNormals();
+  mesh.MarkVerticesDirty(movedVertices);
+  mesh.RecalculateDirtyNormals();
 }
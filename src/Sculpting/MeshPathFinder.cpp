@@ -0,0 +1,84 @@
+#include "Sculpting/MeshPathFinder.h"
+
+#include <algorithm>
+
+#include "Interfaces/IEditableMesh.h"
+#include "Sculpting/MeshConnectivity.h"
+
+bool MeshPathFinder::FindPath(const IEditableMesh& mesh, uint32_t start,
+                              uint32_t goal, PathMetric metric,
+                              std::vector<uint32_t>& outPath) {
+  outPath.clear();
+  m_LastExpanded = 0;
+  const MeshConnectivity& connectivity = mesh.GetConnectivity();
+  const auto& vertices = mesh.GetVertices();
+  const size_t vertexCount =
+      std::min(connectivity.GetVertexCount(), vertices.size());
+  if (start >= vertexCount || goal >= vertexCount) return false;
+
+  beginSearch(vertexCount);
+  const bool byLength = metric == PathMetric::EdgeLength;
+  // Straight-line distance never overestimates a path along edges. Counting
+  // edges has no cheap bound, so that search is plain Dijkstra.
+  auto heuristic = [&](uint32_t v) {
+    return byLength ? glm::distance(vertices[v], vertices[goal]) : 0.0f;
+  };
+  auto later = [](const OpenEntry& a, const OpenEntry& b) {
+    return a.priority > b.priority;
+  };
+
+  m_Nodes[start] = {0.0f, start, m_Generation, false};
+  m_Open.push_back({heuristic(start), start});
+  bool found = false;
+  while (!m_Open.empty()) {
+    std::pop_heap(m_Open.begin(), m_Open.end(), later);
+    const uint32_t u = m_Open.back().vertex;
+    m_Open.pop_back();
+    Node& node = m_Nodes[u];
+    if (node.closed) continue;  // Stale entry for an improved vertex
+    node.closed = true;
+    ++m_LastExpanded;
+    if (u == goal) {
+      found = true;
+      break;
+    }
+
+    const float cost = node.cost;
+    connectivity.ForEachVertexNeighbor(u, [&](uint32_t v, uint32_t) {
+      const float step =
+          byLength ? glm::distance(vertices[u], vertices[v]) : 1.0f;
+      Node& next = m_Nodes[v];
+      if (next.generation != m_Generation) {
+        next = {cost + step, u, m_Generation, false};
+      } else if (next.closed || cost + step >= next.cost) {
+        return;
+      } else {
+        next.cost = cost + step;
+        next.parent = u;
+      }
+      m_Open.push_back({next.cost + heuristic(v), v});
+      std::push_heap(m_Open.begin(), m_Open.end(), later);
+    });
+  }
+  m_Open.clear();
+  if (!found) return false;
+
+  for (uint32_t v = goal; v != start; v = m_Nodes[v].parent) {
+    outPath.push_back(v);
+  }
+  outPath.push_back(start);
+  std::reverse(outPath.begin(), outPath.end());
+  return true;
+}
+
+void MeshPathFinder::beginSearch(size_t vertexCount) {
+  if (m_Nodes.size() != vertexCount) {
+    m_Nodes.assign(vertexCount, Node{});
+    m_Generation = 0;
+  }
+  if (++m_Generation == 0) {
+    std::fill(m_Nodes.begin(), m_Nodes.end(), Node{});
+    m_Generation = 1;
+  }
+  m_Open.clear();
+}
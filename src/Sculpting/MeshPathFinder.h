@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class IEditableMesh;
+
+/** @brief What a mesh path minimizes. */
+enum class PathMetric { EdgeCount, EdgeLength };
+
+/**
+ * @brief A* search along mesh edges, over the mesh's cached connectivity.
+ *
+ * Per-vertex search state lives in dense arrays that are reused between
+ * searches; a generation stamp marks which entries belong to the current
+ * search, so starting a new one costs nothing regardless of mesh size.
+ */
+class MeshPathFinder {
+ public:
+  /**
+   * @brief Finds a shortest path from start to goal. The result lists the
+   * vertices from start to goal, inclusive.
+   * @return False if the two vertices are not connected or out of range.
+   */
+  bool FindPath(const IEditableMesh& mesh, uint32_t start, uint32_t goal,
+                PathMetric metric, std::vector<uint32_t>& outPath);
+
+  /** @brief Vertices expanded by the last search. */
+  size_t GetLastExpandedCount() const { return m_LastExpanded; }
+
+ private:
+  struct Node {
+    float cost = 0.0f;
+    uint32_t parent = 0;
+    uint32_t generation = 0;
+    bool closed = false;
+  };
+  struct OpenEntry {
+    float priority;
+    uint32_t vertex;
+  };
+
+  void beginSearch(size_t vertexCount);
+
+  std::vector<Node> m_Nodes;
+  std::vector<OpenEntry> m_Open;  // Binary heap, smallest priority first
+  uint32_t m_Generation = 0;
+  size_t m_LastExpanded = 0;
+};
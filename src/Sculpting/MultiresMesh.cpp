@@ -0,0 +1,242 @@
+#include "Sculpting/MultiresMesh.h"
+
+#include "Core/JobSystem.h"
+#include "Interfaces/IEditableMesh.h"
+#include "Sculpting/MeshConnectivity.h"
+#include "Sculpting/SculptableMesh.h"
+
+namespace {
+
+constexpr size_t kMinVerticesPerJob = 4096;
+
+// Corner of a face that is on neither end of an edge, or kInvalid for a
+// degenerate face.
+uint32_t oppositeCorner(const std::vector<unsigned int>& indices,
+                        uint32_t face, uint32_t a, uint32_t b) {
+  for (int k = 0; k < 3; ++k) {
+    uint32_t corner = indices[face * 3 + k];
+    if (corner != a && corner != b) return corner;
+  }
+  return MeshConnectivity::kInvalid;
+}
+
+}  // namespace
+
+MultiresMesh::MultiresMesh(const IEditableMesh& base) {
+  Level level;
+  level.indices = base.GetIndices();
+  level.displacements = base.GetVertices();
+  m_Levels.push_back(std::move(level));
+}
+
+bool MultiresMesh::AddLevel() {
+  const Level& coarse = m_Levels.back();
+  const size_t coarseFaceCount = coarse.indices.size() / 3;
+  if (coarseFaceCount * 4 > kMaxFaces) return false;
+
+  const uint32_t vertexCount = static_cast<uint32_t>(coarse.displacements.size());
+  MeshConnectivity connectivity;
+  connectivity.Build(coarse.indices, vertexCount);
+  // A fresh build has no free edge slots, so edge e gets odd vertex
+  // vertexCount + e and the coarse vertices keep their indices.
+  const uint32_t edgeCount = static_cast<uint32_t>(connectivity.GetEdgeSlotCount());
+  const size_t fineVertexCount = size_t(vertexCount) + edgeCount;
+
+  // Edges with other than two faces, or whose second face is degenerate,
+  // are treated as creases: boundary rules on both sides.
+  std::vector<uint32_t> opposite(size_t(edgeCount) * 2, MeshConnectivity::kInvalid);
+  std::vector<uint8_t> isCrease(edgeCount, 1);
+  JobSystem::Get().ParallelFor(edgeCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+      const MeshConnectivity::Edge& edge = connectivity.GetEdge(static_cast<uint32_t>(e));
+      int faceCount = 0;
+      connectivity.ForEachEdgeFace(static_cast<uint32_t>(e), [&](uint32_t face) {
+        if (faceCount < 2) {
+          opposite[e * 2 + faceCount] = oppositeCorner(coarse.indices, face, edge.v0, edge.v1);
+        }
+        ++faceCount;
+      });
+      isCrease[e] = faceCount != 2 ||
+                    opposite[e * 2] == MeshConnectivity::kInvalid ||
+                    opposite[e * 2 + 1] == MeshConnectivity::kInvalid;
+    }
+  });
+
+  // Even vertices: interior ones use Loop's valence-weighted mask, vertices
+  // on exactly two crease edges the boundary curve mask, and corners or
+  // non-manifold vertices stay put.
+  auto evenStencilSize = [&](uint32_t v, uint32_t& creaseCount) {
+    uint32_t valence = 0;
+    creaseCount = 0;
+    connectivity.ForEachVertexEdge(v, [&](uint32_t e) {
+      ++valence;
+      creaseCount += isCrease[e];
+    });
+    if (creaseCount == 2) return 3u;
+    if (creaseCount > 0) return 1u;
+    return 1 + valence;
+  };
+  auto stencilSize = [&](size_t v) {
+    if (v < vertexCount) {
+      uint32_t creaseCount;
+      return evenStencilSize(static_cast<uint32_t>(v), creaseCount);
+    }
+    return isCrease[v - vertexCount] ? 2u : 4u;
+  };
+
+  Level fine;
+  fine.stencilOffsets.assign(fineVertexCount + 1, 0);
+  JobSystem::Get().ParallelFor(fineVertexCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) fine.stencilOffsets[v + 1] = stencilSize(v);
+  });
+  for (size_t v = 0; v < fineVertexCount; ++v) {
+    fine.stencilOffsets[v + 1] += fine.stencilOffsets[v];
+  }
+  fine.stencilSources.resize(fine.stencilOffsets[fineVertexCount]);
+  fine.stencilWeights.resize(fine.stencilOffsets[fineVertexCount]);
+
+  JobSystem::Get().ParallelFor(fineVertexCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      uint32_t* sources = &fine.stencilSources[fine.stencilOffsets[v]];
+      float* weights = &fine.stencilWeights[fine.stencilOffsets[v]];
+      if (v >= vertexCount) {
+        const uint32_t e = static_cast<uint32_t>(v - vertexCount);
+        const MeshConnectivity::Edge& edge = connectivity.GetEdge(e);
+        sources[0] = edge.v0;
+        sources[1] = edge.v1;
+        if (isCrease[e]) {
+          weights[0] = weights[1] = 0.5f;
+        } else {
+          sources[2] = opposite[e * 2];
+          sources[3] = opposite[e * 2 + 1];
+          weights[0] = weights[1] = 3.0f / 8.0f;
+          weights[2] = weights[3] = 1.0f / 8.0f;
+        }
+        continue;
+      }
+
+      const uint32_t vertex = static_cast<uint32_t>(v);
+      uint32_t creaseCount;
+      const uint32_t size = evenStencilSize(vertex, creaseCount);
+      sources[0] = vertex;
+      if (size == 1) {
+        weights[0] = 1.0f;
+      } else if (creaseCount == 2) {
+        weights[0] = 3.0f / 4.0f;
+        uint32_t k = 1;
+        connectivity.ForEachVertexEdge(vertex, [&](uint32_t e) {
+          if (!isCrease[e]) return;
+          sources[k] = connectivity.GetOtherVertex(e, vertex);
+          weights[k++] = 1.0f / 8.0f;
+        });
+      } else {
+        const uint32_t valence = size - 1;
+        const float beta = valence == 3 ? 3.0f / 16.0f : 3.0f / (8.0f * valence);
+        weights[0] = 1.0f - valence * beta;
+        uint32_t k = 1;
+        connectivity.ForEachVertexNeighbor(vertex, [&](uint32_t neighbor, uint32_t) {
+          sources[k] = neighbor;
+          weights[k++] = beta;
+        });
+      }
+    }
+  });
+
+  // Every triangle becomes four, keeping its winding. Triangles without
+  // three edges (degenerate or out of range) are dropped.
+  fine.indices.reserve(coarse.indices.size() * 4);
+  for (uint32_t face = 0; face < coarseFaceCount; ++face) {
+    uint32_t e0 = connectivity.GetFaceEdge(face, 0);
+    uint32_t e1 = connectivity.GetFaceEdge(face, 1);
+    uint32_t e2 = connectivity.GetFaceEdge(face, 2);
+    if (e0 == MeshConnectivity::kInvalid || e1 == MeshConnectivity::kInvalid ||
+        e2 == MeshConnectivity::kInvalid) {
+      continue;
+    }
+    const unsigned int a = coarse.indices[face * 3];
+    const unsigned int b = coarse.indices[face * 3 + 1];
+    const unsigned int c = coarse.indices[face * 3 + 2];
+    const unsigned int ab = vertexCount + e0;
+    const unsigned int bc = vertexCount + e1;
+    const unsigned int ca = vertexCount + e2;
+    fine.indices.insert(fine.indices.end(),
+                        {a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca});
+  }
+
+  fine.displacements.assign(fineVertexCount, glm::vec3(0.0f));
+  m_Levels.push_back(std::move(fine));
+  return true;
+}
+
+void MultiresMesh::RemoveLevelsAbove(int level) {
+  if (level >= 0 && level < static_cast<int>(m_Levels.size())) {
+    m_Levels.resize(level + 1);
+  }
+}
+
+bool MultiresMesh::Store(int level, const IEditableMesh& mesh) {
+  if (level < 0 || level > GetMaxLevel()) return false;
+  const auto& positions = mesh.GetVertices();
+  if (positions.size() != m_Levels[level].displacements.size() ||
+      mesh.GetIndices() != m_Levels[level].indices) {
+    return false;
+  }
+
+  const std::vector<std::vector<glm::vec3>> before = evaluate(level);
+  std::vector<std::vector<glm::vec3>> after(level + 1);
+  after[level] = positions;
+  // Each coarse vertex is also a vertex one level up; it takes that
+  // vertex's change.
+  for (int k = level - 1; k >= 0; --k) {
+    after[k] = before[k];
+    for (size_t v = 0; v < after[k].size(); ++v) {
+      after[k][v] += after[k + 1][v] - before[k + 1][v];
+    }
+  }
+
+  m_Levels[0].displacements = after[0];
+  std::vector<glm::vec3> smooth;
+  for (int k = 1; k <= level; ++k) {
+    subdivide(m_Levels[k], after[k - 1], smooth);
+    auto& displacements = m_Levels[k].displacements;
+    for (size_t v = 0; v < displacements.size(); ++v) {
+      displacements[v] = after[k][v] - smooth[v];
+    }
+  }
+  return true;
+}
+
+void MultiresMesh::Extract(int level, SculptableMesh& out) const {
+  std::vector<std::vector<glm::vec3>> positions = evaluate(level);
+  out.InitializeFromBuffers(positions[level], m_Levels[level].indices);
+}
+
+std::vector<std::vector<glm::vec3>> MultiresMesh::evaluate(int level) const {
+  std::vector<std::vector<glm::vec3>> positions(level + 1);
+  positions[0] = m_Levels[0].displacements;
+  for (int k = 1; k <= level; ++k) {
+    subdivide(m_Levels[k], positions[k - 1], positions[k]);
+    const auto& displacements = m_Levels[k].displacements;
+    auto& current = positions[k];
+    JobSystem::Get().ParallelFor(current.size(), kMinVerticesPerJob, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) current[v] += displacements[v];
+    });
+  }
+  return positions;
+}
+
+void MultiresMesh::subdivide(const Level& fine,
+                             const std::vector<glm::vec3>& coarse,
+                             std::vector<glm::vec3>& out) const {
+  const size_t vertexCount = fine.stencilOffsets.size() - 1;
+  out.resize(vertexCount);
+  JobSystem::Get().ParallelFor(vertexCount, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      glm::vec3 position(0.0f);
+      for (uint32_t k = fine.stencilOffsets[v]; k < fine.stencilOffsets[v + 1]; ++k) {
+        position += coarse[fine.stencilSources[k]] * fine.stencilWeights[k];
+      }
+      out[v] = position;
+    }
+  });
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class IEditableMesh;
+class SculptableMesh;
+
+/**
+ * @brief Loop subdivision levels over a base mesh, with a stored
+ * displacement per level.
+ *
+ * Level 0 is the base cage. The positions of level k are the Loop
+ * subdivision of level k - 1 plus that level's displacements, so detail
+ * sculpted at a fine level rides along when a coarser level is edited.
+ *
+ * The topology of every level is computed once, when the level is added,
+ * as an index buffer plus one weight stencil per vertex. Evaluating a
+ * level then costs one parallel pass per level below it and needs no
+ * adjacency lookups.
+ */
+class MultiresMesh {
+ public:
+  // Keeps a runaway subdivide from exhausting memory.
+  static constexpr size_t kMaxFaces = size_t(16) << 20;
+
+  /** @brief Takes the base cage; no subdivision levels yet. */
+  explicit MultiresMesh(const IEditableMesh& base);
+
+  /** @brief Highest subdivision level; 0 when there is only the base. */
+  int GetMaxLevel() const { return static_cast<int>(m_Levels.size()) - 1; }
+  size_t GetFaceCount(int level) const {
+    return m_Levels[level].indices.size() / 3;
+  }
+  size_t GetVertexCount(int level) const {
+    return m_Levels[level].displacements.size();
+  }
+
+  /**
+   * @brief Subdivides the finest level once. The new level starts as the
+   * smooth limit of the one below it.
+   * @return False if the new level would exceed kMaxFaces.
+   */
+  bool AddLevel();
+
+  /** @brief Drops every level above the given one. */
+  void RemoveLevelsAbove(int level);
+
+  /**
+   * @brief Takes the positions of a mesh edited at the given level.
+   *
+   * The level becomes exactly the edited mesh. Each coarser level moves
+   * its vertices by the change of the same vertex one level up, and its
+   * displacements absorb the rest; finer levels keep their displacements
+   * and so follow the edit.
+   * @return False if the mesh no longer has that level's topology.
+   */
+  bool Store(int level, const IEditableMesh& mesh);
+
+  /** @brief Replaces out's contents with the given level. */
+  void Extract(int level, SculptableMesh& out) const;
+
+ private:
+  struct Level {
+    std::vector<unsigned int> indices;
+    std::vector<glm::vec3> displacements;  // Absolute positions at level 0
+    // Vertex v of this level is the sum of weights[k] * (vertex sources[k]
+    // of the level below) over k in [offsets[v], offsets[v + 1]).
+    std::vector<uint32_t> stencilOffsets;
+    std::vector<uint32_t> stencilSources;
+    std::vector<float> stencilWeights;
+  };
+
+  /** @brief Positions of every level up to and including the given one. */
+  std::vector<std::vector<glm::vec3>> evaluate(int level) const;
+  void subdivide(const Level& fine, const std::vector<glm::vec3>& coarse,
+                 std::vector<glm::vec3>& out) const;
+
+  std::vector<Level> m_Levels;
+};
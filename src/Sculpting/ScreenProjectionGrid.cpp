@@ -0,0 +1,233 @@
+#include "Sculpting/ScreenProjectionGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtx/norm.hpp>
+
+#include "Interfaces/IEditableMesh.h"
+#include "Sculpting/MeshConnectivity.h"
+
+namespace {
+
+// Same threshold the unaccelerated picking used.
+constexpr float kMinFacing = 0.1f;
+
+float pointToSegmentDistance(const glm::vec2& p, const glm::vec2& a,
+                             const glm::vec2& b) {
+  glm::vec2 ab = b - a;
+  float l2 = glm::dot(ab, ab);
+  if (l2 == 0.0f) return glm::distance(p, a);
+  float t = std::clamp(glm::dot(p - a, ab) / l2, 0.0f, 1.0f);
+  return glm::distance(p, a + t * ab);
+}
+
+}  // namespace
+
+void ScreenProjectionGrid::Update(const IEditableMesh& mesh, const View& view) {
+  // Revisions are unique across meshes, so a new mesh at a freed one's
+  // address still misses; the vertex count guards the index ranges anyway.
+  if (m_Mesh == &mesh && m_Revision == mesh.GetRevision() &&
+      m_ScreenPositions.size() == mesh.GetVertices().size() &&
+      m_View == view) {
+    return;
+  }
+  m_Mesh = &mesh;
+  m_Revision = mesh.GetRevision();
+  m_View = view;
+  m_EdgeBucketsValid = false;
+  ++m_ProjectionCount;
+
+  const auto& vertices = mesh.GetVertices();
+  const auto& normals = mesh.GetNormals();
+  const size_t vertexCount = vertices.size();
+  const glm::mat4 modelViewProjection = view.viewProjection * view.modelMatrix;
+  m_NormalMatrix = glm::mat3(glm::transpose(glm::inverse(view.modelMatrix)));
+  m_ScreenPositions.resize(vertexCount);
+  m_InFront.resize(vertexCount);
+  m_Pickable.resize(vertexCount);
+
+  for (size_t i = 0; i < vertexCount; ++i) {
+    glm::vec4 clip = modelViewProjection * glm::vec4(vertices[i], 1.0f);
+    m_InFront[i] = clip.w > 0.0f;
+    m_Pickable[i] = m_InFront[i];
+    if (!m_InFront[i]) continue;
+    glm::vec2 ndc = glm::vec2(clip) / clip.w;
+    m_ScreenPositions[i] =
+        glm::vec2((ndc.x + 1.0f) * 0.5f * view.viewportWidth,
+                  (1.0f - ndc.y) * 0.5f * view.viewportHeight);
+    if (view.cullBackfaces && i < normals.size()) {
+      glm::vec3 normal = glm::normalize(m_NormalMatrix * normals[i]);
+      if (glm::dot(normal, -view.cameraForward) < kMinFacing) {
+        m_Pickable[i] = 0;
+      }
+    }
+  }
+
+  m_Columns = std::max(
+      1, static_cast<int>(std::ceil(view.viewportWidth / kCellSize)));
+  m_Rows = std::max(
+      1, static_cast<int>(std::ceil(view.viewportHeight / kCellSize)));
+  const size_t cellCount = static_cast<size_t>(m_Columns) * m_Rows;
+
+  // Count, prefix-sum, fill: each cell lists its vertices in index order.
+  std::vector<uint32_t> vertexCell(vertexCount, MeshConnectivity::kInvalid);
+  m_VertexCellOffsets.assign(cellCount + 1, 0);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    CellRange range;
+    if (!m_Pickable[i] ||
+        !cellRange(m_ScreenPositions[i], m_ScreenPositions[i], range)) {
+      continue;
+    }
+    vertexCell[i] = static_cast<uint32_t>(range.y0 * m_Columns + range.x0);
+    ++m_VertexCellOffsets[vertexCell[i] + 1];
+  }
+  for (size_t c = 0; c < cellCount; ++c) {
+    m_VertexCellOffsets[c + 1] += m_VertexCellOffsets[c];
+  }
+  m_VertexCells.resize(m_VertexCellOffsets[cellCount]);
+  std::vector<uint32_t> cursor(m_VertexCellOffsets.begin(),
+                               m_VertexCellOffsets.end() - 1);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    if (vertexCell[i] != MeshConnectivity::kInvalid) {
+      m_VertexCells[cursor[vertexCell[i]]++] = static_cast<uint32_t>(i);
+    }
+  }
+}
+
+int ScreenProjectionGrid::FindClosestVertex(const glm::vec2& screenPos,
+                                            float maxDistance) const {
+  CellRange range;
+  if (!m_Mesh || !cellRange(screenPos - maxDistance, screenPos + maxDistance,
+                            range)) {
+    return -1;
+  }
+  int closest = -1;
+  float minDistanceSq = maxDistance * maxDistance;
+  for (int y = range.y0; y <= range.y1; ++y) {
+    for (int x = range.x0; x <= range.x1; ++x) {
+      const size_t cell = static_cast<size_t>(y) * m_Columns + x;
+      for (uint32_t k = m_VertexCellOffsets[cell];
+           k < m_VertexCellOffsets[cell + 1]; ++k) {
+        uint32_t vertex = m_VertexCells[k];
+        float distanceSq = glm::distance2(screenPos, m_ScreenPositions[vertex]);
+        if (distanceSq < minDistanceSq ||
+            (distanceSq == minDistanceSq && closest > static_cast<int>(vertex))) {
+          minDistanceSq = distanceSq;
+          closest = static_cast<int>(vertex);
+        }
+      }
+    }
+  }
+  return closest;
+}
+
+std::pair<int, int> ScreenProjectionGrid::FindClosestEdge(
+    const IEditableMesh& mesh, const glm::vec2& screenPos, float maxDistance) {
+  std::pair<int, int> closest = {-1, -1};
+  CellRange range;
+  if (m_Mesh != &mesh || !cellRange(screenPos - maxDistance,
+                                    screenPos + maxDistance, range)) {
+    return closest;
+  }
+  if (!m_EdgeBucketsValid) buildEdgeBuckets(mesh);
+
+  const MeshConnectivity& connectivity = mesh.GetConnectivity();
+  float minDistance = maxDistance;
+  uint32_t closestEdge = MeshConnectivity::kInvalid;
+  for (int y = range.y0; y <= range.y1; ++y) {
+    for (int x = range.x0; x <= range.x1; ++x) {
+      const size_t cell = static_cast<size_t>(y) * m_Columns + x;
+      for (uint32_t k = m_EdgeCellOffsets[cell]; k < m_EdgeCellOffsets[cell + 1];
+           ++k) {
+        uint32_t edge = m_EdgeCells[k];
+        const MeshConnectivity::Edge& record = connectivity.GetEdge(edge);
+        float distance = pointToSegmentDistance(
+            screenPos, m_ScreenPositions[record.v0],
+            m_ScreenPositions[record.v1]);
+        // Long edges sit in several cells; the ID tie-break keeps the
+        // answer independent of the order cells are visited in.
+        if (distance < minDistance ||
+            (distance == minDistance && edge < closestEdge)) {
+          minDistance = distance;
+          closestEdge = edge;
+        }
+      }
+    }
+  }
+  if (closestEdge != MeshConnectivity::kInvalid) {
+    const MeshConnectivity::Edge& record = connectivity.GetEdge(closestEdge);
+    closest = {static_cast<int>(record.v0), static_cast<int>(record.v1)};
+  }
+  return closest;
+}
+
+bool ScreenProjectionGrid::cellRange(glm::vec2 boundsMin, glm::vec2 boundsMax,
+                                     CellRange& outRange) const {
+  // Items up to one cell outside the viewport are kept in the border cells,
+  // so a pick radius reaching past the edge still finds them.
+  const float width = static_cast<float>(m_View.viewportWidth);
+  const float height = static_cast<float>(m_View.viewportHeight);
+  if (boundsMax.x < -kCellSize || boundsMax.y < -kCellSize ||
+      boundsMin.x >= width + kCellSize || boundsMin.y >= height + kCellSize) {
+    return false;
+  }
+  auto clampCell = [](float value, int count) {
+    return std::clamp(static_cast<int>(std::floor(value / kCellSize)), 0,
+                      count - 1);
+  };
+  outRange = {clampCell(boundsMin.x, m_Columns), clampCell(boundsMin.y, m_Rows),
+              clampCell(boundsMax.x, m_Columns), clampCell(boundsMax.y, m_Rows)};
+  return true;
+}
+
+void ScreenProjectionGrid::buildEdgeBuckets(const IEditableMesh& mesh) {
+  const MeshConnectivity& connectivity = mesh.GetConnectivity();
+  const auto& normals = mesh.GetNormals();
+  const size_t cellCount = static_cast<size_t>(m_Columns) * m_Rows;
+  const size_t vertexCount = m_ScreenPositions.size();
+
+  auto edgeRange = [&](uint32_t e, CellRange& range) {
+    if (!connectivity.IsEdgeLive(e)) return false;
+    const MeshConnectivity::Edge& edge = connectivity.GetEdge(e);
+    if (edge.v1 >= vertexCount || !m_InFront[edge.v0] || !m_InFront[edge.v1]) {
+      return false;
+    }
+    if (m_View.cullBackfaces && edge.v1 < normals.size()) {
+      glm::vec3 normal = glm::normalize(
+          m_NormalMatrix * glm::normalize(normals[edge.v0] + normals[edge.v1]));
+      if (glm::dot(normal, -m_View.cameraForward) < kMinFacing) return false;
+    }
+    const glm::vec2& a = m_ScreenPositions[edge.v0];
+    const glm::vec2& b = m_ScreenPositions[edge.v1];
+    return cellRange(glm::min(a, b), glm::max(a, b), range);
+  };
+
+  // Same two-pass fill as the vertices; the second pass repeats the range
+  // computation rather than storing it per edge.
+  m_EdgeCellOffsets.assign(cellCount + 1, 0);
+  const uint32_t slotCount = static_cast<uint32_t>(connectivity.GetEdgeSlotCount());
+  CellRange range;
+  for (uint32_t e = 0; e < slotCount; ++e) {
+    if (!edgeRange(e, range)) continue;
+    for (int y = range.y0; y <= range.y1; ++y) {
+      for (int x = range.x0; x <= range.x1; ++x) {
+        ++m_EdgeCellOffsets[static_cast<size_t>(y) * m_Columns + x + 1];
+      }
+    }
+  }
+  for (size_t c = 0; c < cellCount; ++c) {
+    m_EdgeCellOffsets[c + 1] += m_EdgeCellOffsets[c];
+  }
+  m_EdgeCells.resize(m_EdgeCellOffsets[cellCount]);
+  std::vector<uint32_t> cursor(m_EdgeCellOffsets.begin(),
+                               m_EdgeCellOffsets.end() - 1);
+  for (uint32_t e = 0; e < slotCount; ++e) {
+    if (!edgeRange(e, range)) continue;
+    for (int y = range.y0; y <= range.y1; ++y) {
+      for (int x = range.x0; x <= range.x1; ++x) {
+        m_EdgeCells[cursor[static_cast<size_t>(y) * m_Columns + x]++] = e;
+      }
+    }
+  }
+  m_EdgeBucketsValid = true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility>
+#include <vector>
+
+class IEditableMesh;
+
+/**
+ * @brief Screen-space projection of one mesh, bucketed into a uniform 2D grid
+ * for vertex and edge picking.
+ *
+ * Vertices are projected once per change of camera, model matrix, viewport
+ * or mesh revision, and edges are bucketed into every cell their screen
+ * bounds overlap the first time an edge query needs them. A query then only
+ * visits the cells within its pick radius, so hovering over a dense mesh
+ * costs about the same as hovering over a cube.
+ */
+class ScreenProjectionGrid {
+ public:
+  static constexpr float kCellSize = 32.0f;  // Pixels; above any pick radius
+
+  struct View {
+    glm::mat4 modelMatrix;
+    glm::mat4 viewProjection;
+    glm::vec3 cameraForward;
+    int viewportWidth;
+    int viewportHeight;
+    bool cullBackfaces;
+
+    bool operator==(const View&) const = default;
+  };
+
+  /** @brief Reprojects the mesh if it or the view changed since last time. */
+  void Update(const IEditableMesh& mesh, const View& view);
+
+  /** @brief Closest visible vertex within maxDistance pixels, or -1. */
+  int FindClosestVertex(const glm::vec2& screenPos, float maxDistance) const;
+
+  /** @brief Closest visible edge within maxDistance pixels as (smaller,
+   * larger) vertex index, or {-1, -1}. */
+  std::pair<int, int> FindClosestEdge(const IEditableMesh& mesh,
+                                      const glm::vec2& screenPos,
+                                      float maxDistance);
+
+  /** @brief Forces the next Update to reproject, e.g. for another object. */
+  void Invalidate() { m_Mesh = nullptr; }
+
+  /** @brief Number of times the vertices were reprojected. */
+  size_t GetProjectionCount() const { return m_ProjectionCount; }
+
+ private:
+  struct CellRange {
+    int x0, y0, x1, y1;
+  };
+
+  bool cellRange(glm::vec2 boundsMin, glm::vec2 boundsMax,
+                 CellRange& outRange) const;
+  void buildEdgeBuckets(const IEditableMesh& mesh);
+
+  const IEditableMesh* m_Mesh = nullptr;
+  uint64_t m_Revision = 0;
+  View m_View{};
+
+  int m_Columns = 0;
+  int m_Rows = 0;
+  glm::mat3 m_NormalMatrix{1.0f};
+  std::vector<glm::vec2> m_ScreenPositions;
+  std::vector<uint8_t> m_InFront;  // In front of the camera
+  std::vector<uint8_t> m_Pickable;  // In front and, if culling, facing it
+
+  // Cell -> items in CSR form, row-major cells.
+  std::vector<uint32_t> m_VertexCellOffsets;
+  std::vector<uint32_t> m_VertexCells;
+  bool m_EdgeBucketsValid = false;
+  std::vector<uint32_t> m_EdgeCellOffsets;
+  std::vector<uint32_t> m_EdgeCells;  // Connectivity edge IDs
+
+  size_t m_ProjectionCount = 0;
+};
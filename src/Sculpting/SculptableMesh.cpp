@@ -1,12 +1,26 @@
 #include "Sculpting/SculptableMesh.h"
 
 #include <algorithm> // For std::min_element
+#include <atomic>
 #include <map>
 #include <numeric>
 
+#include "Core/JobSystem.h"
 #include "Core/JsonGlmHelpers.h"
 #include "Core/Log.h"
 
+namespace {
+// Chunk sizes below which splitting work across threads does not pay off.
+constexpr size_t kMinFacesPerJob = 4096;
+constexpr size_t kMinVerticesPerJob = 4096;
+}  // namespace
+
+uint64_t SculptableMesh::nextStamp() {
+  // Shared by all meshes, so a stamp is never handed out twice.
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 void SculptableMesh::Initialize(const std::vector<float>& vertices,
                                 const std::vector<unsigned int>& indices) {
   m_Vertices.clear();
@@ -15,13 +29,43 @@ void SculptableMesh::Initialize(const std::vector<float>& vertices,
   }
 
   m_Indices = indices;
+  m_BaseId = nextStamp();
+  markTopologyChanged();
 
   m_Normals.resize(m_Vertices.size(), glm::vec3(0.0f));
 
   RecalculateNormals();
 }
 
+void SculptableMesh::InitializeFromBuffers(
+    std::span<const glm::vec3> vertices, std::span<const unsigned int> indices,
+    std::span<const glm::vec3> normals) {
+  m_Vertices.assign(vertices.begin(), vertices.end());
+  m_Indices.assign(indices.begin(), indices.end());
+  m_BaseId = nextStamp();
+  markTopologyChanged();
+  m_DirtyVertices.clear();
+  m_DirtyFlags.clear();
+
+  if (normals.size() == vertices.size()) {
+    m_Normals.assign(normals.begin(), normals.end());
+  } else {
+    m_Normals.assign(m_Vertices.size(), glm::vec3(0.0f));
+    RecalculateNormals();
+  }
+}
+
 void SculptableMesh::RecalculateNormals() {
+  m_Revision = nextStamp();
+  for (uint32_t index : m_DirtyVertices) {
+    if (index < m_DirtyFlags.size()) m_DirtyFlags[index] = 0;
+  }
+  m_DirtyVertices.clear();
+  if (!m_Vertices.empty()) {
+    expandGpuRange(0);
+    expandGpuRange(static_cast<uint32_t>(m_Vertices.size() - 1));
+  }
+
   if (m_Vertices.empty()) {
     m_Normals.clear();
     return;
@@ -36,40 +80,315 @@ void SculptableMesh::RecalculateNormals() {
     return;
   }
 
-  std::fill(m_Normals.begin(), m_Normals.end(), glm::vec3(0.0f));
+  if (m_VertexFacesDirty ||
+      m_VertexFaceOffsets.size() != m_Vertices.size() + 1) {
+    rebuildVertexFaces();
+  }
+
+  // Two passes so no two threads ever write the same element: face normals
+  // per face, then a per-vertex gather over each vertex's incident faces.
+  auto& jobs = JobSystem::Get();
+  const size_t faceCount = m_Indices.size() / 3;
+  m_FaceNormals.resize(faceCount);
+  jobs.ParallelFor(faceCount, kMinFacesPerJob, [&](size_t begin, size_t end) {
+    for (size_t face = begin; face < end; ++face) {
+      unsigned int i0 = m_Indices[face * 3];
+      unsigned int i1 = m_Indices[face * 3 + 1];
+      unsigned int i2 = m_Indices[face * 3 + 2];
+      if (i0 >= m_Vertices.size() || i1 >= m_Vertices.size() ||
+          i2 >= m_Vertices.size()) {
+        m_FaceNormals[face] = glm::vec3(0.0f);
+        continue;
+      }
+      m_FaceNormals[face] = glm::cross(m_Vertices[i1] - m_Vertices[i0],
+                                       m_Vertices[i2] - m_Vertices[i0]);
+    }
+  });
+
+  jobs.ParallelFor(
+      m_Vertices.size(), kMinVerticesPerJob, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+          glm::vec3 normal(0.0f);
+          for (uint32_t f = m_VertexFaceOffsets[v];
+               f < m_VertexFaceOffsets[v + 1]; ++f) {
+            normal += m_FaceNormals[m_VertexFaces[f]];
+          }
+          m_Normals[v] = glm::length(normal) > 0.0f ? glm::normalize(normal)
+                                                    : glm::vec3(0.0f);
+        }
+      });
+}
 
-  for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
-    unsigned int i0 = m_Indices[i];
-    unsigned int i1 = m_Indices[i + 1];
-    unsigned int i2 = m_Indices[i + 2];
+const MeshBVH& SculptableMesh::GetBVH() const {
+  if (m_BVHNeedsRebuild) {
+    m_BVH.Build(m_Vertices, m_Indices);
+    m_BVHNeedsRebuild = false;
+    m_BVHNeedsRefit = false;
+  } else if (m_BVHNeedsRefit) {
+    m_BVH.Refit(m_Vertices, m_Indices);
+    m_BVHNeedsRefit = false;
+  }
+  return m_BVH;
+}
+
+void SculptableMesh::QueryVerticesInSphere(
+    const glm::vec3& center, float radius,
+    std::vector<uint32_t>& outIndices) const {
+  outIndices.clear();
+  if (radius <= 0.0f || m_Vertices.empty()) return;
+
+  if (m_SpatialHashNeedsRebuild || m_SpatialHashStale ||
+      !m_SpatialHash.IsSuitableFor(m_Vertices.size(), radius)) {
+    m_SpatialHash.Build(m_Vertices, radius);
+    m_SpatialHashNeedsRebuild = false;
+    m_SpatialHashStale = false;
+  }
+  m_SpatialHash.Query(m_Vertices, center, radius, outIndices);
+}
+
+void SculptableMesh::MarkVerticesDirty(
+    const std::vector<uint32_t>& vertexIndices) {
+  if (m_DirtyFlags.size() != m_Vertices.size()) {
+    m_DirtyFlags.resize(m_Vertices.size(), 0);
+  }
+  for (uint32_t index : vertexIndices) {
+    if (index < m_DirtyFlags.size() && !m_DirtyFlags[index]) {
+      m_DirtyFlags[index] = 1;
+      m_DirtyVertices.push_back(index);
+      expandGpuRange(index);
+    }
+  }
+  m_GpuVerticesStale = false;
+
+  if (!m_PositionsSoANeedsRebuild &&
+      m_PositionsSoA.Size() == m_Vertices.size()) {
+    for (uint32_t index : vertexIndices) {
+      if (index < m_Vertices.size()) {
+        m_PositionsSoA.Set(index, m_Vertices[index]);
+      }
+    }
+    m_PositionsSoAStale = false;
+  }
+
+  if (!m_SpatialHashNeedsRebuild &&
+      m_SpatialHash.IsSuitableFor(m_Vertices.size(),
+                                  m_SpatialHash.GetCellSize())) {
+    m_SpatialHash.Update(m_Vertices, vertexIndices);
+    m_SpatialHashStale = false;
+  }
+}
+
+void SculptableMesh::RecalculateDirtyNormals() {
+  if (m_DirtyVertices.empty()) return;
+  m_Revision = nextStamp();
+
+  if (m_Normals.size() != m_Vertices.size()) {
+    RecalculateNormals();
+    return;
+  }
+  if (m_VertexFacesDirty ||
+      m_VertexFaceOffsets.size() != m_Vertices.size() + 1) {
+    rebuildVertexFaces();
+  }
+
+  // A moved vertex changes the normals of its incident faces, and therefore
+  // the normals of every vertex on those faces (its one-ring).
+  if (m_NormalUpdateStamp.size() != m_Vertices.size()) {
+    m_NormalUpdateStamp.assign(m_Vertices.size(), 0);
+    m_NormalUpdateGeneration = 0;
+  }
+  if (++m_NormalUpdateGeneration == 0) {
+    std::fill(m_NormalUpdateStamp.begin(), m_NormalUpdateStamp.end(), 0);
+    m_NormalUpdateGeneration = 1;
+  }
 
-    if (i0 >= m_Vertices.size() || i1 >= m_Vertices.size() ||
-        i2 >= m_Vertices.size()) {
+  m_NormalUpdateList.clear();
+  for (uint32_t vertex : m_DirtyVertices) {
+    m_DirtyFlags[vertex] = 0;
+    if (vertex >= m_Vertices.size()) continue;
+    for (uint32_t f = m_VertexFaceOffsets[vertex];
+         f < m_VertexFaceOffsets[vertex + 1]; ++f) {
+      uint32_t face = m_VertexFaces[f];
+      for (int k = 0; k < 3; ++k) {
+        uint32_t neighbor = m_Indices[face * 3 + k];
+        if (m_NormalUpdateStamp[neighbor] != m_NormalUpdateGeneration) {
+          m_NormalUpdateStamp[neighbor] = m_NormalUpdateGeneration;
+          m_NormalUpdateList.push_back(neighbor);
+        }
+      }
+    }
+  }
+  m_DirtyVertices.clear();
+
+  for (uint32_t vertex : m_NormalUpdateList) {
+    expandGpuRange(vertex);
+  }
+
+  JobSystem::Get().ParallelFor(
+      m_NormalUpdateList.size(), kMinVerticesPerJob,
+      [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+          uint32_t vertex = m_NormalUpdateList[k];
+          glm::vec3 normal = accumulateFaceNormals(vertex);
+          m_Normals[vertex] = glm::length(normal) > 0.0f
+                                  ? glm::normalize(normal)
+                                  : glm::vec3(0.0f);
+        }
+      });
+}
+
+const VertexSoA& SculptableMesh::GetPositionsSoA() const {
+  if (m_PositionsSoANeedsRebuild || m_PositionsSoAStale ||
+      m_PositionsSoA.Size() != m_Vertices.size()) {
+    m_PositionsSoA.Assign(m_Vertices);
+    m_PositionsSoANeedsRebuild = false;
+    m_PositionsSoAStale = false;
+  }
+  return m_PositionsSoA;
+}
+
+MeshGpuDelta SculptableMesh::ConsumeGpuDelta() {
+  MeshGpuDelta delta;
+  delta.topologyChanged = m_GpuTopologyDirty;
+  if (m_GpuTopologyDirty || m_GpuVerticesStale) {
+    delta.vertexBegin = 0;
+    delta.vertexEnd = static_cast<uint32_t>(m_Vertices.size());
+  } else if (m_GpuDirtyEnd > m_GpuDirtyBegin) {
+    delta.vertexBegin = m_GpuDirtyBegin;
+    delta.vertexEnd =
+        std::min(m_GpuDirtyEnd, static_cast<uint32_t>(m_Vertices.size()));
+  }
+
+  m_GpuDirtyBegin = std::numeric_limits<uint32_t>::max();
+  m_GpuDirtyEnd = 0;
+  m_GpuVerticesStale = false;
+  m_GpuTopologyDirty = false;
+  return delta;
+}
+
+void SculptableMesh::rebuildVertexFaces() {
+  const size_t vertexCount = m_Vertices.size();
+  m_VertexFaceOffsets.assign(vertexCount + 1, 0);
+
+  // Count, prefix-sum, then fill. Triangles with out-of-range indices are
+  // skipped, matching RecalculateNormals.
+  auto isValidFace = [&](size_t i) {
+    return m_Indices[i] < vertexCount && m_Indices[i + 1] < vertexCount &&
+           m_Indices[i + 2] < vertexCount;
+  };
+  for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
+    if (!isValidFace(i)) {
       Log::Debug(
-          "SculptableMesh::RecalculateNormals: Skipping invalid triangle "
+          "SculptableMesh::rebuildVertexFaces: Skipping invalid triangle "
           "(index out of bounds): ",
-          i0, ", ", i1, ", ", i2, " (Vertices size: ", m_Vertices.size(), ")");
+          m_Indices[i], ", ", m_Indices[i + 1], ", ", m_Indices[i + 2],
+          " (Vertices size: ", vertexCount, ")");
       continue;
     }
+    for (int k = 0; k < 3; ++k) m_VertexFaceOffsets[m_Indices[i + k] + 1]++;
+  }
+  for (size_t v = 0; v < vertexCount; ++v) {
+    m_VertexFaceOffsets[v + 1] += m_VertexFaceOffsets[v];
+  }
+
+  m_VertexFaces.resize(m_VertexFaceOffsets[vertexCount]);
+  std::vector<uint32_t> cursor(m_VertexFaceOffsets.begin(),
+                               m_VertexFaceOffsets.end() - 1);
+  for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
+    if (!isValidFace(i)) continue;
+    for (int k = 0; k < 3; ++k) {
+      m_VertexFaces[cursor[m_Indices[i + k]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
 
-    const glm::vec3& v0 = m_Vertices[i0];
-    const glm::vec3& v1 = m_Vertices[i1];
-    const glm::vec3& v2 = m_Vertices[i2];
+  m_VertexFacesDirty = false;
+}
 
-    glm::vec3 edge1 = v1 - v0;
-    glm::vec3 edge2 = v2 - v0;
-    glm::vec3 faceNormal = glm::cross(edge1, edge2);
+const VertexAdjacency& SculptableMesh::GetVertexAdjacency() const {
+  if (m_VertexNeighborsDirty ||
+      m_VertexNeighbors.offsets.size() != m_Vertices.size() + 1) {
+    rebuildVertexNeighbors();
+  }
+  return m_VertexNeighbors;
+}
 
-    m_Normals[i0] += faceNormal;
-    m_Normals[i1] += faceNormal;
-    m_Normals[i2] += faceNormal;
+const MeshConnectivity& SculptableMesh::GetConnectivity() const {
+  const size_t faceCount = m_Indices.size() / 3;
+  // The patch path only ever grows the tables, and past a point re-linking
+  // face by face costs more than a fresh build.
+  if (m_ConnectivityNeedsRebuild ||
+      m_Vertices.size() < m_Connectivity.GetVertexCount() ||
+      faceCount < m_Connectivity.GetFaceCount() ||
+      m_ConnectivityPendingFaces.size() > faceCount / 2) {
+    m_Connectivity.Build(m_Indices, m_Vertices.size());
+    m_ConnectivityNeedsRebuild = false;
+  } else if (!m_ConnectivityPendingFaces.empty()) {
+    m_Connectivity.UpdateFaces(m_Indices, m_Vertices.size(),
+                               m_ConnectivityPendingFaces);
+  }
+  m_ConnectivityPendingFaces.clear();
+  return m_Connectivity;
+}
+
+void SculptableMesh::rebuildVertexNeighbors() const {
+  const size_t vertexCount = m_Vertices.size();
+  auto& offsets = m_VertexNeighbors.offsets;
+  auto& neighbors = m_VertexNeighbors.neighbors;
+  offsets.assign(vertexCount + 1, 0);
+
+  // Each valid triangle gives every corner its two other corners. Shared
+  // edges produce duplicates, which are removed per vertex afterwards.
+  auto isValidFace = [&](size_t i) {
+    return m_Indices[i] < vertexCount && m_Indices[i + 1] < vertexCount &&
+           m_Indices[i + 2] < vertexCount;
+  };
+  for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
+    if (!isValidFace(i)) continue;
+    for (int k = 0; k < 3; ++k) offsets[m_Indices[i + k] + 1] += 2;
   }
+  for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
 
-  for (auto& normal : m_Normals) {
-    if (glm::length(normal) > 0.0f) {
-      normal = glm::normalize(normal);
+  neighbors.resize(offsets[vertexCount]);
+  std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
+    if (!isValidFace(i)) continue;
+    for (int k = 0; k < 3; ++k) {
+      uint32_t v = m_Indices[i + k];
+      neighbors[cursor[v]++] = m_Indices[i + (k + 1) % 3];
+      neighbors[cursor[v]++] = m_Indices[i + (k + 2) % 3];
     }
   }
+
+  // Sort and deduplicate each range, compacting the array in place.
+  uint32_t write = 0;
+  for (size_t v = 0; v < vertexCount; ++v) {
+    auto first = neighbors.begin() + offsets[v];
+    auto last = neighbors.begin() + offsets[v + 1];
+    std::sort(first, last);
+    last = std::unique(first, last);
+    offsets[v] = write;
+    // Degenerate triangles can list a vertex as its own neighbor.
+    for (auto it = first; it != last; ++it) {
+      if (*it != v) neighbors[write++] = *it;
+    }
+  }
+  offsets[vertexCount] = write;
+  neighbors.resize(write);
+
+  m_VertexNeighborsDirty = false;
+}
+
+glm::vec3 SculptableMesh::accumulateFaceNormals(uint32_t vertexIndex) const {
+  glm::vec3 normal(0.0f);
+  for (uint32_t f = m_VertexFaceOffsets[vertexIndex];
+       f < m_VertexFaceOffsets[vertexIndex + 1]; ++f) {
+    uint32_t face = m_VertexFaces[f];
+    const glm::vec3& v0 = m_Vertices[m_Indices[face * 3]];
+    const glm::vec3& v1 = m_Vertices[m_Indices[face * 3 + 1]];
+    const glm::vec3& v2 = m_Vertices[m_Indices[face * 3 + 2]];
+    normal += glm::cross(v1 - v0, v2 - v0);
+  }
+  return normal;
 }
 
 void SculptableMesh::Serialize(nlohmann::json& outJson) const {
@@ -98,6 +417,9 @@ void SculptableMesh::Deserialize(const nlohmann::json& inJson) {
     }
   }
 
+  m_BaseId = nextStamp();
+  markTopologyChanged();
+
   m_Normals.resize(m_Vertices.size(), glm::vec3(0.0f));
   RecalculateNormals();
 }
@@ -131,7 +453,8 @@ bool SculptableMesh::ExtrudeFaces(
   }
 
   std::vector<uint32_t> newFacesIndices;
-  std::vector<uint32_t> originalFaceIndices;
+  std::vector<uint32_t> changedFaces(faceIndices.begin(), faceIndices.end());
+  const uint32_t firstNewFace = static_cast<uint32_t>(m_Indices.size() / 3);
 
   for (uint32_t faceIndex : faceIndices) {
     uint32_t i0 = m_Indices[faceIndex * 3 + 0];
@@ -171,6 +494,10 @@ bool SculptableMesh::ExtrudeFaces(
 
   m_Indices.insert(m_Indices.end(), newFacesIndices.begin(),
                    newFacesIndices.end());
+  for (uint32_t face = firstNewFace; face < m_Indices.size() / 3; ++face) {
+    changedFaces.push_back(face);
+  }
+  markFacesChanged(changedFaces);
   RecalculateNormals();
   return true;
 }
@@ -187,12 +514,15 @@ bool SculptableMesh::WeldVertices(
   std::unordered_set<uint32_t> verticesToRemap = vertexIndices;
   verticesToRemap.erase(targetVertexIndex); // Keep target vertex out of remapping set
 
+  std::vector<uint32_t> changedFaces;
   for (size_t i = 0; i < m_Indices.size(); ++i) {
     if (verticesToRemap.count(m_Indices[i])) { // Check if the index needs to be remapped
       m_Indices[i] = targetVertexIndex;
+      changedFaces.push_back(static_cast<uint32_t>(i / 3));
     }
   }
 
+  markFacesChanged(changedFaces);
   RecalculateNormals();
   return true;
 }
@@ -233,7 +563,11 @@ bool SculptableMesh::BevelEdges(const std::unordered_set<std::pair<uint32_t, uin
     }
 
     // A simple implementation just adds new faces. A more complex one would replace existing ones.
+    std::vector<uint32_t> newFaces(newIndices.size() / 3);
+    std::iota(newFaces.begin(), newFaces.end(),
+              static_cast<uint32_t>(m_Indices.size() / 3));
     m_Indices.insert(m_Indices.end(), newIndices.begin(), newIndices.end());
+    markFacesChanged(newFaces);
     RecalculateNormals();
     return true;
 }
\ No newline at end of file
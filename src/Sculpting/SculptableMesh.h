@@ -1,10 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <glm/glm.hpp>
+#include <limits>
 #include <nlohmann/json.hpp>
+#include <span>
 #include <vector>
 
 #include "Interfaces/IEditableMesh.h"
+#include "Sculpting/BrushKernels.h"
+#include "Sculpting/MeshBVH.h"
+#include "Sculpting/MeshConnectivity.h"
+#include "Sculpting/VertexSpatialHash.h"
 #include "Sculpting/SubObjectSelection.h" // For PairHash
 
 // Correctly inherit from the IEditableMesh interface
@@ -22,8 +29,25 @@ class SculptableMesh : public IEditableMesh {
   void Initialize(const std::vector<float>& vertices,
                   const std::vector<unsigned int>& indices);
 
+  // Bulk-copies positions and indices, e.g. straight out of a mapped file.
+  // Normals are used as-is when given one per vertex, else recomputed.
+  void InitializeFromBuffers(std::span<const glm::vec3> vertices,
+                             std::span<const unsigned int> indices,
+                             std::span<const glm::vec3> normals = {});
+
   // --- IEditableMesh Interface Implementation ---
   void RecalculateNormals() override;
+  uint64_t GetRevision() const override { return m_Revision; }
+  uint64_t GetBaseId() const override { return m_BaseId; }
+  const MeshBVH& GetBVH() const override;
+  void QueryVerticesInSphere(const glm::vec3& center, float radius,
+                             std::vector<uint32_t>& outIndices) const override;
+  void MarkVerticesDirty(const std::vector<uint32_t>& vertexIndices) override;
+  const VertexSoA& GetPositionsSoA() const override;
+  const VertexAdjacency& GetVertexAdjacency() const override;
+  const MeshConnectivity& GetConnectivity() const override;
+  void RecalculateDirtyNormals() override;
+  MeshGpuDelta ConsumeGpuDelta() override;
 
   const std::vector<glm::vec3>& GetVertices() const override {
     return m_Vertices;
@@ -35,9 +59,26 @@ class SculptableMesh : public IEditableMesh {
     return m_Normals;
   }
 
-  std::vector<glm::vec3>& GetVertices() override { return m_Vertices; }
-  std::vector<unsigned int>& GetIndices() override { return m_Indices; }
-  std::vector<glm::vec3>& GetNormals() override { return m_Normals; }
+  // Mutable access may move vertices or rewrite triangles, so it invalidates
+  // the BVH (a refit for positions, a full rebuild for indices), and the
+  // vertex hash, SoA copy and GPU copy until the moved vertices are reported via
+  // MarkVerticesDirty.
+  std::vector<glm::vec3>& GetVertices() override {
+    m_Revision = nextStamp();
+    m_BVHNeedsRefit = true;
+    m_SpatialHashStale = true;
+    m_PositionsSoAStale = true;
+    m_GpuVerticesStale = true;
+    return m_Vertices;
+  }
+  std::vector<unsigned int>& GetIndices() override {
+    markTopologyChanged();
+    return m_Indices;
+  }
+  std::vector<glm::vec3>& GetNormals() override {
+    m_Revision = nextStamp();
+    return m_Normals;
+  }
 
   bool ExtrudeFaces(const std::unordered_set<uint32_t>& faceIndices,
                     float distance) override;
@@ -51,7 +92,85 @@ class SculptableMesh : public IEditableMesh {
   void Deserialize(const nlohmann::json& inJson);
 
  private:
+  // Revisions and base IDs come from one process-wide counter, so neither
+  // repeats across meshes.
+  static uint64_t nextStamp();
+  void markTopologyChanged() {
+    invalidateTopologyCaches();
+    m_ConnectivityNeedsRebuild = true;
+  }
+  // For edits that know which faces they rewrote or appended: the
+  // connectivity is patched for just those faces on its next query.
+  void markFacesChanged(std::span<const uint32_t> faces) {
+    invalidateTopologyCaches();
+    m_ConnectivityPendingFaces.insert(m_ConnectivityPendingFaces.end(),
+                                      faces.begin(), faces.end());
+  }
+  void invalidateTopologyCaches() {
+    m_Revision = nextStamp();
+    m_BVHNeedsRebuild = true;
+    m_SpatialHashNeedsRebuild = true;
+    m_PositionsSoANeedsRebuild = true;
+    m_VertexFacesDirty = true;
+    m_VertexNeighborsDirty = true;
+    m_GpuTopologyDirty = true;
+  }
+  void expandGpuRange(uint32_t vertexIndex) {
+    m_GpuDirtyBegin = std::min(m_GpuDirtyBegin, vertexIndex);
+    m_GpuDirtyEnd = std::max(m_GpuDirtyEnd, vertexIndex + 1);
+  }
+  void rebuildVertexFaces();
+  void rebuildVertexNeighbors() const;
+  glm::vec3 accumulateFaceNormals(uint32_t vertexIndex) const;
+
   std::vector<glm::vec3> m_Vertices;
   std::vector<glm::vec3> m_Normals;
   std::vector<unsigned int> m_Indices;
+  uint64_t m_Revision = 0;
+  uint64_t m_BaseId = 0;
+
+  // Built lazily on the first raycast after a change.
+  mutable MeshBVH m_BVH;
+  mutable bool m_BVHNeedsRebuild = true;
+  mutable bool m_BVHNeedsRefit = false;
+
+  // Cell size follows the brush radius; rebuilt when the radius drifts.
+  // "NeedsRebuild" flags come from topology changes and can only be cleared
+  // by a rebuild; "Stale" flags come from mutable vertex access and are also
+  // cleared when the edits are reported through MarkVerticesDirty.
+  mutable VertexSpatialHash m_SpatialHash;
+  mutable bool m_SpatialHashNeedsRebuild = true;
+  mutable bool m_SpatialHashStale = false;
+
+  mutable VertexSoA m_PositionsSoA;
+  mutable bool m_PositionsSoANeedsRebuild = true;
+  mutable bool m_PositionsSoAStale = false;
+
+  // Vertex -> incident faces in CSR form: the faces of vertex v are
+  // m_VertexFaces[m_VertexFaceOffsets[v] .. m_VertexFaceOffsets[v + 1]).
+  std::vector<uint32_t> m_VertexFaceOffsets;
+  std::vector<uint32_t> m_VertexFaces;
+  bool m_VertexFacesDirty = true;
+
+  // Built lazily for smoothing brushes; depends on the indices only.
+  mutable VertexAdjacency m_VertexNeighbors;
+  mutable bool m_VertexNeighborsDirty = true;
+
+  mutable MeshConnectivity m_Connectivity;
+  mutable bool m_ConnectivityNeedsRebuild = true;
+  mutable std::vector<uint32_t> m_ConnectivityPendingFaces;
+
+  // Vertices moved since the last normal update, deduplicated by flag.
+  std::vector<uint32_t> m_DirtyVertices;
+  std::vector<uint8_t> m_DirtyFlags;
+  std::vector<glm::vec3> m_FaceNormals;      // Scratch, reused between calls
+  std::vector<uint32_t> m_NormalUpdateList;  // Scratch, reused between calls
+  std::vector<uint32_t> m_NormalUpdateStamp;
+  uint32_t m_NormalUpdateGeneration = 0;
+
+  // Vertex range whose positions or normals changed since the last upload.
+  uint32_t m_GpuDirtyBegin = std::numeric_limits<uint32_t>::max();
+  uint32_t m_GpuDirtyEnd = 0;
+  bool m_GpuVerticesStale = false;
+  bool m_GpuTopologyDirty = true;
 };
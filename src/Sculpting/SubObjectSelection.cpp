@@ -1,25 +1,19 @@
 #include "Sculpting/SubObjectSelection.h"
 #include <glm/gtc/matrix_inverse.hpp>
-#include <glm/gtx/norm.hpp>
-#include <set>
-#include <queue>
-#include <map>
 #include <algorithm>
+#include <utility>
 #include "Core/Log.h"
-#include "Core/MathHelpers.h"
 #include "Core/Raycaster.h"
 #include "Interfaces/IEditableMesh.h"
 #include "Core/Camera.h"
 
-float PointToSegmentDistance(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
-    glm::vec2 ab = b - a;
-    glm::vec2 ap = p - a;
-    float l2 = glm::dot(ab, ab);
-    if (l2 == 0.0f) return glm::distance(p, a);
-    float t = std::max(0.0f, std::min(1.0f, glm::dot(ap, ab) / l2));
-    glm::vec2 projection = a + t * ab;
-    return glm::distance(p, projection);
-}
+namespace {
+
+// Pick radii in pixels, for clicks and hover alike.
+constexpr float kVertexPickRadius = 15.0f;
+constexpr float kEdgePickRadius = 10.0f;
+
+}  // namespace
 
 SubObjectSelection::SubObjectSelection() { Clear(); }
 
@@ -29,8 +23,12 @@ void SubObjectSelection::Clear() {
   m_SelectedFaces.clear();
   m_HighlightedPath.clear();
   m_SelectionOrder.clear();
+  m_PathSegments.clear();
   m_IsDragging = false;
   m_ActiveDragVertexIndex = -1;
+  // Called when the edited object changes; its mesh may reuse the old one's
+  // address.
+  m_ScreenGrid.Invalidate();
 }
 
 bool SubObjectSelection::IsDragging() const { return m_IsDragging; }
@@ -40,8 +38,9 @@ const std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash>& SubObjectSele
 const std::unordered_set<uint32_t>& SubObjectSelection::GetSelectedFaces() const { return m_SelectedFaces; }
 const std::vector<std::pair<uint32_t, uint32_t>>& SubObjectSelection::GetHighlightedPath() const { return m_HighlightedPath; }
 
-void SubObjectSelection::OnMouseDown(IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix, const glm::vec2& mouseScreenPos, int viewportWidth, int viewportHeight, bool isShiftPressed, SubObjectMode mode) {
+void SubObjectSelection::OnMouseDown(const IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix, const glm::vec2& mouseScreenPos, int viewportWidth, int viewportHeight, bool isShiftPressed, SubObjectMode mode) {
     m_IsDragging = false;
+    m_DragMovedVertices = false;
     m_AccumulatedMouseDelta = glm::vec2(0.0f);
     m_InitialViewProj = camera.GetProjectionMatrix() * camera.GetViewMatrix();
     m_ModelMatrix = modelMatrix;
@@ -55,35 +54,55 @@ void SubObjectSelection::OnMouseDown(IEditableMesh& mesh, const Camera& camera,
     glm::vec3 cameraFwd = camera.GetFront();
 
     if (mode == SubObjectMode::VERTEX) {
-        int closestIndex = FindClosestVertex(mesh, modelMatrix, mouseScreenPos, viewMatrix, projectionMatrix, cameraFwd, viewportWidth, viewportHeight, 15.0f);
+        int closestIndex = FindClosestVertex(mesh, modelMatrix, mouseScreenPos, viewMatrix, projectionMatrix, cameraFwd, viewportWidth, viewportHeight, kVertexPickRadius);
         if (closestIndex != -1) {
             m_IsDragging = true;
             if (m_SelectedVertices.count(closestIndex)) {
                 m_SelectedVertices.erase(closestIndex);
-                m_SelectionOrder.erase(std::remove(m_SelectionOrder.begin(), m_SelectionOrder.end(), closestIndex), m_SelectionOrder.end());
-                m_HighlightedPath.clear();
-                if(m_SelectionOrder.size() >= 2) {
-                    for(size_t i = 0; i < m_SelectionOrder.size() - 1; ++i) {
-                        FindShortestPath(mesh, m_SelectionOrder[i], m_SelectionOrder[i+1]);
+                auto it = std::find(m_SelectionOrder.begin(), m_SelectionOrder.end(), static_cast<uint32_t>(closestIndex));
+                if (it != m_SelectionOrder.end()) {
+                    // Only the segments touching the removed vertex change: the
+                    // two around it become one. It is a bridging path only if
+                    // both were paths; otherwise the gap stays empty, so no
+                    // path appears that the user never asked for.
+                    const size_t k = it - m_SelectionOrder.begin();
+                    const size_t last = m_SelectionOrder.size() - 1;
+                    if (m_PathSegments.size() != last) m_PathSegments.assign(last, {});
+                    if (k > 0 && k < last) {
+                        if (!m_PathSegments[k - 1].empty() && !m_PathSegments[k].empty()) {
+                            m_PathSegments[k - 1] = FindShortestPath(mesh, m_SelectionOrder[k - 1], m_SelectionOrder[k + 1]);
+                        } else {
+                            m_PathSegments[k - 1].clear();
+                        }
+                        m_PathSegments.erase(m_PathSegments.begin() + k);
+                    } else if (last > 0) {
+                        m_PathSegments.erase(m_PathSegments.begin() + (k == 0 ? 0 : k - 1));
                     }
+                    m_SelectionOrder.erase(it);
+                    rebuildHighlightedPath();
                 }
             }
             else {
                 m_SelectedVertices.insert(closestIndex);
                 if (m_SelectionOrder.size() >= 1 && isShiftPressed) {
-                    FindShortestPath(mesh, m_SelectionOrder.back(), closestIndex);
+                    m_PathSegments.resize(m_SelectionOrder.size() - 1);
+                    m_PathSegments.push_back(FindShortestPath(mesh, m_SelectionOrder.back(), closestIndex));
+                    const auto& added = m_PathSegments.back();
+                    m_HighlightedPath.insert(m_HighlightedPath.end(), added.begin(), added.end());
+                } else {
+                    m_PathSegments.resize(m_SelectionOrder.size(), {});
                 }
                 m_SelectionOrder.push_back(closestIndex);
             }
             m_ActiveDragVertexIndex = closestIndex;
             
-            glm::vec3 vertexWorldPos = glm::vec3(modelMatrix * glm::vec4(mesh.GetVertices()[m_ActiveDragVertexIndex], 1.0f));
+            glm::vec3 vertexWorldPos = glm::vec3(modelMatrix * glm::vec4(std::as_const(mesh).GetVertices()[m_ActiveDragVertexIndex], 1.0f));
             m_InitialDragPosition = vertexWorldPos;
             glm::vec4 clipPos = m_InitialViewProj * glm::vec4(m_InitialDragPosition, 1.0f);
             m_DragDepthNDC = clipPos.w != 0.0f ? clipPos.z / clipPos.w : 0.0f;
         }
     } else if (mode == SubObjectMode::EDGE) {
-        std::pair<int, int> closestEdge = FindClosestEdge(mesh, modelMatrix, mouseScreenPos, viewMatrix, projectionMatrix, cameraFwd, viewportWidth, viewportHeight, 10.0f);
+        std::pair<int, int> closestEdge = FindClosestEdge(mesh, modelMatrix, mouseScreenPos, viewMatrix, projectionMatrix, cameraFwd, viewportWidth, viewportHeight, kEdgePickRadius);
         if (closestEdge.first != -1) {
             Log::Debug("Edge selected: (", closestEdge.first, ", ", closestEdge.second, ")");
             std::pair<uint32_t, uint32_t> edgeKey = { (uint32_t)closestEdge.first, (uint32_t)closestEdge.second };
@@ -97,9 +116,10 @@ void SubObjectSelection::OnMouseDown(IEditableMesh& mesh, const Camera& camera,
         if (Raycaster::IntersectMesh(rayOrigin, rayDirection, mesh, modelMatrix, result) && result.triangleIndex != -1) {
             if (m_IgnoreBackfaces) {
                 const auto& normals = mesh.GetNormals();
-                glm::vec3 faceNormal = (normals[mesh.GetIndices()[result.triangleIndex * 3]] +
-                                        normals[mesh.GetIndices()[result.triangleIndex * 3 + 1]] +
-                                        normals[mesh.GetIndices()[result.triangleIndex * 3 + 2]]) / 3.0f;
+                const auto& indices = std::as_const(mesh).GetIndices();
+                glm::vec3 faceNormal = (normals[indices[result.triangleIndex * 3]] +
+                                        normals[indices[result.triangleIndex * 3 + 1]] +
+                                        normals[indices[result.triangleIndex * 3 + 2]]) / 3.0f;
                 faceNormal = glm::normalize(glm::mat3(glm::transpose(glm::inverse(modelMatrix))) * faceNormal);
                 if (glm::dot(faceNormal, -rayDirection) < 0.05f) return;
             }
@@ -110,17 +130,39 @@ void SubObjectSelection::OnMouseDown(IEditableMesh& mesh, const Camera& camera,
     }
 }
 
+bool SubObjectSelection::UpdateHover(const IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix, const glm::vec2& mouseScreenPos, int viewportWidth, int viewportHeight, SubObjectMode mode) {
+    int vertex = -1;
+    std::pair<int, int> edge = {-1, -1};
+    if (mode == SubObjectMode::VERTEX) {
+        vertex = FindClosestVertex(mesh, modelMatrix, mouseScreenPos, camera.GetViewMatrix(), camera.GetProjectionMatrix(), camera.GetFront(), viewportWidth, viewportHeight, kVertexPickRadius);
+    } else if (mode == SubObjectMode::EDGE) {
+        edge = FindClosestEdge(mesh, modelMatrix, mouseScreenPos, camera.GetViewMatrix(), camera.GetProjectionMatrix(), camera.GetFront(), viewportWidth, viewportHeight, kEdgePickRadius);
+    }
+    bool changed = vertex != m_HoveredVertex || edge != m_HoveredEdge;
+    m_HoveredVertex = vertex;
+    m_HoveredEdge = edge;
+    return changed;
+}
+
+bool SubObjectSelection::ClearHover() {
+    bool changed = m_HoveredVertex != -1 || m_HoveredEdge.first != -1;
+    m_HoveredVertex = -1;
+    m_HoveredEdge = {-1, -1};
+    return changed;
+}
+
 void SubObjectSelection::OnMouseDrag(const glm::vec2& mouseDelta) {
   if (m_IsDragging && m_ActiveDragVertexIndex != -1) {
     m_AccumulatedMouseDelta += mouseDelta;
   }
 }
 
-void SubObjectSelection::OnMouseRelease(IEditableMesh& mesh) {
-  if (m_IsDragging && m_ActiveDragVertexIndex != -1) {
-    mesh.RecalculateNormals();
+void SubObjectSelection::OnMouseRelease(IEditableMesh* mesh) {
+  if (m_DragMovedVertices && mesh) {
+    mesh->RecalculateDirtyNormals();
   }
   m_IsDragging = false;
+  m_DragMovedVertices = false;
   m_ActiveDragVertexIndex = -1;
   m_AccumulatedMouseDelta = glm::vec2(0.0f);
 }
@@ -136,123 +178,42 @@ void SubObjectSelection::ApplyDrag(IEditableMesh& mesh, const glm::mat4& viewMat
   glm::mat4 invModel = glm::inverse(m_ModelMatrix);
   glm::vec3 localSpaceDelta = glm::vec3(invModel * glm::vec4(worldSpaceDelta, 0.0f));
 
+  auto& vertices = mesh.GetVertices();
+  std::vector<uint32_t> movedVertices;
+  movedVertices.reserve(m_SelectedVertices.size());
   for (uint32_t index : m_SelectedVertices) {
-    mesh.GetVertices()[index] += localSpaceDelta;
+    vertices[index] += localSpaceDelta;
+    movedVertices.push_back(index);
   }
+  mesh.MarkVerticesDirty(movedVertices);
+  m_DragMovedVertices = true;
 
   m_AccumulatedMouseDelta = glm::vec2(0.0f);
 }
 
-void SubObjectSelection::FindShortestPath(IEditableMesh& mesh, uint32_t startNode, uint32_t endNode) {
-    // Build adjacency list
-    std::map<uint32_t, std::vector<uint32_t>> adj;
-    const auto& indices = mesh.GetIndices();
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        uint32_t v0 = indices[i];
-        uint32_t v1 = indices[i + 1];
-        uint32_t v2 = indices[i + 2];
-        adj[v0].push_back(v1); adj[v0].push_back(v2);
-        adj[v1].push_back(v0); adj[v1].push_back(v2);
-        adj[v2].push_back(v0); adj[v2].push_back(v1);
-    }
-
-    std::queue<uint32_t> q;
-    std::map<uint32_t, uint32_t> parent;
-    std::map<uint32_t, bool> visited;
-
-    q.push(startNode);
-    visited[startNode] = true;
-
-    bool found = false;
-    while (!q.empty()) {
-        uint32_t u = q.front();
-        q.pop();
-
-        if (u == endNode) {
-            found = true;
-            break;
-        }
-
-        for (uint32_t v : adj[u]) {
-            if (!visited[v]) {
-                visited[v] = true;
-                parent[v] = u;
-                q.push(v);
-            }
-        }
+std::vector<std::pair<uint32_t, uint32_t>> SubObjectSelection::FindShortestPath(const IEditableMesh& mesh, uint32_t startNode, uint32_t endNode) {
+    std::vector<std::pair<uint32_t, uint32_t>> path;
+    if (!m_PathFinder.FindPath(mesh, startNode, endNode, m_PathMetric, m_PathScratch)) return path;
+    path.reserve(m_PathScratch.size() - 1);
+    for (size_t i = m_PathScratch.size() - 1; i > 0; --i) {
+        path.push_back({m_PathScratch[i], m_PathScratch[i - 1]});
     }
+    return path;
+}
 
-    if (found) {
-        uint32_t crawl = endNode;
-        while (crawl != startNode) {
-            m_HighlightedPath.push_back({crawl, parent[crawl]});
-            crawl = parent[crawl];
-        }
+void SubObjectSelection::rebuildHighlightedPath() {
+    m_HighlightedPath.clear();
+    for (const auto& segment : m_PathSegments) {
+        m_HighlightedPath.insert(m_HighlightedPath.end(), segment.begin(), segment.end());
     }
 }
 
 int SubObjectSelection::FindClosestVertex(const IEditableMesh& mesh, const glm::mat4& modelMatrix, const glm::vec2& mouseScreenPos, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraFwd, int viewportWidth, int viewportHeight, float pickPixelThreshold) const {
-  int closestIndex = -1;
-  float minDistanceSq = pickPixelThreshold * pickPixelThreshold;
-  const auto& vertices = mesh.GetVertices();
-  const auto& normals = mesh.GetNormals();
-  glm::mat4 viewProjMatrix = projectionMatrix * viewMatrix;
-
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    if (m_IgnoreBackfaces && i < normals.size()) {
-        glm::vec3 normalWorld = glm::normalize(glm::mat3(glm::transpose(glm::inverse(modelMatrix))) * normals[i]);
-        if (glm::dot(normalWorld, -cameraFwd) < 0.1f) continue;
-    }
-    glm::vec3 worldPos = glm::vec3(modelMatrix * glm::vec4(vertices[i], 1.0f));
-    glm::vec2 vertexScreenPos = MathHelpers::WorldToScreen(worldPos, viewProjMatrix, viewportWidth, viewportHeight);
-    if (vertexScreenPos.x < 0) continue;
-    float distSq = glm::distance2(mouseScreenPos, vertexScreenPos);
-    if (distSq < minDistanceSq) {
-      minDistanceSq = distSq;
-      closestIndex = static_cast<int>(i);
-    }
-  }
-  return closestIndex;
+  m_ScreenGrid.Update(mesh, {modelMatrix, projectionMatrix * viewMatrix, cameraFwd, viewportWidth, viewportHeight, m_IgnoreBackfaces});
+  return m_ScreenGrid.FindClosestVertex(mouseScreenPos, pickPixelThreshold);
 }
 
 std::pair<int, int> SubObjectSelection::FindClosestEdge(const IEditableMesh& mesh, const glm::mat4& modelMatrix, const glm::vec2& mouseScreenPos, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraFwd, int viewportWidth, int viewportHeight, float pickPixelThreshold) const {
-    std::pair<int, int> closestEdge = {-1, -1};
-    float minDistance = pickPixelThreshold;
-    const auto& vertices = mesh.GetVertices();
-    const auto& indices = mesh.GetIndices();
-    const auto& normals = mesh.GetNormals();
-    glm::mat4 viewProjMatrix = projectionMatrix * viewMatrix;
-
-    std::set<std::pair<uint32_t, uint32_t>> uniqueEdges;
-    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
-        uint32_t i0 = indices[i], i1 = indices[i+1], i2 = indices[i+2];
-        uniqueEdges.insert({std::min(i0, i1), std::max(i0, i1)});
-        uniqueEdges.insert({std::min(i1, i2), std::max(i1, i2)});
-        uniqueEdges.insert({std::min(i2, i0), std::max(i2, i0)});
-    }
-
-    for (const auto& edge : uniqueEdges) {
-        if (edge.first >= vertices.size() || edge.second >= vertices.size()) continue;
-
-        if (m_IgnoreBackfaces) {
-            if (edge.first < normals.size() && edge.second < normals.size()) {
-                glm::vec3 avgNormal = glm::normalize(normals[edge.first] + normals[edge.second]);
-                glm::vec3 normalWorld = glm::normalize(glm::mat3(glm::transpose(glm::inverse(modelMatrix))) * avgNormal);
-                if (glm::dot(normalWorld, -cameraFwd) < 0.1f) continue;
-            }
-        }
-
-        glm::vec3 v0_world = glm::vec3(modelMatrix * glm::vec4(vertices[edge.first], 1.0f));
-        glm::vec3 v1_world = glm::vec3(modelMatrix * glm::vec4(vertices[edge.second], 1.0f));
-        glm::vec2 v0_screen = MathHelpers::WorldToScreen(v0_world, viewProjMatrix, viewportWidth, viewportHeight);
-        glm::vec2 v1_screen = MathHelpers::WorldToScreen(v1_world, viewProjMatrix, viewportWidth, viewportHeight);
-        if(v0_screen.x < 0 || v1_screen.x < 0) continue;
-
-        float distance = PointToSegmentDistance(mouseScreenPos, v0_screen, v1_screen);
-        if (distance < minDistance) {
-            minDistance = distance;
-            closestEdge = edge;
-        }
-    }
-    return closestEdge;
+  m_ScreenGrid.Update(mesh, {modelMatrix, projectionMatrix * viewMatrix, cameraFwd, viewportWidth, viewportHeight, m_IgnoreBackfaces});
+  return m_ScreenGrid.FindClosestEdge(mesh, mouseScreenPos, pickPixelThreshold);
 }
\ No newline at end of file
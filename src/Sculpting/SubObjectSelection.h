@@ -5,6 +5,8 @@
 #include <vector>
 #include <functional>
 #include "Sculpting/ISculptTool.h"
+#include "Sculpting/MeshPathFinder.h"
+#include "Sculpting/ScreenProjectionGrid.h"
 
 class IEditableMesh;
 class Camera;
@@ -21,11 +23,28 @@ class SubObjectSelection {
  public:
   SubObjectSelection();
 
-  void OnMouseDown(IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix,
+  void OnMouseDown(const IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix,
                    const glm::vec2& mouseScreenPos, int viewportWidth,
                    int viewportHeight, bool isShiftPressed, SubObjectMode mode);
+  /**
+   * @brief Finds the vertex or edge under the cursor for hover highlighting.
+   * Cheap while the camera and mesh are still, since the screen projection
+   * is cached. Returns true if the hovered element changed.
+   */
+  bool UpdateHover(const IEditableMesh& mesh, const Camera& camera, const glm::mat4& modelMatrix,
+                   const glm::vec2& mouseScreenPos, int viewportWidth, int viewportHeight,
+                   SubObjectMode mode);
+  bool ClearHover();
+  int GetHoveredVertex() const { return m_HoveredVertex; }
+  std::pair<int, int> GetHoveredEdge() const { return m_HoveredEdge; }
+
   void OnMouseDrag(const glm::vec2& mouseDelta);
-  void OnMouseRelease(IEditableMesh& mesh);
+  /**
+   * @brief Ends a drag. The mesh is only needed when the drag moved
+   * vertices (see HasDragMovedVertices); it may be null otherwise.
+   */
+  void OnMouseRelease(IEditableMesh* mesh);
+  bool HasDragMovedVertices() const { return m_DragMovedVertices; }
 
   void Clear();
   bool IsDragging() const;
@@ -41,6 +60,10 @@ class SubObjectSelection {
   void SetIgnoreBackfaces(bool ignore) { m_IgnoreBackfaces = ignore; }
   bool GetIgnoreBackfaces() const { return m_IgnoreBackfaces; }
 
+  // Applies to paths found from the next selection on.
+  void SetPathMetric(PathMetric metric) { m_PathMetric = metric; }
+  PathMetric GetPathMetric() const { return m_PathMetric; }
+
 #if defined(INTUITIVE_MODELER_TESTING)
   // --- Test-only Helper Methods ---
 
@@ -62,12 +85,18 @@ class SubObjectSelection {
                              projectionMatrix, cameraFwd, viewportWidth, viewportHeight, pickPixelThreshold);
   }
 
+  std::vector<std::pair<uint32_t, uint32_t>> FindShortestPath_ForTests(IEditableMesh& mesh, uint32_t startNode, uint32_t endNode) {
+      return FindShortestPath(mesh, startNode, endNode);
+  }
+
   void SelectVertexForTest(uint32_t vertexIndex) { m_SelectedVertices.insert(vertexIndex); }
   void SelectFaceForTest(uint32_t faceIndex) { m_SelectedFaces.insert(faceIndex); }
 #endif
 
  private:
-  void FindShortestPath(IEditableMesh& mesh, uint32_t startNode, uint32_t endNode);
+  // Path edges from endNode back to startNode; empty if unreachable.
+  std::vector<std::pair<uint32_t, uint32_t>> FindShortestPath(const IEditableMesh& mesh, uint32_t startNode, uint32_t endNode);
+  void rebuildHighlightedPath();
   int FindClosestVertex(const IEditableMesh& mesh, const glm::mat4& modelMatrix,
                         const glm::vec2& mouseScreenPos, const glm::mat4& viewMatrix,
                         const glm::mat4& projectionMatrix, const glm::vec3& cameraFwd,
@@ -83,11 +112,23 @@ class SubObjectSelection {
   std::unordered_set<uint32_t> m_SelectedFaces;
   std::vector<std::pair<uint32_t, uint32_t>> m_HighlightedPath;
   std::vector<uint32_t> m_SelectionOrder;
+  // m_PathSegments[i] joins m_SelectionOrder[i] and m_SelectionOrder[i + 1],
+  // so deselecting a vertex only searches for the one path bridging the gap.
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_PathSegments;
+  MeshPathFinder m_PathFinder;
+  std::vector<uint32_t> m_PathScratch;
+  PathMetric m_PathMetric = PathMetric::EdgeLength;
   
   bool m_IgnoreBackfaces = true;
 
+  // Screen-space picking structure for the mesh last queried.
+  mutable ScreenProjectionGrid m_ScreenGrid;
+  int m_HoveredVertex = -1;
+  std::pair<int, int> m_HoveredEdge = {-1, -1};
+
   bool m_IsDragging = false;
   int m_ActiveDragVertexIndex = -1;
+  bool m_DragMovedVertices = false;
   glm::vec3 m_InitialDragPosition;
   float m_DragDepthNDC;
   glm::mat4 m_InitialViewProj;
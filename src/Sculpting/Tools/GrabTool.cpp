@@ -1,11 +1,17 @@
 #include "Sculpting/Tools/GrabTool.h"
 
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/norm.hpp>
 
+#include "Core/JobSystem.h"
 #include "Core/MathHelpers.h"
 #include "Core/UI/BrushSettings.h"
 #include "Interfaces/IEditableMesh.h"
+#include "Sculpting/BrushKernels.h"
+
+namespace {
+// Below this many vertices a dab is cheaper to run on one thread.
+constexpr size_t kMinVerticesPerJob = 2048;
+}  // namespace
 
 void GrabTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                      const glm::vec3& rayDirection, const glm::vec2& mouseDelta,
@@ -14,8 +20,6 @@ void GrabTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                      int viewportHeight) {
   if (glm::length(mouseDelta) == 0.0f) return;
 
-  float brushRadiusSq = settings.radius * settings.radius;
-
   glm::mat4 viewProj = projectionMatrix * viewMatrix;
   glm::vec2 screenPos = MathHelpers::WorldToScreen(
       hitPoint, viewProj, viewportWidth, viewportHeight);
@@ -30,15 +34,24 @@ void GrabTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
   glm::vec3 worldDelta =
       (worldPosEnd - worldPosStart) * settings.strength * 0.2f;
 
+  mesh.QueryVerticesInSphere(hitPoint, settings.radius, m_AffectedVertices);
+  if (m_AffectedVertices.empty()) return;
+
+  m_Weights.resize(m_AffectedVertices.size());
+
+  // Fetch the SoA copy before mutable access marks it stale.
+  const VertexSoA& positions = mesh.GetPositionsSoA();
   auto& vertices = mesh.GetVertices();
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    glm::vec3& vertex = vertices[i];
-    float distSq = glm::distance2(hitPoint, vertex);
-
-    if (distSq < brushRadiusSq) {
-      float normalizedDist = glm::sqrt(distSq) / settings.radius;
-      float falloff = settings.falloff.Evaluate(normalizedDist);
-      vertex += worldDelta * falloff;
-    }
-  }
+  JobSystem::Get().ParallelFor(
+      m_AffectedVertices.size(), kMinVerticesPerJob,
+      [&](size_t begin, size_t end) {
+        BrushKernels::ComputeFalloffWeights(
+            positions, m_AffectedVertices.data() + begin, end - begin,
+            hitPoint, settings.radius, settings.falloff, m_Weights.data() + begin);
+        for (size_t k = begin; k < end; ++k) {
+          vertices[m_AffectedVertices[k]] += worldDelta * m_Weights[k];
+        }
+      });
+
+  mesh.MarkVerticesDirty(m_AffectedVertices);
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Sculpting/ISculptTool.h"
 
 class GrabTool : public ISculptTool {
@@ -9,4 +11,8 @@ class GrabTool : public ISculptTool {
              const BrushSettings& settings, const glm::mat4& viewMatrix,
              const glm::mat4& projectionMatrix, int viewportWidth,
              int viewportHeight) override;
+
+ private:
+  std::vector<uint32_t> m_AffectedVertices;  // Reused across dabs
+  std::vector<float> m_Weights;              // Falloff per affected vertex
 };
\ No newline at end of file
@@ -1,9 +1,14 @@
 #include "Sculpting/Tools/PushPullTool.h"
 
-#include <glm/gtx/norm.hpp>
-
+#include "Core/JobSystem.h"
 #include "Core/UI/BrushSettings.h"
 #include "Interfaces/IEditableMesh.h"
+#include "Sculpting/BrushKernels.h"
+
+namespace {
+// Below this many vertices a dab is cheaper to run on one thread.
+constexpr size_t kMinVerticesPerJob = 2048;
+}  // namespace
 
 void PushPullTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                          const glm::vec3& rayDirection,
@@ -12,21 +17,31 @@ void PushPullTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                          const glm::mat4& viewMatrix,
                          const glm::mat4& projectionMatrix, int viewportWidth,
                          int viewportHeight) {
-  float brushRadiusSq = settings.radius * settings.radius;
   float direction = (settings.mode == SculptMode::Pull) ? 1.0f : -1.0f;
 
+  mesh.QueryVerticesInSphere(hitPoint, settings.radius, m_AffectedVertices);
+  if (m_AffectedVertices.empty()) return;
+
+  m_Weights.resize(m_AffectedVertices.size());
+
+  // Fetch the SoA copy before mutable access marks it stale.
+  const VertexSoA& positions = mesh.GetPositionsSoA();
   auto& vertices = mesh.GetVertices();
   const auto& normals = mesh.GetNormals();
+  const float scale = direction * settings.strength * 0.1f;
+
+  // Each vertex only reads its own normal, so chunks never overlap.
+  JobSystem::Get().ParallelFor(
+      m_AffectedVertices.size(), kMinVerticesPerJob,
+      [&](size_t begin, size_t end) {
+        BrushKernels::ComputeFalloffWeights(
+            positions, m_AffectedVertices.data() + begin, end - begin,
+            hitPoint, settings.radius, settings.falloff, m_Weights.data() + begin);
+        for (size_t k = begin; k < end; ++k) {
+          uint32_t i = m_AffectedVertices[k];
+          vertices[i] += normals[i] * (scale * m_Weights[k]);
+        }
+      });
 
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    glm::vec3& vertex = vertices[i];
-    float distSq = glm::distance2(hitPoint, vertex);
-
-    if (distSq < brushRadiusSq) {
-      float normalizedDist = glm::sqrt(distSq) / settings.radius;
-      float falloff = settings.falloff.Evaluate(normalizedDist);
-      const glm::vec3& normal = normals[i];
-      vertex += normal * direction * settings.strength * falloff * 0.1f;
-    }
-  }
+  mesh.MarkVerticesDirty(m_AffectedVertices);
 }
\ No newline at end of file
@@ -1,9 +1,25 @@
 #include "Sculpting/Tools/SmoothTool.h"
 
-#include <glm/gtx/norm.hpp>
+#include <glm/glm.hpp>
 
+#include "Core/JobSystem.h"
 #include "Core/UI/BrushSettings.h"
 #include "Interfaces/IEditableMesh.h"
+#include "Sculpting/BrushKernels.h"
+
+namespace {
+// Below this many vertices a dab is cheaper to run on one thread.
+constexpr size_t kMinVerticesPerJob = 2048;
+// Taubin shrink factor and pass-band frequency; the inflate factor follows
+// as 1 / (kPassBand - 1 / kLambda). With lambda at most 0.5 the combined
+// response (1 - lambda k)(1 - mu k) is non-negative over the whole umbrella
+// spectrum k in [0, 2] and exceeds 1 only negligibly inside the pass band, so
+// noise decays instead of ringing. Strength scales both factors, which keeps
+// that bound.
+constexpr float kLambda = 0.5f;
+constexpr float kPassBand = 0.1f;
+constexpr float kMu = 1.0f / (kPassBand - 1.0f / kLambda);
+}  // namespace
 
 void SmoothTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                        const glm::vec3& rayDirection,
@@ -12,34 +28,67 @@ void SmoothTool::Apply(IEditableMesh& mesh, const glm::vec3& hitPoint,
                        const glm::mat4& viewMatrix,
                        const glm::mat4& projectionMatrix, int viewportWidth,
                        int viewportHeight) {
-  float brushRadiusSq = settings.radius * settings.radius;
+  mesh.QueryVerticesInSphere(hitPoint, settings.radius, m_AffectedVertices);
+  if (m_AffectedVertices.empty()) return;
+
+  const size_t count = m_AffectedVertices.size();
+  m_Weights.resize(count);
+  m_Smoothed.resize(count);
+
+  // Fetch the read-only structures before mutable access marks them stale.
+  const VertexSoA& positions = mesh.GetPositionsSoA();
+  const VertexAdjacency& adjacency = mesh.GetVertexAdjacency();
   auto& vertices = mesh.GetVertices();
-  std::vector<glm::vec3> smoothedVertices = vertices;
-  std::vector<size_t> affectedIndices;
 
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    if (glm::distance2(hitPoint, vertices[i]) < brushRadiusSq) {
-      affectedIndices.push_back(i);
-    }
-  }
+  JobSystem::Get().ParallelFor(
+      count, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+        BrushKernels::ComputeFalloffWeights(
+            positions, m_AffectedVertices.data() + begin, end - begin,
+            hitPoint, settings.radius, settings.falloff,
+            m_Weights.data() + begin);
+      });
 
-  if (affectedIndices.size() < 2) {
-    return;
+  // A plain Laplacian pass is stable for any factor up to 1.
+  const float strength = glm::clamp(settings.strength, 0.0f, 1.0f);
+  if (!settings.preserveVolume) {
+    smoothPass(vertices, adjacency, strength);
+  } else if (strength > 0.0f) {
+    smoothPass(vertices, adjacency, kLambda * strength);
+    smoothPass(vertices, adjacency, kMu * strength);
   }
 
-  glm::vec3 centerOfMass(0.0f);
-  for (size_t index : affectedIndices) {
-    centerOfMass += vertices[index];
-  }
-  centerOfMass /= affectedIndices.size();
-
-  for (size_t index : affectedIndices) {
-    const glm::vec3& originalVertex = vertices[index];
-    float falloff = settings.falloff.Evaluate(
-        glm::sqrt(glm::distance2(hitPoint, originalVertex)) / settings.radius);
-    smoothedVertices[index] =
-        glm::mix(originalVertex, centerOfMass, settings.strength * falloff);
-  }
+  mesh.MarkVerticesDirty(m_AffectedVertices);
+}
+
+void SmoothTool::smoothPass(std::vector<glm::vec3>& vertices,
+                            const VertexAdjacency& adjacency, float factor) {
+  auto& jobs = JobSystem::Get();
+  const size_t count = m_AffectedVertices.size();
 
-  mesh.GetVertices() = smoothedVertices;
-}
\ No newline at end of file
+  // Neighbors may themselves be affected, so every new position is computed
+  // from the old ones before any is written back.
+  jobs.ParallelFor(count, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      uint32_t v = m_AffectedVertices[k];
+      uint32_t first = adjacency.offsets[v];
+      uint32_t last = adjacency.offsets[v + 1];
+      if (first == last) {
+        m_Smoothed[k] = vertices[v];
+        continue;
+      }
+      glm::vec3 average(0.0f);
+      for (uint32_t n = first; n < last; ++n) {
+        average += vertices[adjacency.neighbors[n]];
+      }
+      average /= static_cast<float>(last - first);
+      m_Smoothed[k] =
+          vertices[v] + (average - vertices[v]) * (factor * m_Weights[k]);
+    }
+  });
+
+  jobs.ParallelFor(count, kMinVerticesPerJob, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      vertices[m_AffectedVertices[k]] = m_Smoothed[k];
+    }
+  });
+}
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <vector>
+
 #include "Sculpting/ISculptTool.h"
 
+struct VertexAdjacency;
+
 /**
  * @class SmoothTool
- * @brief A sculpting tool that averages vertex positions to smooth the mesh.
+ * @brief A sculpting tool that moves each vertex toward the average of its
+ * edge-connected neighbors (umbrella Laplacian), optionally followed by an
+ * inflating pass (Taubin) so repeated dabs do not shrink the surface.
  */
 class SmoothTool : public ISculptTool {
  public:
@@ -13,4 +19,12 @@ class SmoothTool : public ISculptTool {
              const BrushSettings& settings, const glm::mat4& viewMatrix,
              const glm::mat4& projectionMatrix, int viewportWidth,
              int viewportHeight) override;
+
+ private:
+  void smoothPass(std::vector<glm::vec3>& vertices,
+                  const VertexAdjacency& adjacency, float factor);
+
+  std::vector<uint32_t> m_AffectedVertices;  // Reused across dabs
+  std::vector<float> m_Weights;              // Falloff per affected vertex
+  std::vector<glm::vec3> m_Smoothed;         // Pass output, per affected vertex
 };
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "Sculpting/VertexSpatialHash.h"
+
+#include <cmath>
+#include <glm/gtx/norm.hpp>
+
+namespace {
+// Cells smaller than this fraction of the query radius make queries visit too
+// many buckets; larger than the multiple, buckets hold too many far vertices.
+constexpr float kMinCellToRadius = 0.5f;
+constexpr float kMaxCellToRadius = 2.0f;
+}  // namespace
+
+void VertexSpatialHash::Clear() {
+  m_CellSize = 0.0f;
+  m_InvCellSize = 0.0f;
+  m_Cells.clear();
+  m_VertexCell.clear();
+  m_VertexSlot.clear();
+}
+
+void VertexSpatialHash::Build(const std::vector<glm::vec3>& vertices,
+                              float cellSize) {
+  Clear();
+  if (cellSize <= 0.0f) return;
+
+  m_CellSize = cellSize;
+  m_InvCellSize = 1.0f / cellSize;
+  m_VertexCell.resize(vertices.size());
+  m_VertexSlot.resize(vertices.size());
+  m_Cells.reserve(vertices.size() / 4 + 1);
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    insert(static_cast<uint32_t>(i), cellKey(cellCoord(vertices[i])));
+  }
+}
+
+void VertexSpatialHash::Update(const std::vector<glm::vec3>& vertices,
+                               const std::vector<uint32_t>& movedIndices) {
+  if (m_CellSize <= 0.0f) return;
+
+  for (uint32_t index : movedIndices) {
+    if (index >= m_VertexCell.size()) continue;
+    uint64_t key = cellKey(cellCoord(vertices[index]));
+    if (key == m_VertexCell[index]) continue;
+    remove(index);
+    insert(index, key);
+  }
+}
+
+void VertexSpatialHash::Query(const std::vector<glm::vec3>& vertices,
+                              const glm::vec3& center, float radius,
+                              std::vector<uint32_t>& outIndices) const {
+  if (m_CellSize <= 0.0f) return;
+
+  const float radiusSq = radius * radius;
+  const glm::ivec3 minCell = cellCoord(center - glm::vec3(radius));
+  const glm::ivec3 maxCell = cellCoord(center + glm::vec3(radius));
+
+  for (int z = minCell.z; z <= maxCell.z; ++z) {
+    for (int y = minCell.y; y <= maxCell.y; ++y) {
+      for (int x = minCell.x; x <= maxCell.x; ++x) {
+        auto it = m_Cells.find(cellKey(glm::ivec3(x, y, z)));
+        if (it == m_Cells.end()) continue;
+        for (uint32_t index : it->second) {
+          if (glm::distance2(center, vertices[index]) < radiusSq) {
+            outIndices.push_back(index);
+          }
+        }
+      }
+    }
+  }
+}
+
+bool VertexSpatialHash::IsSuitableFor(size_t vertexCount, float radius) const {
+  return m_CellSize > 0.0f && m_VertexCell.size() == vertexCount &&
+         m_CellSize >= radius * kMinCellToRadius &&
+         m_CellSize <= radius * kMaxCellToRadius;
+}
+
+glm::ivec3 VertexSpatialHash::cellCoord(const glm::vec3& position) const {
+  return glm::ivec3(static_cast<int>(std::floor(position.x * m_InvCellSize)),
+                    static_cast<int>(std::floor(position.y * m_InvCellSize)),
+                    static_cast<int>(std::floor(position.z * m_InvCellSize)));
+}
+
+uint64_t VertexSpatialHash::cellKey(const glm::ivec3& cell) const {
+  // 21 bits per axis is plenty for any brush-sized grid over a sane mesh.
+  constexpr uint64_t kMask = (1ull << 21) - 1;
+  return (static_cast<uint64_t>(cell.x) & kMask) |
+         ((static_cast<uint64_t>(cell.y) & kMask) << 21) |
+         ((static_cast<uint64_t>(cell.z) & kMask) << 42);
+}
+
+void VertexSpatialHash::insert(uint32_t vertexIndex, uint64_t key) {
+  auto& bucket = m_Cells[key];
+  m_VertexCell[vertexIndex] = key;
+  m_VertexSlot[vertexIndex] = static_cast<uint32_t>(bucket.size());
+  bucket.push_back(vertexIndex);
+}
+
+void VertexSpatialHash::remove(uint32_t vertexIndex) {
+  auto it = m_Cells.find(m_VertexCell[vertexIndex]);
+  if (it == m_Cells.end()) return;
+
+  auto& bucket = it->second;
+  uint32_t slot = m_VertexSlot[vertexIndex];
+  uint32_t last = bucket.back();
+  bucket[slot] = last;
+  m_VertexSlot[last] = slot;
+  bucket.pop_back();
+  if (bucket.empty()) m_Cells.erase(it);
+}
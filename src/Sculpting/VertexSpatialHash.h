@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Hashed uniform grid over mesh vertices for brush-radius queries.
+ *
+ * Each vertex remembers its cell and its slot inside that cell, so moving a
+ * vertex to another cell is an O(1) swap-remove plus append.
+ */
+class VertexSpatialHash {
+ public:
+  void Build(const std::vector<glm::vec3>& vertices, float cellSize);
+  void Clear();
+
+  /**
+   * @brief Re-buckets the given vertices after they moved.
+   */
+  void Update(const std::vector<glm::vec3>& vertices,
+              const std::vector<uint32_t>& movedIndices);
+
+  /**
+   * @brief Appends the indices of all vertices strictly inside the sphere.
+   */
+  void Query(const std::vector<glm::vec3>& vertices, const glm::vec3& center,
+             float radius, std::vector<uint32_t>& outIndices) const;
+
+  /**
+   * @brief True if the grid covers this many vertices and its cells are a
+   * sensible size for a query of the given radius.
+   */
+  bool IsSuitableFor(size_t vertexCount, float radius) const;
+
+  float GetCellSize() const { return m_CellSize; }
+
+ private:
+  uint64_t cellKey(const glm::ivec3& cell) const;
+  glm::ivec3 cellCoord(const glm::vec3& position) const;
+  void insert(uint32_t vertexIndex, uint64_t key);
+  void remove(uint32_t vertexIndex);
+
+  float m_CellSize = 0.0f;
+  float m_InvCellSize = 0.0f;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+  std::vector<uint64_t> m_VertexCell;  // Cell key per vertex
+  std::vector<uint32_t> m_VertexSlot;  // Position inside that cell's list
+};
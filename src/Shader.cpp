@@ -181,6 +181,11 @@ unsigned int Shader::createShaderProgram(const std::string& vs,
     throw std::runtime_error(errorMsg);
   }
 
+  GLuint cameraBlock = glGetUniformBlockIndex(prog, "Camera");
+  if (cameraBlock != GL_INVALID_INDEX) {
+    glUniformBlockBinding(prog, cameraBlock, kCameraBlockBinding);
+  }
+
   glDeleteShader(v);
   glDeleteShader(f);
   return prog;
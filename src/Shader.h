@@ -8,6 +8,10 @@
 
 class Shader {
  public:
+  // Uniform buffer binding of the per-frame `Camera` block (view, projection,
+  // eye position), which shaders declare instead of setting those per draw.
+  static constexpr unsigned int kCameraBlockBinding = 0;
+
   Shader(const std::string& vertexPath, const std::string& fragmentPath);
   Shader(const char* vertexSource, const char* fragmentSource, bool fromMemory);
 
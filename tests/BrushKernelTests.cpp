@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "Core/UI/Curve.h"
+#include "Sculpting/BrushKernels.h"
+#include "gtest/gtest.h"
+
+namespace {
+// A jittered grid of points spread over a cube twice the brush diameter, so
+// roughly half of them fall outside the brush.
+std::vector<glm::vec3> MakePointCloud(int perAxis) {
+  std::vector<glm::vec3> points;
+  for (int z = 0; z < perAxis; ++z) {
+    for (int y = 0; y < perAxis; ++y) {
+      for (int x = 0; x < perAxis; ++x) {
+        glm::vec3 p(x, y, z);
+        p += glm::vec3(std::sin(x * 12.9898f + y * 78.233f) * 0.3f,
+                       std::sin(y * 39.346f + z * 11.135f) * 0.3f,
+                       std::sin(z * 73.156f + x * 52.235f) * 0.3f);
+        points.push_back(p / static_cast<float>(perAxis) * 4.0f - 2.0f);
+      }
+    }
+  }
+  return points;
+}
+
+Curve MakeFalloffCurve() {
+  Curve curve;
+  curve.AddPoint({0.0f, 1.0f});
+  curve.AddPoint({0.3f, 0.9f});
+  curve.AddPoint({0.7f, 0.2f});
+  curve.AddPoint({1.0f, 0.0f});
+  return curve;
+}
+}  // namespace
+
+TEST(BrushKernelTest, ScalarWeightsMatchCurve) {
+  std::vector<glm::vec3> points = MakePointCloud(12);
+  VertexSoA soa;
+  soa.Assign(points);
+  std::vector<uint32_t> indices(points.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  Curve curve = MakeFalloffCurve();
+
+  const glm::vec3 center(0.1f, -0.2f, 0.05f);
+  const float radius = 1.0f;
+  std::vector<float> weights(indices.size());
+  BrushKernels::ComputeFalloffWeights(BrushKernels::Path::Scalar, soa,
+                                      indices.data(), indices.size(), center,
+                                      radius, curve, weights.data());
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    float dist = glm::distance(points[i], center);
+    float expected = dist < radius ? curve.Evaluate(dist / radius) : 0.0f;
+    // The curve is piecewise linear, so the table is exact except inside the
+    // few cells that straddle a control point.
+    EXPECT_NEAR(weights[i], expected, 2e-3f) << "Vertex " << i;
+  }
+}
+
+TEST(BrushKernelTest, AVX2MatchesScalar) {
+  if (!BrushKernels::IsPathSupported(BrushKernels::Path::AVX2)) {
+    GTEST_SKIP() << "AVX2 not supported on this CPU";
+  }
+
+  std::vector<glm::vec3> points = MakePointCloud(10);
+  VertexSoA soa;
+  soa.Assign(points);
+  // Shuffled, and not a multiple of eight, to cover the gathers and the tail.
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < points.size(); i += 3) indices.push_back(i);
+  for (uint32_t i = 1; i < points.size(); i += 3) indices.push_back(i);
+  ASSERT_NE(indices.size() % 8, 0u);
+
+  Curve curve = MakeFalloffCurve();
+  const glm::vec3 center(-0.3f, 0.4f, 0.2f);
+  std::vector<float> scalar(indices.size());
+  std::vector<float> avx2(indices.size());
+  BrushKernels::ComputeFalloffWeights(BrushKernels::Path::Scalar, soa,
+                                      indices.data(), indices.size(), center,
+                                      1.25f, curve, scalar.data());
+  BrushKernels::ComputeFalloffWeights(BrushKernels::Path::AVX2, soa,
+                                      indices.data(), indices.size(), center,
+                                      1.25f, curve, avx2.data());
+
+  for (size_t i = 0; i < indices.size(); ++i) {
+    EXPECT_FLOAT_EQ(avx2[i], scalar[i]) << "Entry " << i;
+  }
+}
+
+TEST(BrushKernelTest, ZeroRadiusGivesZeroWeights) {
+  std::vector<glm::vec3> points = {glm::vec3(0.0f), glm::vec3(0.1f)};
+  VertexSoA soa;
+  soa.Assign(points);
+  std::vector<uint32_t> indices = {0, 1};
+  std::vector<float> weights(2, -1.0f);
+
+  BrushKernels::ComputeFalloffWeights(soa, indices.data(), indices.size(),
+                                      glm::vec3(0.0f), 0.0f, MakeFalloffCurve(),
+                                      weights.data());
+  EXPECT_EQ(weights[0], 0.0f);
+  EXPECT_EQ(weights[1], 0.0f);
+}
+
+TEST(BrushKernelTest, BakedCurveMatchesEvaluate) {
+  Curve curve = MakeFalloffCurve();
+  std::vector<float> xs;
+  for (int i = -10; i <= 1010; ++i) xs.push_back(i * 0.001f);
+  std::vector<float> baked(xs.size());
+  curve.EvaluateBaked(xs, baked);
+
+  for (size_t i = 0; i < xs.size(); ++i) {
+    EXPECT_NEAR(baked[i], curve.Evaluate(std::clamp(xs[i], 0.0f, 1.0f)), 2e-3f)
+        << "x = " << xs[i];
+    EXPECT_EQ(baked[i], curve.EvaluateBaked(xs[i]));
+  }
+  EXPECT_EQ(curve.EvaluateBaked(0.0f), 1.0f);
+  EXPECT_EQ(curve.EvaluateBaked(1.0f), 0.0f);
+  EXPECT_EQ(curve.EvaluateBaked(std::nanf("")), 1.0f);
+}
+
+TEST(BrushKernelTest, BakedCurveFollowsPointEdits) {
+  Curve curve = MakeFalloffCurve();
+  EXPECT_NEAR(curve.EvaluateBaked(0.5f), curve.Evaluate(0.5f), 1e-6f);
+
+  // Editing points through GetPoints() takes effect once SortPoints() runs,
+  // which is what the inspector does after every drag.
+  curve.GetPoints()[1].pos = glm::vec2(0.5f, 0.1f);
+  curve.SortPoints();
+  EXPECT_NEAR(curve.EvaluateBaked(0.5f), 0.1f, 1e-6f);
+
+  curve.AddPoint({0.625f, 0.8f});
+  EXPECT_NEAR(curve.EvaluateBaked(0.625f), 0.8f, 1e-6f);
+
+  Curve empty;
+  EXPECT_EQ(empty.EvaluateBaked(0.5f), 0.0f);
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Core/CommandHistory.h"
+#include "Core/EditCommands.h"
+#include "Core/PropertyNames.h"
+#include "Factories/SceneObjectFactory.h"
+#include "Interfaces.h"
+#include "Scene/Objects/Icosphere.h"
+#include "Scene/Objects/Pyramid.h"
+#include "Scene/Scene.h"
+#include "Sculpting/MeshDelta.h"
+
+namespace {
+
+class FakeCommand : public ICommand {
+ public:
+  FakeCommand(size_t bytes, int* undone = nullptr, bool applies = true)
+      : m_Bytes(bytes), m_Undone(undone), m_Applies(applies) {}
+  bool Undo(Scene&) override {
+    if (m_Undone) ++*m_Undone;
+    return m_Applies;
+  }
+  bool Redo(Scene&) override { return m_Applies; }
+  const char* GetName() const override { return "Fake"; }
+  size_t GetMemoryBytes() const override { return m_Bytes; }
+
+ private:
+  size_t m_Bytes;
+  int* m_Undone;
+  bool m_Applies;
+};
+
+void expectVerticesNear(const std::vector<glm::vec3>& actual,
+                        const std::vector<glm::vec3>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i].x, expected[i].x, 1e-5f) << "vertex " << i;
+    EXPECT_NEAR(actual[i].y, expected[i].y, 1e-5f) << "vertex " << i;
+    EXPECT_NEAR(actual[i].z, expected[i].z, 1e-5f) << "vertex " << i;
+  }
+}
+
+}  // namespace
+
+class CommandHistoryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    scene = std::make_unique<Scene>(&factory);
+    scene->AddObject(std::make_unique<Pyramid>());
+    object = scene->GetSceneObjects().back().get();
+  }
+
+  const std::vector<glm::vec3>& vertices() const {
+    return object->GetMesh()->GetVertices();
+  }
+
+  SceneObjectFactory factory;
+  std::unique_ptr<Scene> scene;
+  ISceneObject* object = nullptr;
+  CommandHistory history;
+};
+
+TEST(VertexDeltaTest, EncodesOnlyMovedVerticesWithinOneStep) {
+  std::vector<uint32_t> indices = {3, 4, 900, 70000};
+  std::vector<glm::vec3> before(4, glm::vec3(1.0f));
+  std::vector<glm::vec3> after = {glm::vec3(1.5f, 1.0f, 0.75f), glm::vec3(1.0f),
+                                  glm::vec3(1.0f, 1.25f, 1.0f),
+                                  glm::vec3(0.9f, 1.0f, 1.1f)};
+
+  VertexDelta delta = VertexDelta::Encode(1, indices, before, after);
+  EXPECT_EQ(delta.GetVertexCount(), 3u);  // Vertex 4 did not move
+
+  std::vector<uint32_t> decodedIndices;
+  std::vector<glm::vec3> offsets;
+  delta.Decode(decodedIndices, offsets);
+  EXPECT_EQ(decodedIndices, (std::vector<uint32_t>{3, 900, 70000}));
+  const float step = 0.5f / 32767.0f;
+  EXPECT_NEAR(offsets[0].x, 0.5f, step);
+  EXPECT_NEAR(offsets[0].z, -0.25f, step);
+  EXPECT_NEAR(offsets[1].y, 0.25f, step);
+  EXPECT_NEAR(offsets[2].x, -0.1f, step);
+  EXPECT_NEAR(offsets[2].z, 0.1f, step);
+
+  // Gaps and 16-bit offsets: well under the 16 bytes per vertex of an
+  // index plus a float position.
+  VertexDelta empty;
+  EXPECT_LT(delta.GetMemoryBytes() - empty.GetMemoryBytes(), 3 * 16u);
+}
+
+TEST_F(CommandHistoryTest, SculptStrokeUndoesAndRedoes) {
+  const std::vector<glm::vec3> original = vertices();
+  const bool wasPristine = object->isPristine;
+
+  VertexDeltaRecorder recorder;
+  recorder.Begin(*object->GetMesh());
+  object->isPristine = false;
+  IEditableMesh* mesh = object->GetEditableMesh();
+  std::vector<uint32_t> moved = {0, 2};
+  recorder.Capture(*mesh, moved);
+  mesh->GetVertices()[0] += glm::vec3(0.0f, 0.3f, 0.0f);
+  mesh->GetVertices()[2] += glm::vec3(0.1f, 0.0f, -0.2f);
+  mesh->MarkVerticesDirty(moved);
+  // A second dab over a vertex keeps its position from before the stroke.
+  recorder.Capture(*mesh, moved);
+  mesh->GetVertices()[0] += glm::vec3(0.0f, 0.3f, 0.0f);
+  mesh->MarkVerticesDirty(moved);
+
+  VertexDelta delta = recorder.End(*mesh);
+  EXPECT_EQ(delta.GetVertexCount(), 2u);
+  const std::vector<glm::vec3> sculpted = vertices();
+  EXPECT_NEAR(sculpted[0].y, original[0].y + 0.6f, 1e-4f);
+  history.Push(std::make_unique<VertexDeltaCommand>(
+      "Sculpt Stroke", object->id, std::move(delta), wasPristine));
+
+  ASSERT_TRUE(history.Undo(*scene));
+  expectVerticesNear(vertices(), original);
+  EXPECT_EQ(object->isPristine, wasPristine);
+  EXPECT_TRUE(object->IsMeshDirty());
+
+  ASSERT_TRUE(history.Redo(*scene));
+  expectVerticesNear(vertices(), sculpted);
+  EXPECT_FALSE(object->isPristine);
+}
+
+TEST_F(CommandHistoryTest, StrokeIsNotReplayedOnARegeneratedMesh) {
+  VertexDeltaRecorder recorder;
+  recorder.Begin(*object->GetCurrentMesh());
+  object->isPristine = false;
+  IEditableMesh* mesh = object->GetEditableMesh();
+  std::vector<uint32_t> moved = {4};
+  recorder.Capture(*mesh, moved);
+  mesh->GetVertices()[4] += glm::vec3(0.0f, 0.5f, 0.0f);
+  mesh->MarkVerticesDirty(moved);
+  history.Push(std::make_unique<VertexDeltaCommand>(
+      "Sculpt Stroke", object->id, recorder.End(*mesh), true));
+
+  // Changing a build property and back regenerates the mesh with the same
+  // vertex count, but without the stroke.
+  object->GetPropertySet().SetValue<float>(PropertyNames::Width, 2.0f);
+  object->GetPropertySet().SetValue<float>(PropertyNames::Width, 1.0f);
+  const std::vector<glm::vec3> regenerated =
+      object->GetCurrentMesh()->GetVertices();
+
+  EXPECT_FALSE(history.Undo(*scene));
+  EXPECT_EQ(object->GetCurrentMesh()->GetVertices(), regenerated);
+  EXPECT_FALSE(history.CanUndo());
+}
+
+TEST_F(CommandHistoryTest, TopologyEditStoresOnlyTheDiff) {
+  scene->AddObject(std::make_unique<Icosphere>());
+  object = scene->GetSceneObjects().back().get();
+  IEditableMesh* mesh = object->GetEditableMesh();
+  const std::vector<glm::vec3> beforeVertices = std::as_const(*mesh).GetVertices();
+  const std::vector<unsigned int> beforeIndices = std::as_const(*mesh).GetIndices();
+  ASSERT_TRUE(mesh->ExtrudeFaces({0}, 0.5f));
+  const std::vector<glm::vec3> afterVertices = std::as_const(*mesh).GetVertices();
+  const std::vector<unsigned int> afterIndices = std::as_const(*mesh).GetIndices();
+
+  TopologyDelta delta =
+      TopologyDelta::Compute(beforeVertices, beforeIndices, *mesh);
+  EXPECT_FALSE(delta.IsEmpty());
+  // Far less than either version of the mesh.
+  EXPECT_LT(delta.GetMemoryBytes() * 10,
+            beforeVertices.size() * sizeof(glm::vec3) +
+                beforeIndices.size() * sizeof(unsigned int));
+  ASSERT_TRUE(object->isPristine);
+  object->isPristine = false;
+  history.Push(std::make_unique<TopologyCommand>("Extrude", object->id,
+                                                 std::move(delta), true));
+
+  ASSERT_TRUE(history.Undo(*scene));
+  EXPECT_EQ(vertices(), beforeVertices);
+  EXPECT_EQ(object->GetMesh()->GetIndices(), beforeIndices);
+  EXPECT_EQ(object->GetMesh()->GetNormals().size(), beforeVertices.size());
+  EXPECT_TRUE(object->isPristine);
+
+  ASSERT_TRUE(history.Redo(*scene));
+  EXPECT_EQ(vertices(), afterVertices);
+  EXPECT_EQ(object->GetMesh()->GetIndices(), afterIndices);
+  EXPECT_FALSE(object->isPristine);
+}
+
+TEST_F(CommandHistoryTest, PropertyEditRestoresOnlyChangedValues) {
+  nlohmann::json before;
+  object->GetPropertySet().Serialize(before);
+  object->GetPropertySet().SetValue<float>(PropertyNames::Width, 3.0f);
+  object->SetPosition({1.0f, 2.0f, 3.0f});
+  nlohmann::json after;
+  object->GetPropertySet().Serialize(after);
+
+  auto command = PropertyCommand::FromSnapshots(object->id, before, after);
+  ASSERT_NE(command, nullptr);
+  EXPECT_EQ(PropertyCommand::FromSnapshots(object->id, after, after), nullptr);
+  history.Push(std::move(command));
+
+  // A value changed outside the command is left alone.
+  object->GetPropertySet().SetValue<float>(PropertyNames::Depth, 2.0f);
+  ASSERT_TRUE(history.Undo(*scene));
+  EXPECT_EQ(object->GetPropertySet().GetValue<float>(PropertyNames::Width), 1.0f);
+  EXPECT_EQ(object->GetPosition(), glm::vec3(0.0f));
+  EXPECT_EQ(object->GetPropertySet().GetValue<float>(PropertyNames::Depth), 2.0f);
+
+  ASSERT_TRUE(history.Redo(*scene));
+  EXPECT_EQ(object->GetPropertySet().GetValue<float>(PropertyNames::Width), 3.0f);
+  EXPECT_EQ(object->GetPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+}
+
+TEST_F(CommandHistoryTest, CommandsForDeletedObjectsAreDropped) {
+  history.Push(std::make_unique<PropertyCommand>(
+      object->id, nlohmann::json{{PropertyNames::Width, 1.0f}},
+      nlohmann::json{{PropertyNames::Width, 2.0f}}));
+  scene->QueueForDeletion(object->id);
+  scene->ProcessDeferredDeletions();
+
+  EXPECT_FALSE(history.Undo(*scene));
+  EXPECT_FALSE(history.CanUndo());
+  EXPECT_FALSE(history.CanRedo());
+  EXPECT_EQ(history.GetMemoryUsage(), 0u);
+}
+
+TEST_F(CommandHistoryTest, PushDropsRedoSteps) {
+  history.Push(std::make_unique<FakeCommand>(10));
+  history.Push(std::make_unique<FakeCommand>(10));
+  ASSERT_TRUE(history.Undo(*scene));
+  EXPECT_TRUE(history.CanRedo());
+
+  history.Push(std::make_unique<FakeCommand>(10));
+  EXPECT_FALSE(history.CanRedo());
+  EXPECT_EQ(history.GetUndoCount(), 2u);
+  EXPECT_EQ(history.GetMemoryUsage(), 20u);
+}
+
+TEST_F(CommandHistoryTest, BudgetDropsOldestStepsFirst) {
+  history.SetMemoryBudget(100);
+  int oldestUndone = 0;
+  history.Push(std::make_unique<FakeCommand>(40, &oldestUndone));
+  history.Push(std::make_unique<FakeCommand>(40));
+  history.Push(std::make_unique<FakeCommand>(40));
+  EXPECT_EQ(history.GetUndoCount(), 2u);
+  EXPECT_LE(history.GetMemoryUsage(), 100u);
+
+  while (history.Undo(*scene)) {
+  }
+  EXPECT_EQ(oldestUndone, 0);
+
+  // A single edit over budget is still kept.
+  history.Clear();
+  history.Push(std::make_unique<FakeCommand>(500));
+  EXPECT_TRUE(history.CanUndo());
+  history.SetMemoryBudget(10);
+  EXPECT_TRUE(history.CanUndo());
+}
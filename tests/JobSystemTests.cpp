@@ -0,0 +1,53 @@
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "gtest/gtest.h"
+
+TEST(JobSystemTest, ParallelForVisitsEveryIndexOnce) {
+  JobSystem jobs(3);
+  std::vector<int> hits(100000, 0);
+
+  jobs.ParallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) hits[i]++;
+  });
+
+  for (size_t i = 0; i < hits.size(); ++i) {
+    ASSERT_EQ(hits[i], 1) << "Index " << i;
+  }
+}
+
+TEST(JobSystemTest, SmallRangesRunInline) {
+  JobSystem jobs(3);
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id runner;
+
+  jobs.ParallelFor(10, 64, [&](size_t, size_t) { runner = std::this_thread::get_id(); });
+
+  EXPECT_EQ(runner, caller);
+}
+
+TEST(JobSystemTest, NestedParallelForCompletes) {
+  JobSystem jobs(2);
+  std::atomic<size_t> total{0};
+
+  jobs.ParallelFor(8, 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      jobs.ParallelFor(1000, 10, [&](size_t b, size_t e) { total += e - b; });
+    }
+  });
+
+  EXPECT_EQ(total.load(), 8u * 1000u);
+}
+
+TEST(JobSystemTest, WorksWithoutWorkers) {
+  JobSystem jobs(0);
+  std::vector<int> values(5000);
+
+  jobs.ParallelFor(values.size(), 16, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) values[i] = static_cast<int>(i);
+  });
+
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0LL), 4999LL * 5000LL / 2);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <set>
+#include <utility>
+
+#include "Core/PropertyNames.h"
+#include "Scene/MeshCache.h"
+#include "Scene/Objects/Icosphere.h"
+#include "Scene/Objects/Pyramid.h"
+
+TEST(MeshCacheTest, IdenticalPrimitivesShareOneMesh) {
+  Pyramid first;
+  Pyramid second;
+  ASSERT_NE(first.GetSharedMesh(), nullptr);
+  EXPECT_EQ(first.GetMesh(), second.GetMesh());
+  EXPECT_EQ(first.GetSharedMesh(), second.GetSharedMesh());
+}
+
+TEST(MeshCacheTest, DifferentPropertiesGetDifferentMeshes) {
+  Pyramid first;
+  Pyramid second;
+  second.GetPropertySet().SetValue<float>(PropertyNames::Width, 2.0f);
+  EXPECT_NE(first.GetMesh(), second.GetMesh());
+
+  // Back to the same values, back to the same mesh.
+  second.GetPropertySet().SetValue<float>(PropertyNames::Width, 1.0f);
+  EXPECT_EQ(first.GetMesh(), second.GetMesh());
+}
+
+TEST(MeshCacheTest, MutableAccessDetachesWithoutTouchingOthers) {
+  Pyramid edited;
+  Pyramid untouched;
+  const IEditableMesh* shared = untouched.GetMesh();
+  const glm::vec3 original = shared->GetVertices()[0];
+
+  IEditableMesh* own = edited.GetEditableMesh();
+  ASSERT_NE(own, shared);
+  EXPECT_EQ(edited.GetSharedMesh(), nullptr);
+  EXPECT_TRUE(edited.IsMeshDirty());
+  own->GetVertices()[0] = original + glm::vec3(5.0f);
+  own->MarkVerticesDirty({0});
+
+  EXPECT_EQ(untouched.GetMesh(), shared);
+  EXPECT_EQ(shared->GetVertices()[0], original);
+}
+
+TEST(MeshCacheTest, EntriesDieWithTheirLastUser) {
+  size_t before = MeshCache::Get().GetLiveCount();
+  {
+    Pyramid pyramid;
+    pyramid.GetPropertySet().SetValue<float>(PropertyNames::Depth, 7.25f);
+    pyramid.GetMesh();  // Meshes are built on first use
+    EXPECT_EQ(MeshCache::Get().GetLiveCount(), before + 1);
+  }
+  EXPECT_EQ(MeshCache::Get().GetLiveCount(), before);
+}
+
+TEST(MeshCacheTest, ReloadedPristineObjectKeepsSharing) {
+  Pyramid original;
+  nlohmann::json saved;
+  original.Serialize(saved);
+
+  Pyramid loaded;
+  loaded.Deserialize(saved);
+  EXPECT_NE(loaded.GetSharedMesh(), nullptr);
+  EXPECT_EQ(loaded.GetMesh(), original.GetMesh());
+}
+
+TEST(MeshCacheTest, LoadedMeshIsUsedWithoutGeneratingOne) {
+  nlohmann::json saved;
+  {
+    Pyramid original;
+    original.GetPropertySet().SetValue<float>(PropertyNames::Width, 3.75f);
+    original.Serialize(saved);
+  }
+  // A vertex the builder would never produce shows which mesh was kept.
+  const glm::vec3 marker(42.0f);
+  saved["sculpt_vertices"][0] = {marker.x, marker.y, marker.z};
+
+  Pyramid loaded;
+  loaded.Deserialize(saved);
+  EXPECT_EQ(loaded.GetMesh()->GetVertices()[0], marker);
+
+  // File data never seeds the cache: a new object with the same properties
+  // gets the generated mesh, not the loaded one.
+  Pyramid identical;
+  identical.GetPropertySet().SetValue<float>(PropertyNames::Width, 3.75f);
+  EXPECT_NE(identical.GetMesh(), loaded.GetMesh());
+  EXPECT_NE(identical.GetMesh()->GetVertices()[0], marker);
+
+  // Changing a build property still generates a fresh mesh.
+  loaded.GetPropertySet().SetValue<float>(PropertyNames::Width, 1.0f);
+  EXPECT_NE(loaded.GetMesh()->GetVertices()[0], marker);
+}
+
+TEST(MeshCacheTest, IcosphereLevelsAreClosedUnitSpheresScaledByRadius) {
+  std::vector<float> unitVertices, scaledVertices;
+  std::vector<unsigned int> unitIndices, scaledIndices;
+  Icosphere::GenerateMesh(3, 1.0f, unitVertices, unitIndices);
+  Icosphere::GenerateMesh(3, 2.5f, scaledVertices, scaledIndices);
+
+  // 10 * 4^n + 2 vertices and 20 * 4^n faces.
+  ASSERT_EQ(unitVertices.size(), (10u * 64 + 2) * 3);
+  ASSERT_EQ(unitIndices.size(), 20u * 64 * 3);
+  EXPECT_EQ(scaledIndices, unitIndices);
+  for (size_t i = 0; i < unitVertices.size(); i += 3) {
+    const glm::vec3 unit(unitVertices[i], unitVertices[i + 1], unitVertices[i + 2]);
+    EXPECT_NEAR(glm::length(unit), 1.0f, 1e-5f);
+    EXPECT_EQ(scaledVertices[i], unitVertices[i] * 2.5f);
+  }
+
+  // Closed: every edge is used once in each direction.
+  std::set<std::pair<unsigned int, unsigned int>> halfEdges;
+  for (size_t f = 0; f < unitIndices.size(); f += 3) {
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_TRUE(halfEdges.emplace(unitIndices[f + k], unitIndices[f + (k + 1) % 3]).second);
+    }
+  }
+  for (const auto& [from, to] : halfEdges) {
+    EXPECT_TRUE(halfEdges.count({to, from}));
+  }
+}
+
+TEST(MeshCacheTest, IcosphereLevelsOutsideTheRangeAreClamped) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  Icosphere::GenerateMesh(-3, 1.0f, vertices, indices);
+  EXPECT_EQ(vertices.size(), 12u * 3);
+  EXPECT_EQ(indices.size(), 20u * 3);
+
+  // Levels past the cached ones are rebuilt per call and must match.
+  std::vector<float> fineVertices, fineAgain;
+  std::vector<unsigned int> fineIndices, fineIndicesAgain;
+  Icosphere::GenerateMesh(6, 1.0f, fineVertices, fineIndices);
+  Icosphere::GenerateMesh(6, 1.0f, fineAgain, fineIndicesAgain);
+  EXPECT_EQ(fineVertices.size(), (10u * 4096 + 2) * 3);
+  EXPECT_EQ(fineVertices, fineAgain);
+  EXPECT_EQ(fineIndices, fineIndicesAgain);
+}
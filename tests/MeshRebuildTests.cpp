@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "Core/PropertyNames.h"
+#include "Scene/MeshRebuildScheduler.h"
+#include "Scene/Objects/Pyramid.h"
+
+namespace {
+
+class MeshRebuildTest : public ::testing::Test {
+ protected:
+  void SetUp() override { MeshRebuildScheduler::Get().SetEnabled(true); }
+  void TearDown() override {
+    MeshRebuildScheduler::Get().SetEnabled(false);
+    MeshRebuildScheduler::Get().WaitIdle();
+  }
+};
+
+}  // namespace
+
+TEST_F(MeshRebuildTest, EditsCoalesceIntoOneBackgroundBuild) {
+  MeshRebuildScheduler& scheduler = MeshRebuildScheduler::Get();
+  Pyramid pyramid;
+  const IEditableMesh* original = pyramid.GetMesh();
+  const size_t builds = scheduler.GetBuildCount();
+
+  for (float width : {3.25f, 3.5f, 3.75f}) {
+    pyramid.GetPropertySet().SetValue<float>(PropertyNames::Width, width);
+  }
+  pyramid.SetMeshDirty(false);
+  // The last good mesh stays up until the new one is ready.
+  EXPECT_EQ(pyramid.GetMesh(), original);
+
+  scheduler.WaitIdle();
+  EXPECT_EQ(scheduler.GetBuildCount(), builds + 1);
+  const IEditableMesh* rebuilt = pyramid.GetMesh();
+  EXPECT_NE(rebuilt, original);
+  EXPECT_TRUE(pyramid.IsMeshDirty());
+
+  // The result went into the cache under the final width.
+  Pyramid reference;
+  reference.GetPropertySet().SetValue<float>(PropertyNames::Width, 3.75f);
+  EXPECT_EQ(reference.GetMesh(), rebuilt);
+}
+
+TEST_F(MeshRebuildTest, UploadKeepsTheOldMeshUntilTheBuildLands) {
+  MeshRebuildScheduler& scheduler = MeshRebuildScheduler::Get();
+  Pyramid pyramid;
+  // A sculpted object owns its mesh, so nothing is shared through the cache.
+  pyramid.isPristine = false;
+  IEditableMesh* original = pyramid.GetEditableMesh();
+  const std::vector<glm::vec3> originalVertices =
+      std::as_const(*original).GetVertices();
+  const size_t builds = scheduler.GetBuildCount();
+
+  pyramid.GetPropertySet().SetValue<float>(PropertyNames::Width, 5.5f);
+  EXPECT_EQ(pyramid.GetMeshForUpload(), original);
+  EXPECT_EQ(std::as_const(*original).GetVertices(), originalVertices);
+
+  scheduler.WaitIdle();
+  EXPECT_EQ(scheduler.GetBuildCount(), builds + 1);
+  IEditableMesh* rebuilt = pyramid.GetMeshForUpload();
+  EXPECT_NE(rebuilt, original);
+  EXPECT_NE(std::as_const(*rebuilt).GetVertices(), originalVertices);
+}
+
+TEST_F(MeshRebuildTest, EditableAccessNeverSeesAStaleMesh) {
+  Pyramid pyramid;
+  pyramid.GetMesh();
+  pyramid.GetPropertySet().SetValue<float>(PropertyNames::Height, 4.25f);
+  pyramid.GetMesh();
+
+  IEditableMesh* mesh = pyramid.GetEditableMesh();
+  Pyramid reference;
+  reference.GetPropertySet().SetValue<float>(PropertyNames::Height, 4.25f);
+  EXPECT_EQ(mesh->GetVertices(), reference.GetMesh()->GetVertices());
+
+  // The background build that was overtaken does not replace the edit.
+  MeshRebuildScheduler::Get().WaitIdle();
+  EXPECT_EQ(pyramid.GetMesh(), mesh);
+}
@@ -0,0 +1,143 @@
+#include <cmath>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Sculpting/MultiresMesh.h"
+#include "Sculpting/SculptableMesh.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Closed mesh where every vertex has valence 4.
+SculptableMesh makeOctahedron() {
+  SculptableMesh mesh;
+  std::vector<glm::vec3> vertices = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0},
+                                     {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+  std::vector<unsigned int> indices = {0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4,
+                                       2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5};
+  mesh.InitializeFromBuffers(vertices, indices);
+  return mesh;
+}
+
+SculptableMesh makeQuad() {
+  SculptableMesh mesh;
+  std::vector<glm::vec3> vertices = {{-1, 1, 0}, {-1, -1, 0}, {1, -1, 0},
+                                     {1, 1, 0}};
+  mesh.InitializeFromBuffers(vertices, std::vector<unsigned int>{0, 1, 2, 0, 2, 3});
+  return mesh;
+}
+
+void expectNear(const glm::vec3& a, const glm::vec3& b) {
+  EXPECT_NEAR(a.x, b.x, 1e-5f);
+  EXPECT_NEAR(a.y, b.y, 1e-5f);
+  EXPECT_NEAR(a.z, b.z, 1e-5f);
+}
+
+}  // namespace
+
+TEST(MultiresTest, EachLevelQuadruplesFacesAndAddsAVertexPerEdge) {
+  MultiresMesh multires(makeOctahedron());
+  ASSERT_TRUE(multires.AddLevel());
+  ASSERT_TRUE(multires.AddLevel());
+  EXPECT_EQ(multires.GetMaxLevel(), 2);
+  EXPECT_EQ(multires.GetFaceCount(1), 32u);
+  EXPECT_EQ(multires.GetFaceCount(2), 128u);
+  // V + E: 6 + 12, then 18 + 48.
+  EXPECT_EQ(multires.GetVertexCount(1), 18u);
+  EXPECT_EQ(multires.GetVertexCount(2), 66u);
+
+  SculptableMesh fine;
+  multires.Extract(2, fine);
+  EXPECT_EQ(fine.GetVertices().size(), 66u);
+  EXPECT_EQ(fine.GetIndices().size(), 128u * 3);
+
+  multires.RemoveLevelsAbove(0);
+  EXPECT_EQ(multires.GetMaxLevel(), 0);
+}
+
+TEST(MultiresTest, NewLevelFollowsLoopMasks) {
+  MultiresMesh closed(makeOctahedron());
+  ASSERT_TRUE(closed.AddLevel());
+  SculptableMesh smooth;
+  closed.Extract(1, smooth);
+  // Valence 4: beta = 3/32, so a vertex keeps 1 - 4 * 3/32 of itself and its
+  // neighbours cancel out along its axis.
+  expectNear(smooth.GetVertices()[0], glm::vec3(0.625f, 0, 0));
+  // Interior edge: 3/8 of each end plus 1/8 of each opposite vertex.
+  for (size_t v = 6; v < smooth.GetVertices().size(); ++v) {
+    EXPECT_NEAR(glm::length(smooth.GetVertices()[v]), 0.375f * std::sqrt(2.0f), 1e-5f);
+  }
+
+  MultiresMesh open(makeQuad());
+  ASSERT_TRUE(open.AddLevel());
+  SculptableMesh flat;
+  open.Extract(1, flat);
+  const auto& vertices = flat.GetVertices();
+  ASSERT_EQ(vertices.size(), 9u);
+  // Boundary vertices follow the boundary curve only.
+  expectNear(vertices[1], glm::vec3(-0.75f, -0.75f, 0));
+  // Boundary edges split at their midpoints.
+  bool foundMidpoint = false;
+  for (size_t v = 4; v < vertices.size(); ++v) {
+    if (glm::length(vertices[v] - glm::vec3(-1, 0, 0)) < 1e-5f) {
+      foundMidpoint = true;
+    }
+  }
+  EXPECT_TRUE(foundMidpoint);
+}
+
+TEST(MultiresTest, StoredEditIsReproducedExactly) {
+  MultiresMesh multires(makeOctahedron());
+  ASSERT_TRUE(multires.AddLevel());
+  ASSERT_TRUE(multires.AddLevel());
+
+  SculptableMesh mesh;
+  multires.Extract(2, mesh);
+  std::vector<glm::vec3> edited = mesh.GetVertices();
+  edited[0] += glm::vec3(0.3f, 0.1f, 0);
+  edited[40] += glm::vec3(0, 0.2f, -0.1f);
+  mesh.InitializeFromBuffers(edited, std::vector<unsigned int>(mesh.GetIndices()));
+  ASSERT_TRUE(multires.Store(2, mesh));
+
+  SculptableMesh level2;
+  multires.Extract(2, level2);
+  for (size_t v = 0; v < edited.size(); ++v) expectNear(level2.GetVertices()[v], edited[v]);
+
+  // Vertex 0 exists on every level and takes the edit down with it.
+  SculptableMesh base;
+  multires.Extract(0, base);
+  expectNear(base.GetVertices()[0], glm::vec3(1.3f, 0.1f, 0));
+}
+
+TEST(MultiresTest, CoarseEditCarriesFineDetail) {
+  MultiresMesh multires(makeOctahedron());
+  ASSERT_TRUE(multires.AddLevel());
+
+  SculptableMesh fine;
+  multires.Extract(1, fine);
+  std::vector<glm::vec3> detailed = fine.GetVertices();
+  detailed[10] += glm::vec3(0, 0, 0.25f);
+  fine.InitializeFromBuffers(detailed, std::vector<unsigned int>(fine.GetIndices()));
+  ASSERT_TRUE(multires.Store(1, fine));
+
+  // Move the whole cage; the stencils are affine, so the detail moves along.
+  SculptableMesh coarse;
+  multires.Extract(0, coarse);
+  std::vector<glm::vec3> moved = coarse.GetVertices();
+  for (auto& p : moved) p += glm::vec3(2, 0, 0);
+  coarse.InitializeFromBuffers(moved, std::vector<unsigned int>(coarse.GetIndices()));
+  ASSERT_TRUE(multires.Store(0, coarse));
+
+  multires.Extract(1, fine);
+  for (size_t v = 0; v < detailed.size(); ++v) {
+    expectNear(fine.GetVertices()[v], detailed[v] + glm::vec3(2, 0, 0));
+  }
+}
+
+TEST(MultiresTest, StoreRejectsChangedTopology) {
+  MultiresMesh multires(makeOctahedron());
+  ASSERT_TRUE(multires.AddLevel());
+  EXPECT_FALSE(multires.Store(1, makeOctahedron()));
+  EXPECT_FALSE(multires.Store(3, makeOctahedron()));
+  EXPECT_TRUE(multires.Store(0, makeOctahedron()));
+}
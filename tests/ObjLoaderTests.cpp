@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Core/ObjLoader.h"
+#include "gtest/gtest.h"
+
+TEST(ObjLoaderTest, FanTriangulatesPolygons) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Parse(
+      "# quad and pentagon\n"
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv -1 0.5 0\n"
+      "f 1 2 3 4\n"
+      "f 1 4 5 2 3\n",
+      vertices, indices));
+
+  EXPECT_EQ(vertices.size(), 5u * 3);
+  EXPECT_EQ(indices, (std::vector<unsigned int>{0, 1, 2, 0, 2, 3,  //
+                                                0, 3, 4, 0, 4, 1, 0, 1, 2}));
+}
+
+TEST(ObjLoaderTest, SplitsCornersByFullIndexTriplet) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Parse(
+      "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+      "vn 0 0 1\nvn 0 0 -1\n"
+      "f 1//1 2//1 3//1\n"
+      "f 3//1 2//1 4//1\n"
+      "f 1//2 3//2 2//2\n",
+      vertices, indices));
+
+  // The last face reuses positions 1-3 with a different normal.
+  EXPECT_EQ(vertices.size(), 7u * 3);
+  EXPECT_EQ(indices, (std::vector<unsigned int>{0, 1, 2, 2, 1, 3, 4, 5, 6}));
+  EXPECT_FLOAT_EQ(vertices[6 * 3 + 0], 1.0f);  // Position 2 again
+  EXPECT_FLOAT_EQ(vertices[6 * 3 + 1], 0.0f);
+}
+
+TEST(ObjLoaderTest, ResolvesRelativeIndicesAndIgnoresOtherRecords) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Parse(
+      "mtllib scene.mtl\no Thing\ng Group\ns off\nusemtl Default\n"
+      "v  +1.5 2e1 -3\r\n"
+      "v 4 5 6\r\n"
+      "vt 0 0\nvt 1 0\nvt 0 1\n"
+      "v 7 8 9\r\n"
+      "f -3/-3 -2/-2 -1/-1\r\n",
+      vertices, indices));
+
+  EXPECT_EQ(vertices, (std::vector<float>{1.5f, 20.0f, -3.0f, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(indices, (std::vector<unsigned int>{0, 1, 2}));
+}
+
+TEST(ObjLoaderTest, SkipsFacesWithOutOfRangeIndices) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Parse("v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                               "f 1 2 9\n"
+                               "f 1 2 3\n",
+                               vertices, indices));
+  EXPECT_EQ(indices, (std::vector<unsigned int>{0, 1, 2}));
+}
+
+TEST(ObjLoaderTest, DropsBadTexcoordsAndSkipsFacesWithBadPositions) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+                               "vn 0 0 1\n"
+                               "f 1/0/1 2/x/1 3//1 4//1\n"
+                               "f 1//1 2//1 x//1\n"
+                               "f 2//1 4//1 3//1 # trailing comment\n",
+                               vertices, indices));
+
+  // The whole quad survives its unreadable texcoords.
+  EXPECT_EQ(vertices.size(), 4u * 3);
+  EXPECT_EQ(indices, (std::vector<unsigned int>{0, 1, 2, 0, 2, 3, 1, 3, 2}));
+}
+
+TEST(ObjLoaderTest, RejectsTextWithoutFaces) {
+  std::vector<float> vertices = {1.0f};
+  std::vector<unsigned int> indices = {1};
+  EXPECT_FALSE(ObjLoader::Parse("this is not valid obj data", vertices, indices));
+  EXPECT_TRUE(vertices.empty());
+  EXPECT_TRUE(indices.empty());
+  EXPECT_FALSE(ObjLoader::Load("non_existent_mesh.obj", vertices, indices));
+}
+
+TEST(ObjLoaderTest, LargeFileMatchesAcrossChunks) {
+  // Enough text to be split across threads, with relative indices that reach
+  // back over chunk boundaries.
+  const int rows = 300, cols = 300;
+  std::string text;
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      text += "v " + std::to_string(x) + " " + std::to_string(y) + " 0.000000\n";
+    }
+  }
+  std::vector<unsigned int> expected;
+  for (int y = 0; y + 1 < rows; ++y) {
+    for (int x = 0; x + 1 < cols; ++x) {
+      int i0 = y * cols + x;
+      int total = rows * cols;
+      // Relative to the total vertex count, written after all vertices.
+      text += "f " + std::to_string(i0 - total) + " " + std::to_string(i0 + 1 - total) +
+              " " + std::to_string(i0 + cols + 1 - total) + " " +
+              std::to_string(i0 + cols - total) + "\n";
+      expected.insert(expected.end(), {0u, 1u, 2u, 0u, 2u, 3u});
+      for (size_t k = expected.size() - 6; k < expected.size(); ++k) {
+        unsigned int corner[4] = {static_cast<unsigned int>(i0),
+                                  static_cast<unsigned int>(i0 + 1),
+                                  static_cast<unsigned int>(i0 + cols + 1),
+                                  static_cast<unsigned int>(i0 + cols)};
+        expected[k] = corner[expected[k]];
+      }
+    }
+  }
+
+  const char* filename = "obj_loader_large_test.obj";
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << text;
+  }
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(ObjLoader::Load(filename, vertices, indices));
+  std::remove(filename);
+
+  // Vertices are emitted in first-use order; map them back by position.
+  ASSERT_EQ(vertices.size(), static_cast<size_t>(rows * cols) * 3);
+  ASSERT_EQ(indices.size(), expected.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const float* p = &vertices[indices[i] * 3];
+    unsigned int original = static_cast<unsigned int>(p[1]) * cols + static_cast<unsigned int>(p[0]);
+    ASSERT_EQ(original, expected[i]) << "Corner " << i;
+  }
+}
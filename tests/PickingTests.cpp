@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "Renderer/PickingBuffer.h"
+
+namespace {
+
+// Builds an image from rows given top first, stored bottom-up like a GL readback.
+PickIdImage makeImage(const std::vector<std::vector<uint32_t>>& rowsTopDown) {
+  PickIdImage image;
+  image.height = static_cast<int>(rowsTopDown.size());
+  image.width = static_cast<int>(rowsTopDown.front().size());
+  for (auto row = rowsTopDown.rbegin(); row != rowsTopDown.rend(); ++row) {
+    image.ids.insert(image.ids.end(), row->begin(), row->end());
+  }
+  return image;
+}
+
+// Completes the in-flight readback with a 1x1 image holding `id`.
+void completeWith(PickQueryQueue& queue, uint32_t id) {
+  PickIdImage image = makeImage({{id}});
+  queue.CompleteReadback(image);
+}
+
+}  // namespace
+
+TEST(PickIdImageTest, AtUsesTopLeftOrigin) {
+  PickIdImage image = makeImage({{1, 0, 0, 2},  //
+                                 {0, 0, 0, 0},
+                                 {3, 0, 0, 4}});
+  EXPECT_EQ(image.At(0, 0), 1u);
+  EXPECT_EQ(image.At(3, 0), 2u);
+  EXPECT_EQ(image.At(0, 2), 3u);
+  EXPECT_EQ(image.At(3, 2), 4u);
+  EXPECT_EQ(image.At(-1, 0), 0u);
+  EXPECT_EQ(image.At(0, 3), 0u);
+}
+
+TEST(PickIdImageTest, CollectRectReturnsUniqueIdsInReadingOrder) {
+  PickIdImage image = makeImage({{5, 5, 7, 0},  //
+                                 {7, 5, 9, 9},
+                                 {0, 0, 9, 5}});
+  EXPECT_EQ(image.CollectRect(0, 0, 3, 2), (std::vector<uint32_t>{5, 7, 9}));
+  EXPECT_EQ(image.CollectRect(2, 1, 3, 2), (std::vector<uint32_t>{9, 5}));
+}
+
+TEST(PickIdImageTest, CollectRectAcceptsAnyCornerOrderAndClamps) {
+  PickIdImage image = makeImage({{1, 2},  //
+                                 {3, 4}});
+  EXPECT_EQ(image.CollectRect(10, 10, -5, 1), (std::vector<uint32_t>{3, 4}));
+  EXPECT_TRUE(PickIdImage{}.CollectRect(0, 0, 10, 10).empty());
+}
+
+TEST(PickIdImageTest, CollectRectSkipsFilteredIds) {
+  PickIdImage image = makeImage({{1, 100, 2}});
+  auto ids = image.CollectRect(0, 0, 2, 0, [](uint32_t id) { return id >= 100; });
+  EXPECT_EQ(ids, (std::vector<uint32_t>{1, 2}));
+}
+
+TEST(PickQueryQueueTest, PickMadeAfterInvalidateSkipsTheStaleReadback) {
+  PickQueryQueue queue;
+  queue.BeginReadback();
+  queue.Invalidate();  // Camera moved while the readback was in flight
+
+  std::vector<uint32_t> answers;
+  queue.Enqueue([&](const PickIdImage& image) { answers.push_back(image.At(0, 0)); });
+
+  completeWith(queue, 1);
+  EXPECT_TRUE(answers.empty());
+  EXPECT_FALSE(queue.IsCurrent());
+  EXPECT_TRUE(queue.HasPendingQueries());
+
+  queue.BeginReadback();
+  completeWith(queue, 2);
+  EXPECT_EQ(answers, (std::vector<uint32_t>{2}));
+  EXPECT_TRUE(queue.IsCurrent());
+  EXPECT_FALSE(queue.HasPendingQueries());
+}
+
+TEST(PickQueryQueueTest, InFlightReadbackAnswersPicksOfTheSameScene) {
+  PickQueryQueue queue;
+  queue.BeginReadback();
+
+  std::vector<uint32_t> answers;
+  auto record = [&](const PickIdImage& image) { answers.push_back(image.At(0, 0)); };
+  queue.Enqueue(record);
+  completeWith(queue, 7);
+  EXPECT_EQ(answers, (std::vector<uint32_t>{7}));
+
+  // A current image answers straight away, until the scene changes again.
+  queue.Enqueue(record);
+  EXPECT_EQ(answers, (std::vector<uint32_t>{7, 7}));
+  queue.Invalidate();
+  queue.Enqueue(record);
+  EXPECT_EQ(answers.size(), 2u);
+  EXPECT_TRUE(queue.HasPendingQueries());
+}
+
+TEST(PickQueryQueueTest, DroppedReadbackHandsItsPicksToTheNextOne) {
+  PickQueryQueue queue;
+  queue.BeginReadback();
+
+  std::vector<uint32_t> answers;
+  queue.Enqueue([&](const PickIdImage& image) { answers.push_back(image.At(0, 0)); });
+  queue.DropReadback();
+  EXPECT_FALSE(queue.IsReadbackInFlight());
+  EXPECT_TRUE(answers.empty());
+
+  queue.BeginReadback();
+  completeWith(queue, 3);
+  EXPECT_EQ(answers, (std::vector<uint32_t>{3}));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <thread>
+
+#include "Core/Profiler.h"
+
+namespace {
+
+const Profiler::ZoneRecord* findZone(const Profiler::FrameRecord& frame,
+                                     const char* name) {
+  for (const auto& zone : frame.zones) {
+    if (std::strcmp(zone.name, name) == 0) return &zone;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+class ProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Other tests leave zones in the ring buffers; drain them first.
+    profiler.BeginFrame();
+    profiler.EndFrame();
+  }
+
+  Profiler& profiler = Profiler::Get();
+};
+
+TEST_F(ProfilerTest, NestedZonesRecordDepthInTheirFrame) {
+  profiler.BeginFrame();
+  {
+    PROFILE_SCOPE("Outer");
+    PROFILE_SCOPE("Inner");
+  }
+  profiler.EndFrame();
+
+  const auto& frame = profiler.GetFrames().back();
+  const auto* outer = findZone(frame, "Outer");
+  const auto* inner = findZone(frame, "Inner");
+  ASSERT_NE(outer, nullptr);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(outer->depth, 0);
+  EXPECT_EQ(inner->depth, 1);
+  EXPECT_EQ(outer->track, profiler.GetMainTrack());
+  EXPECT_LE(outer->startNs, inner->startNs);
+  EXPECT_GE(outer->endNs, inner->endNs);
+}
+
+TEST_F(ProfilerTest, WorkerThreadZonesGetTheirOwnTrack) {
+  std::thread worker([] {
+    Profiler::Get().SetThreadName("Profiler Test Worker");
+    PROFILE_SCOPE("WorkerZone");
+  });
+  worker.join();
+
+  profiler.BeginFrame();
+  profiler.EndFrame();
+
+  const auto* zone = findZone(profiler.GetFrames().back(), "WorkerZone");
+  ASSERT_NE(zone, nullptr);
+  EXPECT_NE(zone->track, profiler.GetMainTrack());
+  EXPECT_EQ(profiler.GetTrackName(zone->track), "Profiler Test Worker");
+}
+
+TEST_F(ProfilerTest, GpuZonesAttachToTheFrameThatIssuedThem) {
+  profiler.BeginFrame();
+  uint64_t frameIndex = profiler.GetFrameIndex();
+  profiler.EndFrame();
+  profiler.BeginFrame();
+  profiler.EndFrame();
+
+  uint64_t start = Profiler::NowNs();
+  profiler.SubmitGpuZone(frameIndex, "GpuPass", start, start + 1000, 0);
+
+  const auto& frames = profiler.GetFrames();
+  const auto& issuing = frames[frames.size() - 2];
+  ASSERT_EQ(issuing.index, frameIndex);
+  const auto* zone = findZone(issuing, "GpuPass");
+  ASSERT_NE(zone, nullptr);
+  EXPECT_EQ(zone->track, profiler.GetGpuTrack());
+  EXPECT_EQ(findZone(frames.back(), "GpuPass"), nullptr);
+}
+
+TEST_F(ProfilerTest, PausedHistoryIgnoresLateGpuZones) {
+  profiler.BeginFrame();
+  uint64_t frameIndex = profiler.GetFrameIndex();
+  profiler.EndFrame();
+
+  profiler.SetPaused(true);
+  uint64_t start = Profiler::NowNs();
+  profiler.SubmitGpuZone(frameIndex, "PausedGpuPass", start, start + 1000, 0);
+  profiler.SetPaused(false);
+
+  const auto& frame = profiler.GetFrames().back();
+  ASSERT_EQ(frame.index, frameIndex);
+  EXPECT_EQ(findZone(frame, "PausedGpuPass"), nullptr);
+}
+
+TEST_F(ProfilerTest, RecordingWritesChromeTrace) {
+  const std::string path = "profiler_test_trace.json";
+  profiler.StartRecording();
+  profiler.BeginFrame();
+  { PROFILE_SCOPE("TracedZone"); }
+  profiler.EndFrame();
+  ASSERT_TRUE(profiler.StopRecording(path));
+  EXPECT_FALSE(profiler.IsRecording());
+
+  std::ifstream file(path);
+  nlohmann::json trace = nlohmann::json::parse(file);
+  file.close();
+  std::remove(path.c_str());
+
+  bool foundZone = false, foundFrame = false, foundMainName = false;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "X" && event["name"] == "TracedZone") {
+      foundZone = true;
+      EXPECT_GE(event["dur"].get<double>(), 0.0);
+    }
+    if (event["ph"] == "X" && event["name"] == "Frame") foundFrame = true;
+    if (event["ph"] == "M" && event["tid"] == profiler.GetMainTrack()) {
+      foundMainName = true;
+    }
+  }
+  EXPECT_TRUE(foundZone);
+  EXPECT_TRUE(foundFrame);
+  EXPECT_TRUE(foundMainName);
+}
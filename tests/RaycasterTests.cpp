@@ -2,6 +2,8 @@
 #include "Sculpting/SculptableMesh.h" // Still include SculptableMesh
 #include "gtest/gtest.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <limits>
 
 TEST(RaycasterTest, HitTriangle) {
     glm::vec3 rayOrigin(0, 0, 5);
@@ -73,4 +75,87 @@ TEST(RaycasterTest, HitTranslatedTriangle) {
     ASSERT_TRUE(hit);
     EXPECT_NEAR(result.hitPoint.x, 0.0f, 1e-6);
     EXPECT_NEAR(result.hitPoint.y, 0.0f, 1e-6);
-}
\ No newline at end of file
+}
+
+// Builds a bumpy grid large enough that the BVH actually has interior nodes.
+static SculptableMesh MakeGridMesh(int resolution) {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    for (int y = 0; y <= resolution; ++y) {
+        for (int x = 0; x <= resolution; ++x) {
+            float fx = static_cast<float>(x) / resolution * 2.0f - 1.0f;
+            float fy = static_cast<float>(y) / resolution * 2.0f - 1.0f;
+            vertices.insert(vertices.end(), {fx, fy, 0.1f * std::sin(fx * 7.0f) * std::cos(fy * 5.0f)});
+        }
+    }
+    for (int y = 0; y < resolution; ++y) {
+        for (int x = 0; x < resolution; ++x) {
+            unsigned int i0 = y * (resolution + 1) + x;
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + resolution + 1;
+            unsigned int i3 = i2 + 1;
+            indices.insert(indices.end(), {i0, i1, i2, i1, i3, i2});
+        }
+    }
+    SculptableMesh mesh;
+    mesh.Initialize(vertices, indices);
+    return mesh;
+}
+
+// Reference result: test every triangle.
+static bool BruteForceIntersect(const glm::vec3& origin, const glm::vec3& dir, const SculptableMesh& mesh, float& outDistance, int& outTriangle) {
+    const auto& vertices = mesh.GetVertices();
+    const auto& indices = mesh.GetIndices();
+    outDistance = std::numeric_limits<float>::max();
+    outTriangle = -1;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        float t = 0.0f;
+        if (Raycaster::IntersectTriangle(origin, dir, vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], t) && t < outDistance) {
+            outDistance = t;
+            outTriangle = static_cast<int>(i / 3);
+        }
+    }
+    return outTriangle >= 0;
+}
+
+TEST(RaycasterTest, BVHMatchesBruteForce) {
+    SculptableMesh mesh = MakeGridMesh(32);
+    ASSERT_GT(mesh.GetBVH().GetNodes().size(), 1u);
+
+    for (int i = 0; i < 200; ++i) {
+        float fx = -1.2f + 2.4f * static_cast<float>(i % 20) / 19.0f;
+        float fy = -1.2f + 2.4f * static_cast<float>(i / 20) / 9.0f;
+        glm::vec3 origin(fx, fy, 3.0f);
+        glm::vec3 dir = glm::normalize(glm::vec3(0.05f * fy, -0.05f * fx, -1.0f));
+
+        float expectedDistance = 0.0f;
+        int expectedTriangle = -1;
+        bool expectedHit = BruteForceIntersect(origin, dir, mesh, expectedDistance, expectedTriangle);
+
+        Raycaster::RaycastResult result;
+        bool hit = Raycaster::IntersectMesh(origin, dir, mesh, glm::mat4(1.0f), result);
+
+        ASSERT_EQ(hit, expectedHit) << "Ray " << i;
+        if (hit) {
+            EXPECT_NEAR(result.distance, expectedDistance, 1e-5) << "Ray " << i;
+        }
+    }
+}
+
+TEST(RaycasterTest, BVHRefitsAfterVerticesMove) {
+    SculptableMesh mesh = MakeGridMesh(16);
+    glm::vec3 origin(0.01f, 0.01f, 5.0f);
+    glm::vec3 dir(0, 0, -1);
+
+    Raycaster::RaycastResult before;
+    ASSERT_TRUE(Raycaster::IntersectMesh(origin, dir, mesh, glm::mat4(1.0f), before));
+
+    // Lift the whole surface; a stale BVH would still report the old distance.
+    for (auto& v : mesh.GetVertices()) {
+        v.z += 1.0f;
+    }
+
+    Raycaster::RaycastResult after;
+    ASSERT_TRUE(Raycaster::IntersectMesh(origin, dir, mesh, glm::mat4(1.0f), after));
+    EXPECT_NEAR(after.distance, before.distance - 1.0f, 1e-5);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "Renderer/RenderQueue.h"
+
+namespace {
+
+// The queue only compares these by address.
+Shader* fakeShader(int n) { return reinterpret_cast<Shader*>(0x1000 * n); }
+const GpuMeshResources* fakeMesh(int n) {
+  return reinterpret_cast<const GpuMeshResources*>(0x100000 * n);
+}
+
+RenderItem makeItem(int shader, int mesh, float tag) {
+  RenderItem item;
+  item.shader = fakeShader(shader);
+  item.mesh = fakeMesh(mesh);
+  item.color = glm::vec4(tag);
+  return item;
+}
+
+}  // namespace
+
+TEST(RenderQueueTest, GroupsItemsByShaderAndMesh) {
+  RenderQueue queue;
+  queue.Submit(makeItem(1, 1, 0));
+  queue.Submit(makeItem(2, 1, 1));
+  queue.Submit(makeItem(1, 2, 2));
+  queue.Submit(makeItem(1, 1, 3));
+  queue.Submit(makeItem(1, 2, 4));
+
+  const auto& batches = queue.Sort();
+  ASSERT_EQ(batches.size(), 3u);
+  size_t covered = 0;
+  for (const auto& batch : batches) {
+    for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+      EXPECT_EQ(queue.GetItems()[i].shader, batch.shader);
+      EXPECT_EQ(queue.GetItems()[i].mesh, batch.mesh);
+    }
+    covered += batch.count;
+  }
+  EXPECT_EQ(covered, 5u);
+}
+
+TEST(RenderQueueTest, KeepsSubmissionOrderWithinABatch) {
+  RenderQueue queue;
+  for (int i = 0; i < 4; ++i) {
+    queue.Submit(makeItem(1, 1, static_cast<float>(i)));
+    queue.Submit(makeItem(1, 2, static_cast<float>(i)));
+  }
+
+  for (const auto& batch : queue.Sort()) {
+    ASSERT_EQ(batch.count, 4u);
+    for (size_t i = 0; i < batch.count; ++i) {
+      EXPECT_EQ(queue.GetItems()[batch.first + i].color.x, static_cast<float>(i));
+    }
+  }
+}
+
+TEST(RenderQueueTest, ClearEmptiesItemsAndBatches) {
+  RenderQueue queue;
+  queue.Submit(makeItem(1, 1, 0));
+  queue.Sort();
+  queue.Clear();
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_TRUE(queue.Sort().empty());
+}
@@ -40,10 +40,10 @@ TEST_F(RendererTest, SyncSceneObjects_CreatesGpuResourcesForNewObject) {
     // Assert: GPU resources should now exist for the new object
     ASSERT_EQ(renderer->GetGpuResources().count(objectId), 1);
     const auto& resources = renderer->GetGpuResources().at(objectId);
-    EXPECT_NE(resources.vao, 0);
-    EXPECT_NE(resources.vboPositions, 0);
-    EXPECT_NE(resources.ebo, 0);
-    EXPECT_GT(resources.indexCount, 0);
+    EXPECT_NE(resources->vao, 0);
+    EXPECT_NE(resources->vboPositions, 0);
+    EXPECT_NE(resources->ebo, 0);
+    EXPECT_GT(resources->indexCount, 0);
 }
 
 TEST_F(RendererTest, SyncSceneObjects_ReleasesGpuResourcesForDeletedObject) {
@@ -79,3 +79,24 @@ TEST_F(RendererTest, ClearAllGpuResources_EmptiesResourceMap) {
     // Assert: The map of GPU resources should be empty
     EXPECT_TRUE(renderer->GetGpuResources().empty());
 }
+
+TEST_F(RendererTest, SyncSceneObjects_IdenticalPrimitivesShareGpuBuffers) {
+    scene->AddObject(app.GetObjectFactory()->Create(std::string(ObjectTypes::Pyramid)));
+    scene->AddObject(app.GetObjectFactory()->Create(std::string(ObjectTypes::Pyramid)));
+    auto& objects = scene->GetSceneObjects();
+    ISceneObject* first = objects[objects.size() - 2].get();
+    ISceneObject* second = objects.back().get();
+    renderer->SyncSceneObjects(*scene);
+
+    auto& resources = renderer->GetGpuResources();
+    ASSERT_EQ(resources.count(first->id), 1);
+    ASSERT_EQ(resources.count(second->id), 1);
+    EXPECT_EQ(resources.at(first->id), resources.at(second->id));
+
+    // Editing one object gives it its own buffers and leaves the other alone.
+    GLuint sharedVao = resources.at(second->id)->vao;
+    first->GetEditableMesh();
+    renderer->SyncSceneObjects(*scene);
+    EXPECT_NE(resources.at(first->id), resources.at(second->id));
+    EXPECT_EQ(resources.at(second->id)->vao, sharedVao);
+}
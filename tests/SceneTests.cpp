@@ -2,9 +2,13 @@
 #include "Interfaces.h"
 #include "Scene/Objects/ObjectTypes.h"
 #include "Scene/Scene.h"
+#include "Scene/SceneBinaryFormat.h"
 #include "gtest/gtest.h"
 #include "Core/PropertyNames.h"
 #include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <utility>
 #include "Scene/Objects/Pyramid.h" 
 #include "Sculpting/SculptableMesh.h" // Include SculptableMesh for IEditableMesh
 #include "Core/SettingsManager.h" // Needed for default cloneOffset
@@ -109,6 +113,114 @@ TEST_F(SceneTest, DuplicateObject) {
     EXPECT_EQ(clone->name, "MyObject (1)"); 
 }
 
+TEST_F(SceneTest, DuplicateSharesMeshUntilEitherEdits) {
+    auto pyramid = std::make_unique<Pyramid>();
+    pyramid->GetPropertySet().SetValue<float>(PropertyNames::Width, 2.0f);
+    pyramid->GetEditableMesh()->GetVertices()[0] += glm::vec3(0.0f, 1.0f, 0.0f);
+    pyramid->isPristine = false;
+    scene->AddObject(std::move(pyramid));
+    scene->DuplicateObject(1);
+
+    ISceneObject* original = scene->GetObjectByID(1);
+    ISceneObject* clone = scene->GetObjectByID(2);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_FALSE(clone->isPristine);
+    EXPECT_EQ(clone->GetPropertySet().GetValue<float>(PropertyNames::Width), 2.0f);
+    // No copy yet: both objects read the same mesh.
+    EXPECT_EQ(clone->GetMesh(), original->GetMesh());
+
+    glm::vec3 sculpted = original->GetMesh()->GetVertices()[0];
+    clone->GetEditableMesh()->GetVertices()[0] += glm::vec3(1.0f, 0.0f, 0.0f);
+    EXPECT_NE(clone->GetMesh(), original->GetMesh());
+    EXPECT_EQ(original->GetMesh()->GetVertices()[0], sculpted);
+    EXPECT_EQ(clone->GetMesh()->GetVertices()[0], sculpted + glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST_F(SceneTest, DuplicateCopiesFlagsAndSourceCopiesBeforeWriting) {
+    auto pyramid = std::make_unique<Pyramid>();
+    pyramid->isPristine = false;
+    pyramid->isStatic = true;
+    pyramid->GetEditableMesh();  // Owns its mesh before it is duplicated
+    scene->AddObject(std::move(pyramid));
+    scene->DuplicateObject(1);
+
+    ISceneObject* original = scene->GetObjectByID(1);
+    ISceneObject* clone = scene->GetObjectByID(2);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_TRUE(clone->isStatic);
+    EXPECT_TRUE(clone->isSelectable);
+
+    // The source learns it shares its mesh, so its next write copies.
+    const glm::vec3 shared = clone->GetMesh()->GetVertices()[0];
+    original->GetEditableMesh()->GetVertices()[0] += glm::vec3(0.0f, 2.0f, 0.0f);
+    EXPECT_EQ(clone->GetMesh()->GetVertices()[0], shared);
+}
+
+TEST_F(SceneTest, DuplicateArrayOffsetsAndNamesEachCopy) {
+    auto pyramid = factory.Create(std::string(ObjectTypes::Pyramid));
+    pyramid->name = "Post";
+    scene->AddObject(std::move(pyramid));
+    scene->DuplicateObject(1, 3);
+
+    ASSERT_EQ(scene->GetSceneObjects().size(), 4);
+    const glm::vec3 offset = SettingsManager::Get().cloneOffset;
+    for (uint32_t id = 2; id <= 4; ++id) {
+        ISceneObject* copy = scene->GetObjectByID(id);
+        ASSERT_NE(copy, nullptr);
+        EXPECT_EQ(copy->name, "Post (" + std::to_string(id - 1) + ")");
+        EXPECT_EQ(copy->GetPosition(), offset * static_cast<float>(id - 1));
+    }
+}
+
+TEST_F(SceneTest, HandlesGoStaleWhenTheirObjectIsRemoved) {
+    for (int i = 0; i < 3; ++i) {
+        scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid) + "_Mock"));
+    }
+    ObjectHandle first = scene->GetHandle(1);
+    ASSERT_EQ(scene->Resolve(first), scene->GetObjectByID(1));
+    scene->SetSelectedObjectByID(3);
+
+    scene->QueueForDeletion(1);
+    scene->QueueForDeletion(1);
+    scene->ProcessDeferredDeletions();
+    EXPECT_EQ(scene->Resolve(first), nullptr);
+    EXPECT_EQ(scene->GetObjectByID(1), nullptr);
+    // Removing an earlier object keeps the selection on the same object.
+    ASSERT_NE(scene->GetSelectedObject(), nullptr);
+    EXPECT_EQ(scene->GetSelectedObject()->id, 3);
+
+    // The freed slot is reused, but the old handle does not see the newcomer.
+    scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid) + "_Mock"));
+    EXPECT_EQ(scene->Resolve(first), nullptr);
+    EXPECT_EQ(scene->GetHandle(4).slot, first.slot);
+    EXPECT_EQ(scene->GetObjectByID(2)->id, 2);
+    EXPECT_EQ(scene->GetSceneObjects().front()->id, 2);
+}
+
+TEST_F(SceneTest, ChangeLogReportsAdditionsAndRemovalsSinceCursor) {
+    uint64_t cursor = 0;
+    // A cursor that never read from this scene has to resynchronize.
+    EXPECT_FALSE(scene->ConsumeChanges(cursor, [](const SceneChange&) {}));
+
+    std::vector<std::pair<SceneChange::Kind, uint32_t>> seen;
+    auto record = [&seen](const SceneChange& change) {
+        seen.emplace_back(change.kind, change.id);
+    };
+    scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid) + "_Mock"));
+    scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid) + "_Mock"));
+    scene->QueueForDeletion(1);
+    scene->ProcessDeferredDeletions();
+    EXPECT_TRUE(scene->ConsumeChanges(cursor, record));
+    using Kind = SceneChange::Kind;
+    std::vector<std::pair<Kind, uint32_t>> expected = {
+        {Kind::Added, 1}, {Kind::Added, 2}, {Kind::Removed, 1}};
+    EXPECT_EQ(seen, expected);
+
+    seen.clear();
+    EXPECT_TRUE(scene->ConsumeChanges(cursor, record));
+    EXPECT_TRUE(seen.empty());
+}
+
 TEST_F(SceneTest, SaveAndLoad) {
     const char* tempFilename = "temporary_scene_for_save_test.json";
     scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid) + "_Mock"));
@@ -164,6 +276,87 @@ TEST_F(SceneTest, SaveAndLoadMaintainsUniqueProperties) {
 }
 
 
+TEST_F(SceneTest, SaveAndLoadBinaryKeepsSculptedMesh) {
+    const char* binaryFilename = "binary_scene_test.imscene";
+    const char* renamedFilename = "binary_scene_test_renamed.json";
+
+    auto pyramid = factory.Create(std::string(ObjectTypes::Pyramid));
+    pyramid->name = "Sculpted";
+    pyramid->SetPosition({1.0f, 2.0f, 3.0f});
+    IEditableMesh* mesh = pyramid->GetEditableMesh();
+    ASSERT_NE(mesh, nullptr);
+    mesh->GetVertices()[0] += glm::vec3(0.25f, -0.5f, 0.125f);
+    mesh->RecalculateNormals();
+    const std::vector<glm::vec3> sculptedVertices = mesh->GetVertices();
+    const std::vector<unsigned int> sculptedIndices = mesh->GetIndices();
+    scene->AddObject(std::move(pyramid));
+
+    scene->Save(binaryFilename);
+    // The format is detected from the header, not the extension.
+    std::remove(renamedFilename);
+    ASSERT_EQ(std::rename(binaryFilename, renamedFilename), 0);
+
+    Scene loadScene(&factory);
+    loadScene.Load(renamedFilename);
+
+    ASSERT_EQ(loadScene.GetSceneObjects().size(), 1);
+    ISceneObject* loadedObject = loadScene.GetObjectByID(1);
+    ASSERT_NE(loadedObject, nullptr);
+    EXPECT_EQ(loadedObject->name, "Sculpted");
+    EXPECT_EQ(loadedObject->GetPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    IEditableMesh* loadedMesh = loadedObject->GetEditableMesh();
+    ASSERT_NE(loadedMesh, nullptr);
+    EXPECT_EQ(std::as_const(*loadedMesh).GetVertices(), sculptedVertices);
+    EXPECT_EQ(std::as_const(*loadedMesh).GetIndices(), sculptedIndices);
+    EXPECT_EQ(std::as_const(*loadedMesh).GetNormals().size(), sculptedVertices.size());
+    EXPECT_TRUE(loadedObject->IsMeshDirty());
+
+    std::remove(renamedFilename);
+}
+
+TEST_F(SceneTest, LoadTruncatedBinarySceneIsRejected) {
+    const char* tempFilename = "truncated_scene_test.imscene";
+    scene->AddObject(factory.Create(std::string(ObjectTypes::Pyramid)));
+    scene->Save(tempFilename);
+
+    // Keep the header but cut the document off.
+    {
+        std::ifstream in(tempFilename, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(tempFilename, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+
+    Scene loadScene(&factory);
+    EXPECT_NO_THROW(loadScene.Load(tempFilename));
+    EXPECT_TRUE(loadScene.GetSceneObjects().empty());
+    std::remove(tempFilename);
+}
+
+TEST_F(SceneTest, LoadBinarySceneWithMalformedBlockRecordSkipsTheMesh) {
+    const char* tempFilename = "malformed_blocks_test.imscene";
+    {
+        SceneBinaryFormat::Writer writer;
+        ASSERT_TRUE(writer.Open(tempFilename));
+        nlohmann::json object = {{"type", std::string(ObjectTypes::Pyramid)}, {"id", 1}};
+        object["sculpt_blocks"] = {{"vertices", {{"offset", -64}, {"count", "lots"}}},
+                                   {"indices", {{"offset", 64}, {"count", 3}}}};
+        ASSERT_TRUE(writer.Finish({{"next_object_id", 2}, {"objects", {object}}}));
+    }
+
+    Scene loadScene(&factory);
+    EXPECT_NO_THROW(loadScene.Load(tempFilename));
+    ASSERT_EQ(loadScene.GetSceneObjects().size(), 1);
+    // The object keeps the mesh generated from its properties.
+    auto pyramid = factory.Create(std::string(ObjectTypes::Pyramid));
+    IEditableMesh* loadedMesh = loadScene.GetSceneObjects()[0]->GetEditableMesh();
+    ASSERT_NE(loadedMesh, nullptr);
+    EXPECT_EQ(std::as_const(*loadedMesh).GetIndices(),
+              std::as_const(*pyramid->GetEditableMesh()).GetIndices());
+    std::remove(tempFilename);
+}
+
 // --- Negative and Edge Case Tests ---
 
 TEST_F(SceneTest, GetNonExistentObject) {
@@ -2,10 +2,14 @@
 #include "Sculpting/Tools/PushPullTool.h"
 #include "Sculpting/Tools/SmoothTool.h"
 #include "Sculpting/Tools/GrabTool.h"
+#include "Sculpting/MeshConnectivity.h"
 #include "Sculpting/SculptableMesh.h"
 #include "Core/UI/BrushSettings.h"
 #include "Core/Camera.h" // For glm::lookAt, glm::ortho
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 
 class SculptingTest : public ::testing::Test {
@@ -369,4 +373,356 @@ TEST_F(SculptingTest, SculptableMesh_WeldVertices_MultipleVertices) {
     EXPECT_EQ(mesh.GetIndices()[5], 3); // Was 3
 
     // The mesh should now be degenerate or have collapsed faces, but the indices are correctly remapped.
-}
\ No newline at end of file
+}
+
+TEST_F(SculptingTest, SculptableMesh_QueryVerticesInSphereTracksMovedVertices) {
+    // A 21x21 grid of vertices spaced 0.1 apart on the XY plane.
+    std::vector<float> gridVertices;
+    for (int y = 0; y <= 20; ++y) {
+        for (int x = 0; x <= 20; ++x) {
+            gridVertices.insert(gridVertices.end(), {x * 0.1f - 1.0f, y * 0.1f - 1.0f, 0.0f});
+        }
+    }
+    mesh.Initialize(gridVertices, {});
+
+    auto bruteForce = [&](const glm::vec3& center, float radius) {
+        std::vector<uint32_t> result;
+        const auto& verts = mesh.GetVertices();
+        for (uint32_t i = 0; i < verts.size(); ++i) {
+            if (glm::distance(center, verts[i]) < radius) result.push_back(i);
+        }
+        return result;
+    };
+
+    std::vector<uint32_t> found;
+    mesh.QueryVerticesInSphere(glm::vec3(0.0f), 0.25f, found);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, bruteForce(glm::vec3(0.0f), 0.25f));
+
+    // Move the queried vertices far away and report them; they must leave the
+    // old neighbourhood and show up in the new one.
+    auto& verts = mesh.GetVertices();
+    for (uint32_t i : found) verts[i] += glm::vec3(5.0f, 0.0f, 0.0f);
+    mesh.MarkVerticesDirty(found);
+
+    std::vector<uint32_t> afterMove;
+    mesh.QueryVerticesInSphere(glm::vec3(0.0f), 0.25f, afterMove);
+    EXPECT_TRUE(afterMove.empty());
+
+    mesh.QueryVerticesInSphere(glm::vec3(5.0f, 0.0f, 0.0f), 0.25f, afterMove);
+    std::sort(afterMove.begin(), afterMove.end());
+    EXPECT_EQ(afterMove, found);
+}
+
+TEST_F(SculptingTest, SculptableMesh_DirtyNormalsMatchFullRecalculation) {
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    const int n = 16;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            gridVertices.insert(gridVertices.end(), {x * 0.1f - 0.8f, y * 0.1f - 0.8f, 0.0f});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    mesh.Initialize(gridVertices, gridIndices);
+
+    settings.mode = SculptMode::Pull;
+    settings.radius = 0.35f;
+    pushPullTool.Apply(mesh, glm::vec3(0.1f, 0.0f, 0.0f), dummyRayDirection, dummyMouseDelta, settings, dummyMatrix, dummyMatrix, viewportWidth, viewportHeight);
+    mesh.RecalculateDirtyNormals();
+    std::vector<glm::vec3> regionNormals = mesh.GetNormals();
+
+    SculptableMesh reference = mesh;
+    reference.RecalculateNormals();
+    const auto& fullNormals = reference.GetNormals();
+
+    ASSERT_EQ(regionNormals.size(), fullNormals.size());
+    for (size_t i = 0; i < fullNormals.size(); ++i) {
+        EXPECT_NEAR(regionNormals[i].x, fullNormals[i].x, 1e-5) << "Vertex " << i;
+        EXPECT_NEAR(regionNormals[i].y, fullNormals[i].y, 1e-5) << "Vertex " << i;
+        EXPECT_NEAR(regionNormals[i].z, fullNormals[i].z, 1e-5) << "Vertex " << i;
+    }
+}
+
+TEST_F(SculptingTest, SculptableMesh_GpuDeltaTracksDirtyRange) {
+    // A strip of four quads: bottom row is vertices 0-4, top row 5-9.
+    std::vector<float> stripVertices;
+    for (int row = 0; row < 2; ++row) {
+        for (int x = 0; x < 5; ++x) stripVertices.insert(stripVertices.end(), {float(x), float(row), 0.0f});
+    }
+    std::vector<unsigned int> stripIndices;
+    for (unsigned int x = 0; x < 4; ++x) {
+        stripIndices.insert(stripIndices.end(), {x, x + 1, x + 5, x + 1, x + 6, x + 5});
+    }
+    mesh.Initialize(stripVertices, stripIndices);
+
+    MeshGpuDelta initial = mesh.ConsumeGpuDelta();
+    EXPECT_TRUE(initial.topologyChanged);
+    EXPECT_EQ(initial.vertexEnd, 10u);
+
+    MeshGpuDelta nothing = mesh.ConsumeGpuDelta();
+    EXPECT_FALSE(nothing.topologyChanged);
+    EXPECT_FALSE(nothing.HasVertexChanges());
+
+    // Move the last top vertex; only its one-ring (4, 8, 9) needs uploading.
+    mesh.GetVertices()[9].z += 0.5f;
+    mesh.MarkVerticesDirty({9});
+    mesh.RecalculateDirtyNormals();
+
+    MeshGpuDelta partial = mesh.ConsumeGpuDelta();
+    EXPECT_FALSE(partial.topologyChanged);
+    EXPECT_EQ(partial.vertexBegin, 4u);
+    EXPECT_EQ(partial.vertexEnd, 10u);
+
+    std::unordered_set<uint32_t> faces = {0};
+    mesh.ExtrudeFaces(faces, 0.5f);
+    EXPECT_TRUE(mesh.ConsumeGpuDelta().topologyChanged);
+}
+
+TEST_F(SculptingTest, SculptableMesh_ParallelNormalsMatchSerialScatter) {
+    // Large enough that both normal passes are split across worker threads.
+    const int n = 120;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            float fx = x * 0.05f, fy = y * 0.05f;
+            gridVertices.insert(gridVertices.end(), {fx, fy, 0.2f * std::sin(fx * 3.0f) * std::cos(fy * 2.0f)});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    mesh.Initialize(gridVertices, gridIndices);
+
+    const auto& verts = mesh.GetVertices();
+    std::vector<glm::vec3> expected(verts.size(), glm::vec3(0.0f));
+    for (size_t i = 0; i < gridIndices.size(); i += 3) {
+        glm::vec3 faceNormal = glm::cross(verts[gridIndices[i + 1]] - verts[gridIndices[i]], verts[gridIndices[i + 2]] - verts[gridIndices[i]]);
+        for (int k = 0; k < 3; ++k) expected[gridIndices[i + k]] += faceNormal;
+    }
+
+    const auto& normals = mesh.GetNormals();
+    for (size_t i = 0; i < expected.size(); ++i) {
+        glm::vec3 e = glm::normalize(expected[i]);
+        ASSERT_NEAR(glm::dot(e, normals[i]), 1.0f, 1e-5) << "Vertex " << i;
+    }
+}
+
+TEST_F(SculptingTest, SculptableMesh_PositionsSoAFollowsEdits) {
+    auto expectInSync = [this]() {
+        const SculptableMesh& constMesh = mesh;
+        const VertexSoA& soa = constMesh.GetPositionsSoA();
+        const auto& verts = constMesh.GetVertices();
+        ASSERT_EQ(soa.Size(), verts.size());
+        for (size_t i = 0; i < verts.size(); ++i) {
+            EXPECT_EQ(glm::vec3(soa.x[i], soa.y[i], soa.z[i]), verts[i]) << "Vertex " << i;
+        }
+    };
+
+    expectInSync();
+
+    // Reported brush edits patch the copy in place.
+    settings.mode = SculptMode::Pull;
+    pushPullTool.Apply(mesh, glm::vec3(0.0f), dummyRayDirection, dummyMouseDelta, settings, dummyMatrix, dummyMatrix, viewportWidth, viewportHeight);
+    expectInSync();
+
+    // A weld moves a vertex without reporting it, so a later dab elsewhere must
+    // not leave the welded position behind.
+    std::unordered_set<uint32_t> verticesToWeld = {0, 1};
+    ASSERT_TRUE(mesh.WeldVertices(verticesToWeld, glm::vec3(-1.0f, 0.0f, 0.0f)));
+    settings.radius = 0.5f;
+    pushPullTool.Apply(mesh, glm::vec3(1.0f, -1.0f, 0.0f), dummyRayDirection, dummyMouseDelta, settings, dummyMatrix, dummyMatrix, viewportWidth, viewportHeight);
+    expectInSync();
+}
+
+TEST_F(SculptingTest, SculptableMesh_VertexAdjacencyListsEdgeNeighbors) {
+    // Quad split along 0-2: vertices 0 and 2 see everything, 1 and 3 do not
+    // see each other.
+    const VertexAdjacency& adjacency = std::as_const(mesh).GetVertexAdjacency();
+    ASSERT_EQ(adjacency.offsets.size(), 5u);
+    auto neighborsOf = [&](uint32_t v) {
+        return std::vector<uint32_t>(adjacency.neighbors.begin() + adjacency.offsets[v],
+                                     adjacency.neighbors.begin() + adjacency.offsets[v + 1]);
+    };
+    EXPECT_EQ(neighborsOf(0), (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_EQ(neighborsOf(1), (std::vector<uint32_t>{0, 2}));
+    EXPECT_EQ(neighborsOf(2), (std::vector<uint32_t>{0, 1, 3}));
+    EXPECT_EQ(neighborsOf(3), (std::vector<uint32_t>{0, 2}));
+
+    // Welding rewrites the indices, so the adjacency is rebuilt.
+    ASSERT_TRUE(mesh.WeldVertices({1, 2}, glm::vec3(0.0f, -1.0f, 0.0f)));
+    const VertexAdjacency& welded = std::as_const(mesh).GetVertexAdjacency();
+    EXPECT_EQ(neighborsOf(0), (std::vector<uint32_t>{1, 3}));
+    EXPECT_EQ(welded.offsets[3] - welded.offsets[2], 0u);
+}
+
+namespace {
+
+// Every live edge as (v0, v1, sorted faces), independent of edge IDs.
+std::vector<std::vector<uint32_t>> describeEdges(const MeshConnectivity& connectivity) {
+    std::vector<std::vector<uint32_t>> edges;
+    for (uint32_t e = 0; e < connectivity.GetEdgeSlotCount(); ++e) {
+        if (!connectivity.IsEdgeLive(e)) continue;
+        std::vector<uint32_t> faces;
+        connectivity.ForEachEdgeFace(e, [&](uint32_t face) { faces.push_back(face); });
+        std::sort(faces.begin(), faces.end());
+        std::vector<uint32_t> entry = {connectivity.GetEdge(e).v0, connectivity.GetEdge(e).v1};
+        entry.insert(entry.end(), faces.begin(), faces.end());
+        edges.push_back(entry);
+    }
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+}  // namespace
+
+TEST_F(SculptingTest, SculptableMesh_ConnectivityLinksEdgesAndFaces) {
+    const MeshConnectivity& connectivity = std::as_const(mesh).GetConnectivity();
+    EXPECT_EQ(connectivity.GetEdgeCount(), 5u);
+    EXPECT_EQ(connectivity.FindEdge(1, 3), MeshConnectivity::kInvalid);
+
+    // The diagonal is shared by both triangles; the rim edges are boundary.
+    uint32_t diagonal = connectivity.FindEdge(2, 0);
+    ASSERT_NE(diagonal, MeshConnectivity::kInvalid);
+    std::vector<uint32_t> faces;
+    connectivity.ForEachEdgeFace(diagonal, [&](uint32_t face) { faces.push_back(face); });
+    std::sort(faces.begin(), faces.end());
+    EXPECT_EQ(faces, (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(connectivity.GetFaceEdge(0, 2), diagonal);  // Corner 2 -> corner 0
+    std::vector<uint32_t> ring;
+    connectivity.ForEachVertexNeighbor(1, [&](uint32_t v, uint32_t) { ring.push_back(v); });
+    std::sort(ring.begin(), ring.end());
+    EXPECT_EQ(ring, (std::vector<uint32_t>{0, 2}));
+}
+
+TEST_F(SculptingTest, SculptableMesh_ConnectivityPatchMatchesRebuild) {
+    auto expectMatchesRebuild = [this]() {
+        MeshConnectivity rebuilt;
+        rebuilt.Build(std::as_const(mesh).GetIndices(), std::as_const(mesh).GetVertices().size());
+        EXPECT_EQ(describeEdges(std::as_const(mesh).GetConnectivity()), describeEdges(rebuilt));
+    };
+
+    // Large enough that small edits are patched rather than rebuilt.
+    const int n = 10;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            gridVertices.insert(gridVertices.end(), {x * 0.1f, y * 0.1f, 0.0f});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    mesh.Initialize(gridVertices, gridIndices);
+    const uint32_t edgesBefore = static_cast<uint32_t>(std::as_const(mesh).GetConnectivity().GetEdgeCount());
+
+    ASSERT_TRUE(mesh.ExtrudeFaces({50}, 0.5f));
+    expectMatchesRebuild();
+    EXPECT_GT(std::as_const(mesh).GetConnectivity().GetEdgeCount(), edgesBefore);
+    ASSERT_TRUE(mesh.BevelEdges({{0, 1}}, 0.1f));
+    expectMatchesRebuild();
+    // Collapses a side of the triangles on edge 12-13, dropping that edge.
+    ASSERT_TRUE(mesh.WeldVertices({12, 13}, glm::vec3(0.15f, 0.1f, 0.0f)));
+    expectMatchesRebuild();
+    EXPECT_EQ(std::as_const(mesh).GetConnectivity().FindEdge(12, 13), MeshConnectivity::kInvalid);
+}
+
+TEST_F(SculptingTest, SmoothToolFlattensBumpOnlyInsideBrush) {
+    const int n = 20;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            gridVertices.insert(gridVertices.end(), {x * 0.1f, y * 0.1f, 0.0f});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    const uint32_t center = 10 * (n + 1) + 10;
+    gridVertices[center * 3 + 2] = 0.5f;
+    mesh.Initialize(gridVertices, gridIndices);
+    const std::vector<glm::vec3> before = std::as_const(mesh).GetVertices();
+
+    settings.radius = 0.25f;
+    settings.strength = 1.0f;
+    for (bool preserveVolume : {false, true}) {
+        mesh.Initialize(gridVertices, gridIndices);
+        settings.preserveVolume = preserveVolume;
+        smoothTool.Apply(mesh, before[center], dummyRayDirection, dummyMouseDelta, settings, dummyMatrix, dummyMatrix, viewportWidth, viewportHeight);
+
+        const auto& after = std::as_const(mesh).GetVertices();
+        EXPECT_LT(after[center].z, 0.5f);
+        for (size_t i = 0; i < after.size(); ++i) {
+            if (glm::distance(before[i], before[center]) >= settings.radius) {
+                ASSERT_EQ(after[i], before[i]) << "Vertex " << i << " is outside the brush";
+            }
+        }
+    }
+}
+
+TEST_F(SculptingTest, SmoothToolReducesNoiseOverManyDabs) {
+    const int n = 20;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            // Three-colouring of the grid: the umbrella operator's k = 1.5
+            // mode, high-frequency noise an unstable filter amplifies.
+            float noise = (x + 2 * y) % 3 == 0 ? 0.01f : -0.005f;
+            gridVertices.insert(gridVertices.end(), {x * 0.1f, y * 0.1f, noise});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    const glm::vec3 brushCenter(1.0f, 1.0f, 0.0f);
+    settings.radius = 0.6f;
+    settings.strength = 1.0f;
+    // Full weight across the brush, so the filter response is not diluted.
+    settings.falloff = Curve();
+    settings.falloff.AddPoint({0.0f, 1.0f});
+    settings.falloff.AddPoint({1.0f, 1.0f});
+
+    auto noiseInsideBrush = [&]() {
+        const auto& vertices = std::as_const(mesh).GetVertices();
+        float sum = 0.0f;
+        int count = 0;
+        for (const glm::vec3& v : vertices) {
+            if (glm::distance(glm::vec2(v), glm::vec2(brushCenter)) < 0.3f) {
+                sum += v.z * v.z;
+                ++count;
+            }
+        }
+        return std::sqrt(sum / count);
+    };
+
+    for (bool preserveVolume : {false, true}) {
+        mesh.Initialize(gridVertices, gridIndices);
+        settings.preserveVolume = preserveVolume;
+        const float before = noiseInsideBrush();
+        for (int dab = 0; dab < 10; ++dab) {
+            smoothTool.Apply(mesh, brushCenter, dummyRayDirection, dummyMouseDelta, settings, dummyMatrix, dummyMatrix, viewportWidth, viewportHeight);
+        }
+        EXPECT_LT(noiseInsideBrush(), before * 0.5f) << "preserveVolume " << preserveVolume;
+    }
+}
@@ -1,8 +1,14 @@
 #include "gtest/gtest.h"
 #include "Sculpting/SubObjectSelection.h"
 #include "Sculpting/SculptableMesh.h"
+#include "Sculpting/MeshPathFinder.h"
+#include "Sculpting/ScreenProjectionGrid.h"
 #include "Core/MathHelpers.h"
+#include "Core/Application.h"
+#include "Core/Camera.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 
 class SelectionTest : public ::testing::Test {
 protected:
@@ -79,3 +85,213 @@ TEST_F(SelectionTest, FindClosestVertex_SelectsWithTransform) {
     // Assert: The correct vertex (index 2) should be found
     EXPECT_EQ(closestIndex, 2);
 }
+
+TEST(MeshPathFinderTest, MetricPicksFewestEdgesOrShortestLength) {
+    // A tall apex (2) joins start (0) and goal (1) in two long edges; a low
+    // chain through 3 and 4 takes three short ones.
+    SculptableMesh fan;
+    fan.Initialize({0.0f, 0.0f, 0.0f,  3.0f, 0.0f, 0.0f,  1.5f, 5.0f, 0.0f,
+                    1.0f, -0.2f, 0.0f, 2.0f, -0.2f, 0.0f},
+                   {0, 3, 2, 3, 4, 2, 4, 1, 2});
+    MeshPathFinder finder;
+    std::vector<uint32_t> path;
+
+    ASSERT_TRUE(finder.FindPath(fan, 0, 1, PathMetric::EdgeCount, path));
+    EXPECT_EQ(path, (std::vector<uint32_t>{0, 2, 1}));
+    ASSERT_TRUE(finder.FindPath(fan, 0, 1, PathMetric::EdgeLength, path));
+    EXPECT_EQ(path, (std::vector<uint32_t>{0, 3, 4, 1}));
+
+    // Path edges come back from the end vertex to the start vertex.
+    SubObjectSelection selection;
+    auto edges = selection.FindShortestPath_ForTests(fan, 0, 1);
+    EXPECT_EQ(edges, (std::vector<std::pair<uint32_t, uint32_t>>{{1, 4}, {4, 3}, {3, 0}}));
+}
+
+TEST(MeshPathFinderTest, HeuristicKeepsSearchNearTheStraightLine) {
+    const int n = 50;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            gridVertices.insert(gridVertices.end(), {x * 0.1f, y * 0.1f, 0.0f});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    SculptableMesh grid;
+    grid.Initialize(gridVertices, gridIndices);
+
+    MeshPathFinder finder;
+    std::vector<uint32_t> path;
+    const uint32_t row = 25 * (n + 1);
+    ASSERT_TRUE(finder.FindPath(grid, row, row + n, PathMetric::EdgeLength, path));
+    EXPECT_EQ(path.size(), static_cast<size_t>(n + 1));
+    EXPECT_LT(finder.GetLastExpandedCount(), gridVertices.size() / 3 / 10);
+
+    // Reused state from the previous search must not leak into the next one.
+    ASSERT_TRUE(finder.FindPath(grid, row + n, row, PathMetric::EdgeLength, path));
+    EXPECT_EQ(path.front(), row + n);
+    EXPECT_EQ(path.back(), row);
+    EXPECT_FALSE(finder.FindPath(grid, 0, static_cast<uint32_t>(gridVertices.size()), PathMetric::EdgeLength, path));
+}
+
+TEST_F(SelectionTest, ScreenProjectionIsReusedUntilViewOrMeshChanges) {
+    ScreenProjectionGrid grid;
+    ScreenProjectionGrid::View view = {glm::mat4(1.0f), projMatrix * viewMatrix, cameraFwd, viewportWidth, viewportHeight, true};
+    const glm::vec2 top = MathHelpers::WorldToScreen(mesh.GetVertices()[0], projMatrix * viewMatrix, viewportWidth, viewportHeight);
+
+    grid.Update(mesh, view);
+    EXPECT_EQ(grid.FindClosestVertex(top, 10.0f), 0);
+    grid.Update(mesh, view);
+    EXPECT_EQ(grid.GetProjectionCount(), 1u);
+
+    view.modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(2.0f, 0.0f, 0.0f));
+    grid.Update(mesh, view);
+    EXPECT_EQ(grid.GetProjectionCount(), 2u);
+    EXPECT_EQ(grid.FindClosestVertex(top, 10.0f), -1);
+
+    // Moving a vertex changes the mesh revision.
+    mesh.GetVertices()[1] = glm::vec3(-2.0f, 1.0f, 0.0f);
+    grid.Update(mesh, view);
+    EXPECT_EQ(grid.GetProjectionCount(), 3u);
+    EXPECT_EQ(grid.FindClosestVertex(top, 10.0f), 1);
+}
+
+TEST_F(SelectionTest, ScreenProjectionMissesAnotherMeshAtTheSameAddress) {
+    ScreenProjectionGrid grid;
+    ScreenProjectionGrid::View view = {glm::mat4(1.0f), projMatrix * viewMatrix, cameraFwd, viewportWidth, viewportHeight, true};
+    grid.Update(mesh, view);
+
+    // Built by the same steps, so a per-mesh counter would land on the same
+    // revision; this is what a new object reusing a deleted one's memory sees.
+    SculptableMesh other;
+    other.Initialize({0.0f, -1.0f, 0.0f, 1.0f, 1.0f, 0.0f, -1.0f, 1.0f, 0.0f}, {0, 1, 2});
+    other.RecalculateNormals();
+    mesh = other;
+    grid.Update(mesh, view);
+    EXPECT_EQ(grid.GetProjectionCount(), 2u);
+    const glm::vec2 bottom = MathHelpers::WorldToScreen(glm::vec3(0.0f, -1.0f, 0.0f), projMatrix * viewMatrix, viewportWidth, viewportHeight);
+    EXPECT_EQ(grid.FindClosestVertex(bottom, 10.0f), 0);
+}
+
+TEST(SubObjectSelectionTest, DeselectingBridgesOnlyBetweenPathSegments) {
+    // Quad 0-3 on the left, a separate triangle 4-6 on the right: no path
+    // joins the two, so shift-picks across them leave their segments empty.
+    SculptableMesh pieces;
+    pieces.Initialize({-3.0f, -1.0f, 0.0f,  -1.0f, -1.0f, 0.0f,  -3.0f, 1.0f, 0.0f,  -1.0f, 1.0f, 0.0f,
+                        1.0f, -1.0f, 0.0f,   3.0f, -1.0f, 0.0f,   2.0f, 1.0f, 0.0f},
+                      {0, 1, 3,  0, 3, 2,  4, 5, 6});
+    pieces.RecalculateNormals();
+
+    Camera camera(Application::Get().GetWindow(), glm::vec3(0.0f, 0.0f, 10.0f));
+    camera.SetPitch(0.0f);
+    camera.SetAspectRatio(800.0f / 600.0f);
+    const glm::mat4 viewProj = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+    SubObjectSelection selection;
+    auto click = [&](uint32_t vertex, bool shift) {
+        const glm::vec2 screen = MathHelpers::WorldToScreen(pieces.GetVertices()[vertex], viewProj, 800, 600);
+        selection.OnMouseDown(pieces, camera, glm::mat4(1.0f), screen, 800, 600, shift, SubObjectMode::VERTEX);
+    };
+
+    click(0, false);
+    click(4, true);
+    click(3, true);
+    ASSERT_EQ(selection.GetSelectedVertices().size(), 3u);
+    ASSERT_TRUE(selection.GetHighlightedPath().empty());
+    click(4, true);  // Deselect the middle one
+    EXPECT_EQ(selection.GetSelectedVertices(), (std::unordered_set<uint32_t>{0, 3}));
+    EXPECT_TRUE(selection.GetHighlightedPath().empty());
+
+    // Between two path segments the gap is bridged.
+    click(0, false);
+    click(1, true);
+    click(3, true);
+    ASSERT_EQ(selection.GetHighlightedPath().size(), 2u);
+    click(1, true);
+    ASSERT_EQ(selection.GetHighlightedPath().size(), 1u);
+    const auto [from, to] = selection.GetHighlightedPath()[0];
+    EXPECT_EQ(std::min(from, to), 0u);
+    EXPECT_EQ(std::max(from, to), 3u);
+}
+
+TEST(ScreenProjectionGridTest, MatchesBruteForcePicking) {
+    // A bumpy grid seen at an angle, so vertices spread over many cells and
+    // some face away from the camera.
+    const int n = 40;
+    std::vector<float> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            float height = 0.3f * std::sin(x * 0.7f) * std::cos(y * 0.5f);
+            gridVertices.insert(gridVertices.end(), {x * 0.1f - 2.0f, y * 0.1f - 2.0f, height});
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int i0 = y * (n + 1) + x;
+            gridIndices.insert(gridIndices.end(), {i0, i0 + 1, i0 + n + 1, i0 + 1, i0 + n + 2, i0 + n + 1});
+        }
+    }
+    SculptableMesh dense;
+    dense.Initialize(gridVertices, gridIndices);
+    const int width = 640, height = 480;
+    const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), 640.0f / 480.0f, 0.1f, 100.0f) *
+                               glm::lookAt(glm::vec3(0.5f, -3.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0, 0, 1));
+    const glm::vec3 forward = glm::normalize(glm::vec3(-0.5f, 3.0f, -3.0f));
+    const auto& vertices = dense.GetVertices();
+    const auto& normals = dense.GetNormals();
+
+    ScreenProjectionGrid grid;
+    grid.Update(dense, {glm::mat4(1.0f), viewProj, forward, width, height, true});
+    auto facing = [&](const glm::vec3& normal) { return glm::dot(glm::normalize(normal), -forward) >= 0.1f; };
+    int vertexHits = 0, edgeHits = 0;
+    for (int py = 0; py < height; py += 23) {
+        for (int px = 0; px < width; px += 29) {
+            const glm::vec2 mouse(px, py);
+            int expectedVertex = -1;
+            float best = 15.0f * 15.0f;
+            float bestEdge = 10.0f;
+            std::pair<int, int> expectedEdge = {-1, -1};
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                if (!facing(normals[i])) continue;
+                glm::vec2 screen = MathHelpers::WorldToScreen(vertices[i], viewProj, width, height);
+                float distanceSq = glm::dot(screen - mouse, screen - mouse);
+                if (distanceSq < best) {
+                    best = distanceSq;
+                    expectedVertex = static_cast<int>(i);
+                }
+            }
+            for (size_t t = 0; t < gridIndices.size(); t += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t a = std::min(gridIndices[t + k], gridIndices[t + (k + 1) % 3]);
+                    uint32_t b = std::max(gridIndices[t + k], gridIndices[t + (k + 1) % 3]);
+                    if (!facing(normals[a] + normals[b])) continue;
+                    glm::vec2 sa = MathHelpers::WorldToScreen(vertices[a], viewProj, width, height);
+                    glm::vec2 sb = MathHelpers::WorldToScreen(vertices[b], viewProj, width, height);
+                    glm::vec2 ab = sb - sa;
+                    float along = glm::clamp(glm::dot(mouse - sa, ab) / glm::dot(ab, ab), 0.0f, 1.0f);
+                    float distance = glm::distance(mouse, sa + along * ab);
+                    if (distance < bestEdge) {
+                        bestEdge = distance;
+                        expectedEdge = {static_cast<int>(a), static_cast<int>(b)};
+                    }
+                }
+            }
+            EXPECT_EQ(grid.FindClosestVertex(mouse, 15.0f), expectedVertex) << px << ", " << py;
+            vertexHits += expectedVertex != -1;
+            edgeHits += expectedEdge.first != -1;
+            if (expectedEdge.first != -1) {
+                EXPECT_EQ(grid.FindClosestEdge(dense, mouse, 10.0f), expectedEdge) << px << ", " << py;
+            } else {
+                EXPECT_EQ(grid.FindClosestEdge(dense, mouse, 10.0f).first, -1) << px << ", " << py;
+            }
+        }
+    }
+    // The comparison means little unless the mesh covers much of the view.
+    EXPECT_GT(vertexHits, 50);
+    EXPECT_GT(edgeHits, 50);
+}
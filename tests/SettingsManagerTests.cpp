@@ -16,6 +16,7 @@ protected:
         settings.gridSize = 80;
         settings.gridDivisions = 80;
         settings.cameraSpeed = 5.0f;
+        settings.asyncPicking = true;
         // Also reset the highlight colors to default for consistent test runs.
         settings.vertexHighlightColor = {1.0f, 0.5f, 0.0f, 1.0f};
         settings.edgeHighlightColor = {1.0f, 0.5f, 0.0f, 1.0f};
@@ -38,6 +39,7 @@ TEST_F(SettingsManagerTest, DefaultsAreCorrect) {
     EXPECT_EQ(settings.gridSize, 80);
     EXPECT_EQ(settings.gridDivisions, 80);
     EXPECT_EQ(settings.cameraSpeed, 5.0f);
+    EXPECT_TRUE(settings.asyncPicking);
     // Add assertions for new colors
     EXPECT_EQ(settings.vertexHighlightColor, glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
     EXPECT_EQ(settings.edgeHighlightColor, glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
@@ -50,6 +52,7 @@ TEST_F(SettingsManagerTest, SaveAndLoad) {
     SettingsManager::Get().cloneOffset = glm::vec3(1.0f, 0.0f, -1.0f);
     SettingsManager::Get().gridSize = 100;
     SettingsManager::Get().cameraSpeed = 10.0f;
+    SettingsManager::Get().asyncPicking = false;
     SettingsManager::Get().vertexHighlightColor = glm::vec4(0.1f, 0.2f, 0.3f, 1.0f); // Set a new color
 
     ASSERT_TRUE(SettingsManager::Save("test_settings.json"));
@@ -61,6 +64,7 @@ TEST_F(SettingsManagerTest, SaveAndLoad) {
     EXPECT_EQ(SettingsManager::Get().cloneOffset, glm::vec3(1.0f, 0.0f, -1.0f));
     EXPECT_EQ(SettingsManager::Get().gridSize, 100);
     EXPECT_FLOAT_EQ(SettingsManager::Get().cameraSpeed, 10.0f);
+    EXPECT_FALSE(SettingsManager::Get().asyncPicking);
     EXPECT_EQ(SettingsManager::Get().vertexHighlightColor, glm::vec4(0.1f, 0.2f, 0.3f, 1.0f));
 }
 
@@ -106,8 +110,8 @@ TEST_F(SettingsManagerTest, GetDescriptors_AreCorrect) {
     AppSettings& settings = SettingsManager::Get();
 
     // Verify count (adjust if more settings are added/removed)
-    // There are 11 settings now, not 7.
-    EXPECT_EQ(descriptors.size(), 11);
+    // There are 13 settings now, not 7.
+    EXPECT_EQ(descriptors.size(), 13);
 
     // Test specific descriptors
     bool foundCloneOffset = false;